@@ -0,0 +1,100 @@
+/**
+ * @file benchLinear.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Linear algebra and inference benchmark program related enums, structs, etc.
+ * @version 0.3
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ */
+
+#ifndef BENCH_LINEAR_H
+#define BENCH_LINEAR_H
+
+#include <stdint.h>
+
+// ------------------------------------------------------------------
+// benchmark enum definitions
+
+/* Command line flags:
+ * 0x01 - help
+ * 0x02 - repetition count (+1 parameter)
+ * 0x04 - thread count (+1 parameter)
+ * 0x08 - CPU to pin benchmark thread to (+1 parameter)
+ * 0x10 - JSON output file (+1 parameter)
+ * 0x20 - run only selected group (+1 parameter)
+ */
+enum benchFlag_e {
+    BENCH_FLAG_NONE = 0x00,
+    BENCH_FLAG_HELP = 0x01,
+    BENCH_FLAG_REPEAT = 0x02,
+    BENCH_FLAG_THREADS = 0x04,
+    BENCH_FLAG_CPU = 0x08,
+    BENCH_FLAG_JSON = 0x10,
+    BENCH_FLAG_GROUP = 0x20
+};
+
+/* Benchmark groups (bit mask of groups to run):
+ * 0x01 - matrix products (xMatrix_dot)
+ * 0x02 - element-wise addition (xMatrix_add)
+ * 0x04 - activation functions (fnn_activate)
+ * 0x08 - full forward passes of agent architectures
+ * 0x10 - bitwise determinism of float kernels across SIMD levels and thread counts
+ */
+enum benchGroup_e {
+    BENCH_GROUP_DOT = 0x01,
+    BENCH_GROUP_ADD = 0x02,
+    BENCH_GROUP_ACTIVATION = 0x04,
+    BENCH_GROUP_FORWARD = 0x08,
+    BENCH_GROUP_DETERMINISM = 0x10,
+    BENCH_GROUP_ALL = 0x1F
+};
+
+// ------------------------------------------------------------------
+// benchmark constant definitions
+#define BENCH_DEFAULT_REPEAT 5         // default number of timed repetitions per measurement
+#define BENCH_MIN_SECONDS 0.05         // minimal duration of one repetition (product is repeated until reached)
+#define BENCH_NAIVE_MAX_FLOPS 4.0e9    // naive reference is skipped for larger products
+#define BENCH_MAX_LAYERS 6             // maximal number of layers of benchmarked architecture (including input layer)
+#define BENCH_BATCH_ROWS 256           // observations per batch in batched forward passes
+#define BENCH_SPARSE_DENSITY 0.10f     // fraction of weights kept by pruning in sparse forward passes
+#define BENCH_DETERMINISM_VALUES 4096  // values per call in determinism check of activation loop
+
+// ------------------------------------------------------------------
+// benchmark struct definitions
+
+/**
+ * @brief Matrix product shape (rows x inner) * (inner x cols)
+ *
+ */
+struct benchShape_s {
+    uint32_t rows;     // rows of first matrix and result
+    uint32_t inner;    // columns of first matrix, rows of second matrix
+    uint32_t cols;     // columns of second matrix and result
+    const char *kind;  // shape description (square, skinny, ...)
+};
+
+/**
+ * @brief Network architecture of benchmarked forward pass (ReLU hidden layers, sigmoid output layer)
+ *
+ */
+struct benchArchitecture_s {
+    uint32_t layerCount;                      // number of layers including input layer
+    uint32_t neuronCounts[BENCH_MAX_LAYERS];  // neurons of each layer
+    const char *name;                         // architecture description (5-32-4, ...)
+};
+
+/**
+ * @brief Timing statistics of one measurement (seconds per single call)
+ *
+ */
+struct benchStats_s {
+    double best;          // fastest repetition
+    double median;        // median repetition
+    double mean;          // mean of repetitions
+    double deviation;     // standard deviation of repetitions
+    uint32_t iterations;  // calls per repetition (calibrated during warmup)
+};
+
+#endif  // BENCH_LINEAR_H
@@ -0,0 +1,914 @@
+#define _GNU_SOURCE         // sched_setaffinity, sched_getcpu and CPU_* macros
+#include "benchLinear.h"
+#include <math.h>           // fabsf, sqrt
+#include <sched.h>          // pinning benchmark thread to one CPU
+#include <stdio.h>          // console and JSON output
+#include <stdlib.h>         // rand, strtoul, qsort
+#include <string.h>         // memcmp, memcpy
+#include <time.h>           // clock_gettime
+#include "commonUtility.h"  // C string utilities (for parsing command line arguments)
+#include "fnnActivation.h"  // activation functions under benchmark
+#include "fnnFixed.h"       // specialized forward kernels
+#include "fnnForward.h"     // batched float inference
+#include "fnnHalf.h"        // half precision inference
+#include "fnnQuantize.h"    // int8 quantized inference
+#include "fnnSerializer.h"  // activation function identifiers
+#include "fnnSparse.h"      // pruned sparse inference
+#include "xLinear.h"        // matrix operations under benchmark
+#include "xList.h"          // layer lists of benchmarked models
+#include "xSimd.h"          // SIMD level reporting
+#include "xThreadPool.h"    // process-wide thread pool (parallel variants)
+
+/**
+ * @brief Randomly initialized model in layer lists (same representation as in neurons program)
+ *
+ */
+typedef struct {
+    xList *weightMatrices;
+    xList *biasMatrices;
+    xList *activationFunctions;
+    xList *intermediateMatrices;  // single observation buffers of each layer (including input layer)
+    FnnFixedModel *fixedModel;
+    FnnQuantModel *quantModel;
+    FnnHalfModel *fp16Model;
+    FnnHalfModel *bf16Model;
+    FnnSparseModel *sparseModel;  // pruned to about `BENCH_SPARSE_DENSITY` of weights
+    xMatrix *batchInputs;
+    xMatrix *batchOutputs;
+    FnnPrecision_e precision;  // precision of activations in forward passes
+} benchModel;
+
+// ----------------------------------------------------------------------------------------------
+// global variables
+
+static unsigned short flags_cmd = BENCH_FLAG_NONE;   // command line argument flags
+static uint32_t repeatCount = BENCH_DEFAULT_REPEAT;  // number of timed repetitions per measurement
+static uint32_t threadCount = 0;                     // number of pool threads (0 for one per CPU)
+static int pinnedCpu = -1;                           // CPU benchmark thread is pinned to (-1 if not pinned)
+static unsigned groups = BENCH_GROUP_ALL;            // benchmark groups to run
+static FILE *jsonFile = NULL;                        // JSON output (NULL if not requested)
+static uint32_t jsonRecords = 0;                     // number of records written to JSON output
+static uint32_t mismatchCount = 0;                   // configurations with different results in deterministic mode
+
+// shapes of benchmarked products (square shapes and skinny shapes seen in batched inference and training)
+static const struct benchShape_s shapes[] = {
+    {64, 64, 64, "square"},       {128, 128, 128, "square"},    {256, 256, 256, "square"},   {512, 512, 512, "square"},
+    {1024, 1024, 1024, "square"}, {256, 5, 32, "batch 5-32"}, {256, 32, 4, "batch 32-4"}, {1024, 64, 64, "batch 64-64"},
+    {4096, 64, 4, "batch 64-4"},  {64, 4096, 64, "deep inner"}, {32, 64, 4096, "wide"},     {1, 1024, 1024, "vector"},
+};
+
+// shapes of benchmarked additions (single observation layers up to large blocks)
+static const struct benchShape_s addShapes[] = {
+    {1, 0, 4, "output"}, {1, 0, 32, "hidden"}, {1, 0, 256, "wide hidden"}, {256, 0, 64, "batch"}, {1024, 0, 1024, "square"},
+};
+
+// element counts of benchmarked activation loops
+static const uint32_t activationCounts[] = {4, 32, 4096, 1u << 20};
+
+// architectures of agents in populations (and larger ones for scaling)
+static const struct benchArchitecture_s architectures[] = {
+    {3, {5, 32, 4}, "5-32-4"},
+    {3, {5, 64, 4}, "5-64-4"},
+    {4, {5, 64, 64, 4}, "5-64-64-4"},
+    {4, {5, 128, 128, 4}, "5-128-128-4"},
+    {5, {5, 256, 256, 256, 4}, "5-256-256-256-4"},
+};
+
+// thread counts of determinism check (single thread, uneven and oversubscribed splits of parallel work)
+static const uint32_t determinismThreads[] = {1, 3, 8};
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static double now(void);                                                 // monotonic time in seconds
+static void fillRandom(xMatrix *mat);                                    // fill matrix with random values in [-1, 1]
+static void naiveDot(xMatrix *res, xMatrix *mat1, xMatrix *mat2);        // reference product (original i-j-k loop)
+static float maxRelativeError(xMatrix *res, xMatrix *ref);               // largest error relative to reference magnitude
+static struct benchStats_s measure(void (*run)(void *), void *context);  // warmup and timed repetitions of single call
+static int compareDouble(const void *a, const void *b);                  // ascending order of doubles (for median)
+static void record(const char *group, const char *name, const char *variant, const struct benchStats_s *stats, double flops,
+                   double items);  // append measurement to JSON output
+static void pinThread(int cpu);    // pin calling thread to CPU (-1 for CPU it currently runs on)
+
+static void benchDot(void);          // matrix products
+static void benchAdd(void);          // element-wise additions
+static void benchActivation(void);   // activation loops
+static void benchForward(void);      // full forward passes
+static void benchDeterminism(void);  // bitwise identical results of float kernels
+
+static benchModel *modelNew(const struct benchArchitecture_s *architecture);  // random model of given architecture
+static void modelFree(benchModel *model);                                      // free model and its converted variants
+
+// measured calls (context is pointer to arguments of call)
+static void runDot(void *context);
+static void runDotParallel(void *context);
+static void runNaiveDot(void *context);
+static void runAdd(void *context);
+static void runAddParallel(void *context);
+static void runActivation(void *context);
+static void runActivationCopy(void *context);
+static void runForwardGeneric(void *context);
+static void runForwardFixed(void *context);
+static void runForwardInt8(void *context);
+static void runForwardFp16(void *context);
+static void runForwardBf16(void *context);
+static void runForwardSparse(void *context);
+static void runForwardBatch(void *context);
+static void runForwardBatchParallel(void *context);
+static void prepareForwardFixed(void *context);  // select specialized kernel again after change of SIMD level
+
+// ----------------------------------------------------------------------------------------------
+// program entry point (main)
+
+int main(int argc, char *argv[])
+{
+    // parsing command line arguments
+    const char *jsonPath = NULL;
+    const char *groupName = NULL;
+    int i;
+    for (i = 1; i < argc; i++) {
+        if (cu_CStringCompare(argv[i], "-h") == 0 || cu_CStringCompare(argv[i], "--help") == 0) {
+            flags_cmd |= BENCH_FLAG_HELP;
+        } else if (cu_CStringCompare(argv[i], "-r") == 0 || cu_CStringCompare(argv[i], "--repeat") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= BENCH_FLAG_REPEAT;
+            repeatCount = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-t") == 0 || cu_CStringCompare(argv[i], "--threads") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= BENCH_FLAG_THREADS;
+            threadCount = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-c") == 0 || cu_CStringCompare(argv[i], "--cpu") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= BENCH_FLAG_CPU;
+            pinnedCpu = (int)strtol(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-j") == 0 || cu_CStringCompare(argv[i], "--json") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= BENCH_FLAG_JSON;
+            jsonPath = argv[i + 1];
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-g") == 0 || cu_CStringCompare(argv[i], "--group") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= BENCH_FLAG_GROUP;
+            groupName = argv[i + 1];
+            i += 1;
+        } else {
+            printf("ERROR: Unknown command line argument: %s\n", argv[i]);
+            printf("Use %s --help for more information.\n", argv[0]);
+            return 1;
+        }
+    }
+    if (i != argc || repeatCount == 0) {
+        printf("ERROR: Invalid command line arguments.\n");
+        printf("Use %s --help for more information.\n", argv[0]);
+        return 1;
+    }
+
+    if (flags_cmd & BENCH_FLAG_HELP) {
+        printf("Usage: %s [OPTIONS]\n", argv[0]);
+        printf("Linear algebra and inference benchmark.\n");
+        printf("\n");
+        printf("Options:\n");
+        printf("  -h, --help\t\t\tPrint this help message and exit.\n");
+        printf("  -r, --repeat <count>\t\tNumber of timed repetitions per measurement (default %d).\n", BENCH_DEFAULT_REPEAT);
+        printf("  -t, --threads <count>\t\tNumber of threads used by parallel variants (0 for one per CPU, default).\n");
+        printf("  -c, --cpu <index>\t\tPin benchmark thread to CPU (default: CPU it starts on).\n");
+        printf("  -j, --json <file>\t\tWrite all measurements to JSON file.\n");
+        printf("  -g, --group <name>\t\tRun only one group of benchmarks (dot, add, activation, forward,\n");
+        printf("\t\t\t\tdeterminism).\n");
+        printf("\n");
+        return 0;
+    }
+
+    if (flags_cmd & BENCH_FLAG_GROUP) {
+        if (cu_CStringCompare(groupName, "dot") == 0) {
+            groups = BENCH_GROUP_DOT;
+        } else if (cu_CStringCompare(groupName, "add") == 0) {
+            groups = BENCH_GROUP_ADD;
+        } else if (cu_CStringCompare(groupName, "activation") == 0) {
+            groups = BENCH_GROUP_ACTIVATION;
+        } else if (cu_CStringCompare(groupName, "forward") == 0) {
+            groups = BENCH_GROUP_FORWARD;
+        } else if (cu_CStringCompare(groupName, "determinism") == 0) {
+            groups = BENCH_GROUP_DETERMINISM;
+        } else {
+            printf("ERROR: Unknown benchmark group: %s\n", groupName);
+            return 1;
+        }
+    }
+
+    // pool threads are started before pinning so that only benchmark thread is bound to single CPU
+    srand(1);
+    xThreadPool_init(threadCount);
+    pinThread(pinnedCpu);
+    printf("SIMD level: %s, threads: %u, pinned CPU: %d, repetitions: %u\n", xSimd_levelName(xSimd_level()),
+           xThreadPool_threadCount(), pinnedCpu, repeatCount);
+
+    if (flags_cmd & BENCH_FLAG_JSON) {
+        jsonFile = fopen(jsonPath, "w");
+        if (jsonFile == NULL) {
+            printf("ERROR: Failed to open JSON output file: %s\n", jsonPath);
+            return 1;
+        }
+        fprintf(jsonFile, "{\n  \"simd\": \"%s\",\n  \"threads\": %u,\n  \"cpu\": %d,\n  \"repeat\": %u,\n  \"results\": [",
+                xSimd_levelName(xSimd_level()), xThreadPool_threadCount(), pinnedCpu, repeatCount);
+    }
+
+    if (groups & BENCH_GROUP_DOT) {
+        benchDot();
+    }
+    if (groups & BENCH_GROUP_ADD) {
+        benchAdd();
+    }
+    if (groups & BENCH_GROUP_ACTIVATION) {
+        benchActivation();
+    }
+    if (groups & BENCH_GROUP_FORWARD) {
+        benchForward();
+    }
+    if (groups & BENCH_GROUP_DETERMINISM) {
+        benchDeterminism();
+    }
+
+    if (jsonFile != NULL) {
+        fprintf(jsonFile, "\n  ]\n}\n");
+        fclose(jsonFile);
+    }
+
+    xThreadPool_shutdown();
+    return (mismatchCount > 0) ? 1 : 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+static double now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+static void fillRandom(xMatrix *mat)
+{
+    for (uint64_t i = 0; i < (uint64_t)mat->rows * mat->cols; i++) {
+        mat->data[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+    }
+}
+
+static void naiveDot(xMatrix *res, xMatrix *mat1, xMatrix *mat2)
+{
+    for (uint32_t i = 0; i < res->rows; i++) {
+        for (uint32_t j = 0; j < res->cols; j++) {
+            float sum = 0.0f;
+            for (uint32_t k = 0; k < mat1->cols; k++) {
+                sum += xMatrix_get(mat1, i, k) * xMatrix_get(mat2, k, j);
+            }
+            xMatrix_set(res, i, j, sum);
+        }
+    }
+}
+
+static float maxRelativeError(xMatrix *res, xMatrix *ref)
+{
+    float maxError = 0.0f, maxValue = 0.0f;
+    for (uint64_t i = 0; i < (uint64_t)res->rows * res->cols; i++) {
+        float error = fabsf(res->data[i] - ref->data[i]);
+        maxError = (error > maxError) ? error : maxError;
+        maxValue = (fabsf(ref->data[i]) > maxValue) ? fabsf(ref->data[i]) : maxValue;
+    }
+    return (maxValue > 0.0f) ? maxError / maxValue : maxError;
+}
+
+static struct benchStats_s measure(void (*run)(void *), void *context)
+{
+    struct benchStats_s stats = {0.0, 0.0, 0.0, 0.0, 1};
+
+    // warmup and calibration of inner iteration count
+    for (;;) {
+        double start = now();
+        for (uint32_t i = 0; i < stats.iterations; i++) {
+            run(context);
+        }
+        if (now() - start >= BENCH_MIN_SECONDS || stats.iterations >= (1u << 24)) {
+            break;
+        }
+        stats.iterations *= 2;
+    }
+
+    // timed repetitions
+    double *times = (double *)malloc(repeatCount * sizeof(double));
+    if (times == NULL) {
+        printf("ERROR: Failed to allocate timing buffer.\n");
+        exit(1);
+    }
+    for (uint32_t r = 0; r < repeatCount; r++) {
+        double start = now();
+        for (uint32_t i = 0; i < stats.iterations; i++) {
+            run(context);
+        }
+        times[r] = (now() - start) / stats.iterations;
+        stats.mean += times[r] / repeatCount;
+    }
+
+    // statistics over repetitions
+    qsort(times, repeatCount, sizeof(double), compareDouble);
+    stats.best = times[0];
+    stats.median = (repeatCount % 2) ? times[repeatCount / 2] : 0.5 * (times[repeatCount / 2 - 1] + times[repeatCount / 2]);
+    for (uint32_t r = 0; r < repeatCount; r++) {
+        stats.deviation += (times[r] - stats.mean) * (times[r] - stats.mean) / repeatCount;
+    }
+    stats.deviation = sqrt(stats.deviation);
+
+    free(times);
+    return stats;
+}
+
+static int compareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void record(const char *group, const char *name, const char *variant, const struct benchStats_s *stats, double flops,
+                   double items)
+{
+    if (jsonFile == NULL) {
+        return;
+    }
+
+    // one record per line so that outputs of two runs can be compared with diff
+    fprintf(jsonFile,
+            "%s\n    {\"group\": \"%s\", \"name\": \"%s\", \"variant\": \"%s\", \"iterations\": %u, \"best_ns\": %.1f, "
+            "\"median_ns\": %.1f, \"mean_ns\": %.1f, \"stddev_ns\": %.1f, \"gflops\": %.3f, \"ns_per_item\": %.3f}",
+            (jsonRecords > 0) ? "," : "", group, name, variant, stats->iterations, stats->best * 1e9, stats->median * 1e9,
+            stats->mean * 1e9, stats->deviation * 1e9, flops / stats->median * 1e-9, stats->median * 1e9 / items);
+    jsonRecords++;
+}
+
+static void pinThread(int cpu)
+{
+    if (cpu < 0) {
+        cpu = sched_getcpu();
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+    }
+    if (CPU_COUNT(&set) == 0 || sched_setaffinity(0, sizeof(set), &set) != 0) {
+        printf("WARNING: Failed to pin benchmark thread to CPU %d (timings may be noisy).\n", cpu);
+        pinnedCpu = -1;
+        return;
+    }
+    pinnedCpu = cpu;
+}
+
+// ----------------------------------------------------------------------------------------------
+// benchmark groups
+
+// arguments of matrix operation call
+struct operationArgs_s {
+    xMatrix *res;
+    xMatrix *mat1;
+    xMatrix *mat2;
+};
+
+static void benchDot(void)
+{
+    printf("\n%-12s %6s %6s %6s %12s %12s %12s %10s %10s\n", "shape", "M", "K", "N", "naive GF/s", "dot GF/s", "par GF/s", "speedup",
+           "rel.err");
+
+    for (uint32_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        const struct benchShape_s *shape = &shapes[s];
+        xMatrix *mat1 = xMatrix_new(shape->rows, shape->inner);
+        xMatrix *mat2 = xMatrix_new(shape->inner, shape->cols);
+        xMatrix *res = xMatrix_new(shape->rows, shape->cols);
+        xMatrix *ref = xMatrix_new(shape->rows, shape->cols);
+        if (mat1 == NULL || mat2 == NULL || res == NULL || ref == NULL) {
+            printf("ERROR: Failed to allocate matrices.\n");
+            exit(1);
+        }
+        fillRandom(mat1);
+        fillRandom(mat2);
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s %ux%ux%u", shape->kind, shape->rows, shape->inner, shape->cols);
+        double flops = 2.0 * shape->rows * shape->inner * shape->cols;
+        struct operationArgs_s args = {res, mat1, mat2};
+        struct benchStats_s dotStats = measure(runDot, &args);
+        struct benchStats_s parallelStats = measure(runDotParallel, &args);
+        record("dot", name, "dot", &dotStats, flops, 1.0);
+        record("dot", name, "parallel", &parallelStats, flops, 1.0);
+        if (flops <= BENCH_NAIVE_MAX_FLOPS) {
+            struct operationArgs_s refArgs = {ref, mat1, mat2};
+            struct benchStats_s naiveStats = measure(runNaiveDot, &refArgs);
+            record("dot", name, "naive", &naiveStats, flops, 1.0);
+            printf("%-12s %6u %6u %6u %12.2f %12.2f %12.2f %9.1fx %10.2e\n", shape->kind, shape->rows, shape->inner, shape->cols,
+                   flops / naiveStats.best * 1e-9, flops / dotStats.best * 1e-9, flops / parallelStats.best * 1e-9,
+                   naiveStats.best / parallelStats.best, maxRelativeError(res, ref));
+        } else {
+            printf("%-12s %6u %6u %6u %12s %12.2f %12.2f %10s %10s\n", shape->kind, shape->rows, shape->inner, shape->cols, "-",
+                   flops / dotStats.best * 1e-9, flops / parallelStats.best * 1e-9, "-", "-");
+        }
+
+        xMatrix_free(mat1);
+        xMatrix_free(mat2);
+        xMatrix_free(res);
+        xMatrix_free(ref);
+    }
+}
+
+static void benchAdd(void)
+{
+    printf("\n%-12s %6s %6s %12s %12s %12s %12s\n", "add", "M", "N", "add ns", "add GF/s", "par ns", "par GF/s");
+
+    for (uint32_t s = 0; s < sizeof(addShapes) / sizeof(addShapes[0]); s++) {
+        const struct benchShape_s *shape = &addShapes[s];
+        xMatrix *mat1 = xMatrix_new(shape->rows, shape->cols);
+        xMatrix *mat2 = xMatrix_new(shape->rows, shape->cols);
+        xMatrix *res = xMatrix_new(shape->rows, shape->cols);
+        if (mat1 == NULL || mat2 == NULL || res == NULL) {
+            printf("ERROR: Failed to allocate matrices.\n");
+            exit(1);
+        }
+        fillRandom(mat1);
+        fillRandom(mat2);
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s %ux%u", shape->kind, shape->rows, shape->cols);
+        double flops = (double)shape->rows * shape->cols;
+        struct operationArgs_s args = {res, mat1, mat2};
+        struct benchStats_s addStats = measure(runAdd, &args);
+        struct benchStats_s parallelStats = measure(runAddParallel, &args);
+        record("add", name, "add", &addStats, flops, flops);
+        record("add", name, "parallel", &parallelStats, flops, flops);
+        printf("%-12s %6u %6u %12.1f %12.2f %12.1f %12.2f\n", shape->kind, shape->rows, shape->cols, addStats.median * 1e9,
+               flops / addStats.median * 1e-9, parallelStats.median * 1e9, flops / parallelStats.median * 1e-9);
+
+        xMatrix_free(mat1);
+        xMatrix_free(mat2);
+        xMatrix_free(res);
+    }
+}
+
+// arguments of activation call
+struct activationArgs_s {
+    float *values;
+    uint32_t count;
+    FnnActivation_e activation;
+    FnnPrecision_e precision;
+};
+
+static void benchActivation(void)
+{
+    static const FnnActivation_e activations[] = {FNN_ACTIVATION_RELU, FNN_ACTIVATION_SIGMOID, FNN_ACTIVATION_TANH};
+    static const char *activationNames[] = {"relu", "sigmoid", "tanh"};
+
+    printf("\n%-12s %10s %14s %14s %14s %14s\n", "activation", "count", "exact ns", "exact ns/el", "fast ns", "fast ns/el");
+
+    for (uint32_t a = 0; a < sizeof(activations) / sizeof(activations[0]); a++) {
+        for (uint32_t c = 0; c < sizeof(activationCounts) / sizeof(activationCounts[0]); c++) {
+            uint32_t count = activationCounts[c];
+            xMatrix *values = xMatrix_new(1, count);
+            if (values == NULL) {
+                printf("ERROR: Failed to allocate matrices.\n");
+                exit(1);
+            }
+            fillRandom(values);
+
+            // values converge to fixed point of activation over calls (cost of implementations does not depend on value)
+            char name[64];
+            snprintf(name, sizeof(name), "%s %u", activationNames[a], count);
+            struct activationArgs_s exactArgs = {values->data, count, activations[a], FNN_PRECISION_EXACT};
+            struct activationArgs_s fastArgs = {values->data, count, activations[a], FNN_PRECISION_FAST};
+            struct benchStats_s exactStats = measure(runActivation, &exactArgs);
+            struct benchStats_s fastStats = measure(runActivation, &fastArgs);
+            record("activation", name, "exact", &exactStats, count, count);
+            record("activation", name, "fast", &fastStats, count, count);
+            printf("%-12s %10u %14.1f %14.3f %14.1f %14.3f\n", activationNames[a], count, exactStats.median * 1e9,
+                   exactStats.median * 1e9 / count, fastStats.median * 1e9, fastStats.median * 1e9 / count);
+
+            xMatrix_free(values);
+        }
+    }
+}
+
+static void benchForward(void)
+{
+    // forward variants (variants unavailable for architecture are skipped)
+    struct forwardVariant_s {
+        const char *name;
+        void (*run)(void *);
+        uint32_t batch;  // inferences per call
+    };
+    static const struct forwardVariant_s variants[] = {
+        {"generic", runForwardGeneric, 1},         {"fixed", runForwardFixed, 1},
+        {"int8", runForwardInt8, 1},               {"fp16", runForwardFp16, 1},
+        {"bf16", runForwardBf16, 1},               {"sparse", runForwardSparse, 1},
+        {"batch", runForwardBatch, BENCH_BATCH_ROWS}, {"batch-par", runForwardBatchParallel, BENCH_BATCH_ROWS},
+    };
+
+    printf("\n%-16s %-10s %14s %14s %12s %10s\n", "forward", "variant", "ns/inference", "stddev ns", "GF/s", "vs generic");
+
+    for (uint32_t a = 0; a < sizeof(architectures) / sizeof(architectures[0]); a++) {
+        const struct benchArchitecture_s *architecture = &architectures[a];
+        benchModel *model = modelNew(architecture);
+
+        // multiply-add of every weight and addition of every bias per inference (effective rate for pruned variant)
+        double flops = 0.0;
+        for (uint32_t l = 0; l + 1 < architecture->layerCount; l++) {
+            flops += 2.0 * architecture->neuronCounts[l] * architecture->neuronCounts[l + 1] + architecture->neuronCounts[l + 1];
+        }
+
+        double genericTime = 0.0;
+        for (uint32_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+            if (variants[v].run == runForwardFixed && model->fixedModel == NULL) {
+                printf("%-16s %-10s %14s %14s %12s %10s\n", architecture->name, variants[v].name, "-", "-", "-", "-");
+                continue;
+            }
+
+            struct benchStats_s stats = measure(variants[v].run, model);
+            double perInference = stats.median / variants[v].batch;
+            genericTime = (v == 0) ? perInference : genericTime;
+            record("forward", architecture->name, variants[v].name, &stats, flops * variants[v].batch, variants[v].batch);
+            printf("%-16s %-10s %14.1f %14.1f %12.2f %9.2fx\n", architecture->name, variants[v].name, perInference * 1e9,
+                   stats.deviation * 1e9 / variants[v].batch, flops / perInference * 1e-9, genericTime / perInference);
+        }
+
+        modelFree(model);
+    }
+}
+
+// checked call with buffer holding its result
+struct determinismCase_s {
+    char name[48];
+    void (*run)(void *);
+    void (*prepare)(void *);  // called after change of SIMD level (NULL if call dispatches by itself)
+    void *context;
+    const float *result;
+    uint64_t count;  // number of result values
+};
+
+// arguments of activation call on fresh copy of values (result does not depend on previous calls)
+struct activationCopyArgs_s {
+    const float *source;
+    struct activationArgs_s activation;
+};
+
+// number of SIMD level and thread count combinations whose result differs bitwise from single threaded scalar result
+static uint32_t determinismSweep(const struct determinismCase_s *check, int deterministic, float *reference)
+{
+    uint64_t bytes = check->count * sizeof(float);
+    uint32_t differences = 0;
+
+    xSimd_setDeterministic(deterministic);
+    for (int level = XSIMD_SCALAR; level <= (int)xSimd_detect(); level++) {
+        xSimd_setLevel((xSimdLevel_e)level);
+        if (check->prepare != NULL) {
+            check->prepare(check->context);
+        }
+        for (uint32_t t = 0; t < sizeof(determinismThreads) / sizeof(determinismThreads[0]); t++) {
+            xThreadPool_init(determinismThreads[t]);
+            check->run(check->context);
+            if (level == XSIMD_SCALAR && t == 0) {
+                memcpy(reference, check->result, bytes);
+            } else if (memcmp(reference, check->result, bytes) != 0) {
+                differences++;
+            }
+        }
+    }
+    return differences;
+}
+
+static void benchDeterminism(void)
+{
+    static const struct benchShape_s dotShapes[] = {
+        {256, 5, 32, "batch 5-32"}, {1024, 64, 64, "batch 64-64"}, {64, 4096, 64, "deep inner"},
+        {32, 64, 4096, "wide"},     {1, 1024, 1024, "vector"},
+    };
+    struct determinismCase_s checks[16];
+    struct operationArgs_s dotArgs[sizeof(dotShapes) / sizeof(dotShapes[0])];
+    uint32_t checkCount = 0;
+
+    // matrix products (serial and banded parallel paths)
+    for (uint32_t s = 0; s < sizeof(dotShapes) / sizeof(dotShapes[0]); s++) {
+        const struct benchShape_s *shape = &dotShapes[s];
+        dotArgs[s].mat1 = xMatrix_new(shape->rows, shape->inner);
+        dotArgs[s].mat2 = xMatrix_new(shape->inner, shape->cols);
+        dotArgs[s].res = xMatrix_new(shape->rows, shape->cols);
+        if (dotArgs[s].mat1 == NULL || dotArgs[s].mat2 == NULL || dotArgs[s].res == NULL) {
+            printf("ERROR: Failed to allocate matrices.\n");
+            exit(1);
+        }
+        fillRandom(dotArgs[s].mat1);
+        fillRandom(dotArgs[s].mat2);
+
+        struct determinismCase_s *check = &checks[checkCount++];
+        snprintf(check->name, sizeof(check->name), "dot %ux%ux%u", shape->rows, shape->inner, shape->cols);
+        check->run = runDotParallel;
+        check->prepare = NULL;
+        check->context = &dotArgs[s];
+        check->result = dotArgs[s].res->data;
+        check->count = (uint64_t)shape->rows * shape->cols;
+    }
+
+    // vectorized approximation of tanh (also used by fast sigmoid)
+    xMatrix *activationSource = xMatrix_new(1, BENCH_DETERMINISM_VALUES);
+    xMatrix *activationValues = xMatrix_new(1, BENCH_DETERMINISM_VALUES);
+    if (activationSource == NULL || activationValues == NULL) {
+        printf("ERROR: Failed to allocate matrices.\n");
+        exit(1);
+    }
+    fillRandom(activationSource);
+    struct activationCopyArgs_s activationArgs = {
+        activationSource->data, {activationValues->data, BENCH_DETERMINISM_VALUES, FNN_ACTIVATION_TANH, FNN_PRECISION_FAST}};
+    checks[checkCount++] = (struct determinismCase_s){"tanh fast 4096", runActivationCopy, NULL, &activationArgs,
+                                                      activationValues->data, BENCH_DETERMINISM_VALUES};
+
+    // forward passes with fast activations (agent architecture and larger one going through blocked products)
+    benchModel *models[] = {modelNew(&architectures[2]), modelNew(&architectures[4])};
+    for (uint32_t m = 0; m < sizeof(models) / sizeof(models[0]); m++) {
+        benchModel *model = models[m];
+        const char *architecture = architectures[m == 0 ? 2 : 4].name;
+        float *output = ((xMatrix *)model->intermediateMatrices->tail->data)->data;
+        uint32_t outputCount = ((xMatrix *)model->intermediateMatrices->tail->data)->cols;
+        model->precision = FNN_PRECISION_FAST;
+
+        struct determinismCase_s *check = &checks[checkCount++];
+        *check = (struct determinismCase_s){"", runForwardBatchParallel, NULL, model, model->batchOutputs->data,
+                                            (uint64_t)BENCH_BATCH_ROWS * outputCount};
+        snprintf(check->name, sizeof(check->name), "batch-par %s", architecture);
+        if (model->fixedModel != NULL) {
+            check = &checks[checkCount++];
+            *check = (struct determinismCase_s){"", runForwardFixed, prepareForwardFixed, model, output, outputCount};
+            snprintf(check->name, sizeof(check->name), "fixed %s", architecture);
+        }
+        check = &checks[checkCount++];
+        *check = (struct determinismCase_s){"", runForwardFp16, NULL, model, output, outputCount};
+        snprintf(check->name, sizeof(check->name), "fp16 %s", architecture);
+        check = &checks[checkCount++];
+        *check = (struct determinismCase_s){"", runForwardBf16, NULL, model, output, outputCount};
+        snprintf(check->name, sizeof(check->name), "bf16 %s", architecture);
+    }
+
+    // throughput is measured first with pool started before pinning (restarted pool threads inherit pinned CPU)
+    struct benchStats_s fusedStats[sizeof(checks) / sizeof(checks[0])];
+    struct benchStats_s exactStats[sizeof(checks) / sizeof(checks[0])];
+    for (uint32_t c = 0; c < checkCount; c++) {
+        xSimd_setDeterministic(0);
+        fusedStats[c] = measure(checks[c].run, checks[c].context);
+        xSimd_setDeterministic(1);
+        exactStats[c] = measure(checks[c].run, checks[c].context);
+        record("determinism", checks[c].name, "default", &fusedStats[c], 0.0, 1.0);
+        record("determinism", checks[c].name, "deterministic", &exactStats[c], 0.0, 1.0);
+    }
+
+    // every SIMD level up to detected one with single, uneven and oversubscribed thread counts (except reference itself)
+    uint32_t configurations = ((uint32_t)xSimd_detect() + 1) * (sizeof(determinismThreads) / sizeof(determinismThreads[0])) - 1;
+    printf("\n%-26s %10s %14s %14s %14s %14s %10s\n", "determinism", "configs", "default diff", "determ. diff", "default ns",
+           "determ. ns", "cost");
+    for (uint32_t c = 0; c < checkCount; c++) {
+        float *reference = (float *)malloc(checks[c].count * sizeof(float));
+        if (reference == NULL) {
+            printf("ERROR: Failed to allocate reference buffer.\n");
+            exit(1);
+        }
+        uint32_t fusedDifferences = determinismSweep(&checks[c], 0, reference);
+        uint32_t exactDifferences = determinismSweep(&checks[c], 1, reference);
+        mismatchCount += exactDifferences;
+        printf("%-26s %10u %14u %14u %14.1f %14.1f %9.1f%%\n", checks[c].name, configurations, fusedDifferences, exactDifferences,
+               fusedStats[c].median * 1e9, exactStats[c].median * 1e9,
+               (exactStats[c].median / fusedStats[c].median - 1.0) * 100.0);
+        free(reference);
+    }
+    if (mismatchCount > 0) {
+        printf("ERROR: Results of %u configurations differ in deterministic mode.\n", mismatchCount);
+    }
+
+    // restoring defaults of program
+    xSimd_setDeterministic(0);
+    xSimd_setLevel(xSimd_detect());
+    xThreadPool_init(threadCount);
+    for (uint32_t s = 0; s < sizeof(dotShapes) / sizeof(dotShapes[0]); s++) {
+        xMatrix_free(dotArgs[s].mat1);
+        xMatrix_free(dotArgs[s].mat2);
+        xMatrix_free(dotArgs[s].res);
+    }
+    xMatrix_free(activationSource);
+    xMatrix_free(activationValues);
+    for (uint32_t m = 0; m < sizeof(models) / sizeof(models[0]); m++) {
+        modelFree(models[m]);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+// benchmarked models
+
+static benchModel *modelNew(const struct benchArchitecture_s *architecture)
+{
+    benchModel *model = (benchModel *)calloc(1, sizeof(benchModel));
+    if (model == NULL) {
+        printf("ERROR: Failed to allocate model.\n");
+        exit(1);
+    }
+    model->weightMatrices = xList_new();
+    model->biasMatrices = xList_new();
+    model->activationFunctions = xList_new();
+    model->intermediateMatrices = xList_new();
+
+    // ReLU hidden layers and sigmoid output layer (as in agent models)
+    xList_pushBack(model->intermediateMatrices, xMatrix_new(1, architecture->neuronCounts[0]));
+    for (uint32_t l = 0; l + 1 < architecture->layerCount; l++) {
+        xMatrix *weights = xMatrix_new(architecture->neuronCounts[l], architecture->neuronCounts[l + 1]);
+        xMatrix *biases = xMatrix_new(1, architecture->neuronCounts[l + 1]);
+        FnnActivation_e *activation = (FnnActivation_e *)malloc(sizeof(FnnActivation_e));
+        if (weights == NULL || biases == NULL || activation == NULL) {
+            printf("ERROR: Failed to allocate model.\n");
+            exit(1);
+        }
+        fillRandom(weights);
+        fillRandom(biases);
+        *activation = (l + 2 == architecture->layerCount) ? FNN_ACTIVATION_SIGMOID : FNN_ACTIVATION_RELU;
+        xList_pushBack(model->weightMatrices, weights);
+        xList_pushBack(model->biasMatrices, biases);
+        xList_pushBack(model->activationFunctions, activation);
+        xList_pushBack(model->intermediateMatrices, xMatrix_new(1, architecture->neuronCounts[l + 1]));
+    }
+    fillRandom((xMatrix *)model->intermediateMatrices->head->data);
+
+    // converted variants (specialized kernel exists only for some architectures)
+    model->fixedModel = fnn_fixedSelect(model->weightMatrices, model->biasMatrices, model->activationFunctions);
+    model->quantModel = fnn_quantize(model->weightMatrices, model->biasMatrices, model->activationFunctions);
+    model->fp16Model = fnn_halfConvert(model->weightMatrices, model->biasMatrices, model->activationFunctions, FNN_HALF_FP16);
+    model->bf16Model = fnn_halfConvert(model->weightMatrices, model->biasMatrices, model->activationFunctions, FNN_HALF_BF16);
+    model->sparseModel = fnn_sparsify(model->weightMatrices, model->biasMatrices, model->activationFunctions,
+                                      1.0f - BENCH_SPARSE_DENSITY);  // weights are uniform in [-1, 1]
+    model->batchInputs = xMatrix_new(BENCH_BATCH_ROWS, architecture->neuronCounts[0]);
+    model->batchOutputs = xMatrix_new(BENCH_BATCH_ROWS, architecture->neuronCounts[architecture->layerCount - 1]);
+    if (model->quantModel == NULL || model->fp16Model == NULL || model->bf16Model == NULL || model->sparseModel == NULL ||
+        model->batchInputs == NULL || model->batchOutputs == NULL) {
+        printf("ERROR: Failed to convert model.\n");
+        exit(1);
+    }
+    fillRandom(model->batchInputs);
+    model->precision = FNN_PRECISION_EXACT;
+
+    return model;
+}
+
+static void modelFree(benchModel *model)
+{
+    xList_forEach(model->weightMatrices, (void (*)(void *))xMatrix_free);
+    xList_free(model->weightMatrices);
+    xList_forEach(model->biasMatrices, (void (*)(void *))xMatrix_free);
+    xList_free(model->biasMatrices);
+    xList_forEach(model->intermediateMatrices, (void (*)(void *))xMatrix_free);
+    xList_free(model->intermediateMatrices);
+    xList_forEach(model->activationFunctions, free);
+    xList_free(model->activationFunctions);
+    fnn_fixedFree(model->fixedModel);
+    fnn_quantFree(model->quantModel);
+    fnn_halfFree(model->fp16Model);
+    fnn_halfFree(model->bf16Model);
+    fnn_sparseFree(model->sparseModel);
+    xMatrix_free(model->batchInputs);
+    xMatrix_free(model->batchOutputs);
+    free(model);
+}
+
+// ----------------------------------------------------------------------------------------------
+// measured calls
+
+static void runDot(void *context)
+{
+    struct operationArgs_s *args = (struct operationArgs_s *)context;
+    xMatrix_dot(args->res, args->mat1, args->mat2);
+}
+
+static void runDotParallel(void *context)
+{
+    struct operationArgs_s *args = (struct operationArgs_s *)context;
+    xMatrix_dotParallel(args->res, args->mat1, args->mat2);
+}
+
+static void runNaiveDot(void *context)
+{
+    struct operationArgs_s *args = (struct operationArgs_s *)context;
+    naiveDot(args->res, args->mat1, args->mat2);
+}
+
+static void runAdd(void *context)
+{
+    struct operationArgs_s *args = (struct operationArgs_s *)context;
+    xMatrix_add(args->res, args->mat1, args->mat2);
+}
+
+static void runAddParallel(void *context)
+{
+    struct operationArgs_s *args = (struct operationArgs_s *)context;
+    xMatrix_addParallel(args->res, args->mat1, args->mat2);
+}
+
+static void runActivation(void *context)
+{
+    struct activationArgs_s *args = (struct activationArgs_s *)context;
+    fnn_activate(args->values, args->count, args->activation, args->precision);
+}
+
+static void runActivationCopy(void *context)
+{
+    struct activationCopyArgs_s *args = (struct activationCopyArgs_s *)context;
+    memcpy(args->activation.values, args->source, args->activation.count * sizeof(float));
+    runActivation(&args->activation);
+}
+
+// same sequence of calls as float inference of neurons program (one observation per frame)
+static void runForwardGeneric(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    xListNode *intermediateNode = model->intermediateMatrices->head;
+    xListNode *biasNode = model->biasMatrices->head;
+    xListNode *activationNode = model->activationFunctions->head;
+    for (xListNode *weightNode = model->weightMatrices->head; weightNode != NULL; weightNode = weightNode->next) {
+        xMatrix *intermediateCurrent = (xMatrix *)intermediateNode->data;
+        xMatrix *intermediateNext = (xMatrix *)intermediateNode->next->data;
+        xMatrix_dot(intermediateNext, intermediateCurrent, (xMatrix *)weightNode->data);
+        xMatrix_add(intermediateNext, intermediateNext, (xMatrix *)biasNode->data);
+        fnn_activate(intermediateNext->data, intermediateNext->cols, *(FnnActivation_e *)activationNode->data,
+                     model->precision);
+
+        intermediateNode = intermediateNode->next;
+        biasNode = biasNode->next;
+        activationNode = activationNode->next;
+    }
+}
+
+static void runForwardFixed(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_fixedForward(model->fixedModel, ((xMatrix *)model->intermediateMatrices->head->data)->data,
+                     ((xMatrix *)model->intermediateMatrices->tail->data)->data, model->precision);
+}
+
+static void runForwardInt8(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_quantForward(model->quantModel, ((xMatrix *)model->intermediateMatrices->head->data)->data,
+                     ((xMatrix *)model->intermediateMatrices->tail->data)->data, model->precision);
+}
+
+static void runForwardFp16(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_halfForward(model->fp16Model, ((xMatrix *)model->intermediateMatrices->head->data)->data,
+                    ((xMatrix *)model->intermediateMatrices->tail->data)->data, model->precision);
+}
+
+static void runForwardBf16(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_halfForward(model->bf16Model, ((xMatrix *)model->intermediateMatrices->head->data)->data,
+                    ((xMatrix *)model->intermediateMatrices->tail->data)->data, model->precision);
+}
+
+static void runForwardSparse(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_sparseForward(model->sparseModel, ((xMatrix *)model->intermediateMatrices->head->data)->data,
+                      ((xMatrix *)model->intermediateMatrices->tail->data)->data, model->precision);
+}
+
+static void runForwardBatch(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_forwardBatch(model->weightMatrices, model->biasMatrices, model->activationFunctions, model->batchInputs,
+                     model->batchOutputs, model->precision);
+}
+
+static void runForwardBatchParallel(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_forwardBatchParallel(model->weightMatrices, model->biasMatrices, model->activationFunctions, model->batchInputs,
+                             model->batchOutputs, model->precision);
+}
+
+static void prepareForwardFixed(void *context)
+{
+    benchModel *model = (benchModel *)context;
+    fnn_fixedFree(model->fixedModel);
+    model->fixedModel = fnn_fixedSelect(model->weightMatrices, model->biasMatrices, model->activationFunctions);
+}
@@ -2,7 +2,7 @@
  * @file fnnSerializer.h
  * @author 0xDontCare (https://github.com/0xDontCare)
  * @brief Feedforward Neural Network Serializer module
- * @version 0.2
+ * @version 0.3
  * @date 08.05.2024.
  *
  * @copyright All rights reserved (c) 2024
@@ -11,14 +11,28 @@
  * binary format. All functions have prefix `fnn_`.
  * Binary format is defined as follows:
  * - Magic number (4 bytes): 0x4D4E4E46 (FNNM)
- * - Format version number (2 bytes): 0x0002 (0.02)
+ * - Format version number (2 bytes): 0x0003 (0.03)
  * - Total weights (8 bytes): Total number of weights in the model
  * - Total biases (8 bytes): Total number of biases in the model
  * - Layer count (4 bytes): Number of layers in the model
  * - Neuron counts (4 bytes * layer count): Number of neurons in each layer
  * - Activation functions (4 bytes * layer count): Activation function for each layer except the input layer
+ * - Padding (0 to 63 bytes): Zero bytes up to next multiple of 64 bytes from start of file
  * - Weight values (4 bytes * total weights): Weights for each neuron in each layer
  * - Bias values (4 bytes * total biases): Biases for each neuron in each layer
+ *
+ * Padding aligns weight values so they can be used directly from memory mapped file. Files of version 0x0002 (without padding)
+ * can still be read.
+ *
+ * Whole generation of models sharing one architecture is stored in packed population format:
+ * - Header (`FnnPopulationHeader`, 72 bytes): magic 0x504E4E46 (FNNP), version, generation, model count, record geometry and
+ *   architecture totals
+ * - Neuron counts (4 bytes * layer count) and activation functions (4 bytes * (layer count - 1)) of architecture
+ * - Padding (0 to 63 bytes): Zero bytes up to next multiple of 64 bytes from start of file
+ * - Genome records (record stride * model count): Each record is complete model in format above, padded to multiple of 64 bytes
+ * - Fitness table (`FnnPopulationEntry` * model count): Fitness and evaluation metadata of each model
+ *
+ * Records start at aligned offsets, so model of given index can be mapped from population file without reading other models.
  */
 
 #ifndef FNN_SERIALIZER_H
@@ -27,7 +41,11 @@
 #include <stdint.h>
 
 #define FNN_SERIALIZER_MAGIC 0x4D4E4E46  // "FNNM"
-#define FNN_SERIALIZER_VERSION 0x0002    // 0.02
+#define FNN_SERIALIZER_VERSION 0x0003    // 0.03
+#define FNN_SERIALIZER_VERSION_UNALIGNED 0x0002  // 0.02 (values follow layer descriptors without padding)
+#define FNN_SERIALIZER_ALIGNMENT 64              // alignment of weight values in file (version 0.03)
+#define FNN_POPULATION_MAGIC 0x504E4E46           // "FNNP"
+#define FNN_POPULATION_VERSION 0x0001             // 0.01
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,6 +78,37 @@ typedef struct {
     float *biasValues;
 } FnnModel;
 
+/**
+ * @brief Header of packed population file
+ *
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t generation;      // generation number of models
+    uint32_t count;           // number of genome records
+    uint64_t recordSize;      // size of serialized model in record
+    uint64_t recordStride;    // bytes between starts of consecutive records (multiple of FNN_SERIALIZER_ALIGNMENT)
+    uint64_t recordsOffset;   // offset of first record from start of file
+    uint64_t tableOffset;     // offset of fitness table from start of file
+    uint64_t totalWeights;    // total number of weights of architecture
+    uint64_t totalBiases;     // total number of biases of architecture
+    uint32_t layerCount;      // number of layers of architecture
+    uint32_t reserved2;
+} FnnPopulationHeader;
+
+/**
+ * @brief Fitness table entry of packed population file
+ *
+ */
+typedef struct {
+    float fitness;         // fitness score (0 if model was not evaluated)
+    uint32_t seedsScored;  // number of scored seeds
+    uint32_t seedsCached;  // number of scored seeds taken from fitness cache
+    uint32_t raced;        // 1 if remaining seeds were cancelled by racing
+} FnnPopulationEntry;
+
 /**
  * @brief Create empty FNN model object
  * @return `FnnModel*`: Pointer to the FNN model if successful, NULL on failure
@@ -95,6 +144,25 @@ int32_t fnn_addLayer(FnnModel *model, uint32_t neuronCount, float *weightVals, f
  */
 int32_t fnn_serialize(const char *filename, FnnModel *model);
 
+/**
+ * @brief Get size of FNN model serialized in current format version
+ *
+ * @param model FNN model to measure
+ * @return `uint64_t`: Size of serialized model in bytes
+ */
+uint64_t fnn_serializedSize(const FnnModel *model);
+
+/**
+ * @brief Serialize FNN model to memory buffer in current format version
+ *
+ * @param buffer Buffer of at least `fnn_serializedSize(model)` bytes to store the serialized model to
+ * @param model FNN model to serialize
+ * @return `int32_t`: 0 on success, -1 on failure
+ *
+ * @note Buffer holds same bytes as file written by `fnn_serialize`, so it can be written to file or passed to loader as is
+ */
+int32_t fnn_serializeBuffer(void *buffer, const FnnModel *model);
+
 /**
  * @brief Deserialize FNN model from buffer
  *
@@ -103,6 +171,32 @@ int32_t fnn_serialize(const char *filename, FnnModel *model);
  */
 FnnModel *fnn_deserialize(const char *filename);
 
+/**
+ * @brief Get offset of weight values from start of file
+ *
+ * @param version Format version number of file
+ * @param layerCount Number of layers in the model
+ * @return `uint64_t`: Offset of first weight value in bytes
+ */
+uint64_t fnn_valuesOffset(uint16_t version, uint32_t layerCount);
+
+/**
+ * @brief Get offset of first genome record from start of packed population file
+ *
+ * @param layerCount Number of layers of architecture
+ * @return `uint64_t`: Offset of first record in bytes
+ */
+uint64_t fnn_populationRecordsOffset(uint32_t layerCount);
+
+/**
+ * @brief Validate header of packed population file against size of file
+ *
+ * @param header Header read from start of file
+ * @param size Size of file in bytes
+ * @return `int32_t`: 0 if records and fitness table fit in file and match architecture, -1 otherwise
+ */
+int32_t fnn_populationValidate(const FnnPopulationHeader *header, uint64_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,8 +2,8 @@
  * @file sharedMemory.h
  * @author 0xDontCare (https://github.com/0xDontCare)
  * @brief Shared memory structures and functions for interprocess communication between game, manager and neural network programs.
- * @version 0.2a
- * @date 08.05.2024.
+ * @version 0.4
+ * @date 17.10.2026.
  *
  * @copyright All rights reserved (c) 2024
  *
@@ -20,6 +20,10 @@ extern "C" {
 
 #include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+#define SM_MAX_WAIT_OUTPUTS 128     // maximal number of shared outputs waited on at once (kernel limit of vectored futex wait)
+#define SM_POLL_INTERVAL_NS 50000L  // sleep between checks of sequence numbers if kernel lacks vectored futex wait (50 us)
 
 struct sharedInput_s {
     pthread_mutex_t mutex;
@@ -39,6 +43,9 @@ struct sharedOutput_s {
     float gameOutput06;
     float gameOutput07;
     float gameOutput08;
+
+    uint32_t sequence;  // number of observations published by game (futex word, see `sm_publishSharedOutput`)
+    uint32_t waiting;   // set while agent sleeps on sequence (game skips wake-up system call otherwise)
 };
 
 struct sharedState_s {
@@ -57,6 +64,13 @@ struct sharedState_s {
     int game_gameScore;     // current game score (modified by game)
     int game_gameLevel;     // current game level (modified by game)
     long game_gameTime;     // current game time  (modified by game)
+
+    uint64_t neurons_inferenceCount;  // forward passes done since start (modified by NN program)
+    uint64_t neurons_duplicateCount;  // forward passes on observation which was already evaluated (modified by NN program)
+    float neurons_inferenceRate;      // forward passes per second since start (modified by NN program)
+    uint32_t neurons_forwardP50;      // median forward pass time in nanoseconds (modified by NN program)
+    uint32_t neurons_forwardP99;      // 99th percentile of forward pass time in nanoseconds (modified by NN program)
+    uint32_t neurons_cycleP99;        // 99th percentile of read, forward and write cycle in nanoseconds (modified by NN program)
 };
 
 /**
@@ -185,6 +199,40 @@ void sm_lockSharedOutput(struct sharedOutput_s *sharedOutput);
  */
 void sm_unlockSharedOutput(struct sharedOutput_s *sharedOutput);
 
+/**
+ * @brief Announce new observation written to shared output and wake agent waiting for it.
+ *
+ * @note Should be called after shared output is unlocked.
+ *
+ * @param sharedOutput Pointer to shared memory structure.
+ */
+void sm_publishSharedOutput(struct sharedOutput_s *sharedOutput);
+
+/**
+ * @brief Get number of observations published to shared output.
+ *
+ * @param sharedOutput Pointer to shared memory structure.
+ * @return Current sequence number (changes with every published observation).
+ */
+uint32_t sm_sequenceSharedOutput(struct sharedOutput_s *sharedOutput);
+
+/**
+ * @brief Wait until any of shared outputs publishes new observation.
+ *
+ * @note Returns immediately if sequence number of any shared output already differs from expected one.
+ *
+ * @note On kernels without vectored futex wait (before Linux 5.16) single shared output is still waited on by futex, but several
+ * shared outputs are polled in sleeps of `SM_POLL_INTERVAL_NS` (degraded mode, observation waits up to that interval instead of
+ * waking waiter immediately).
+ *
+ * @param sharedOutputs Array of pointers to shared memory structures (at most `SM_MAX_WAIT_OUTPUTS`).
+ * @param sequences Last sequence number seen for each shared output.
+ * @param count Number of shared outputs.
+ * @param timeoutNanoseconds Maximal waiting time in nanoseconds.
+ * @return 0 if observation was published (or wait was interrupted), 1 on timeout, -1 on invalid arguments.
+ */
+int sm_waitSharedOutputs(struct sharedOutput_s **sharedOutputs, const uint32_t *sequences, uint32_t count, long timeoutNanoseconds);
+
 /**
  * @brief Connect to shared memory for shared state (or create if it doesn't exist).
  *
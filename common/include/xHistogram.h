@@ -0,0 +1,86 @@
+/**
+ * @file xHistogram.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Fixed size log-linear histogram for latency measurements.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Histogram covers whole range of 64-bit values with bounded relative error (HDR histogram layout). Values below
+ * `2 * XHISTOGRAM_SUB_COUNT` are counted exactly, every following power of two range is split into `XHISTOGRAM_SUB_COUNT` equal
+ * buckets, so reported percentiles are within 1 / `XHISTOGRAM_SUB_COUNT` of recorded values. Recording is constant time and does
+ * not allocate, so it can be used inside of hot loops. Histograms are not thread safe, threads should record into their own
+ * histograms and merge them afterwards. All functions have prefix `xHistogram_`.
+ */
+
+#ifndef XHISTOGRAM_H
+#define XHISTOGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define XHISTOGRAM_SUB_BITS 5                                                        // log2 of buckets per power of two
+#define XHISTOGRAM_SUB_COUNT (1u << XHISTOGRAM_SUB_BITS)                             // buckets per power of two (32)
+#define XHISTOGRAM_BUCKET_COUNT ((65 - XHISTOGRAM_SUB_BITS) * XHISTOGRAM_SUB_COUNT)  // buckets covering all 64-bit values
+
+/**
+ * @brief Log-linear histogram
+ *
+ */
+typedef struct {
+    uint64_t counts[XHISTOGRAM_BUCKET_COUNT];  // number of values recorded in each bucket
+    uint64_t total;                            // number of recorded values
+    uint64_t sum;                              // sum of recorded values (for mean)
+    uint64_t min;                              // smallest recorded value (UINT64_MAX if empty)
+    uint64_t max;                              // largest recorded value
+} xHistogram;
+
+/**
+ * @brief Clear all recorded values.
+ *
+ * @param histogram Histogram to clear (also used to initialize new histogram)
+ */
+void xHistogram_reset(xHistogram *histogram);
+
+/**
+ * @brief Record single value.
+ *
+ * @param histogram Histogram
+ * @param value Recorded value (for example duration in nanoseconds)
+ */
+void xHistogram_record(xHistogram *histogram, uint64_t value);
+
+/**
+ * @brief Get value below which given percentage of recorded values lies.
+ *
+ * @param histogram Histogram
+ * @param percentile Percentile in range [0, 100]
+ * @return `uint64_t`: Highest value of bucket containing percentile (limited to recorded range), 0 if histogram is empty
+ */
+uint64_t xHistogram_percentile(const xHistogram *histogram, double percentile);
+
+/**
+ * @brief Get mean of recorded values.
+ *
+ * @param histogram Histogram
+ * @return `double`: Mean value, 0 if histogram is empty
+ */
+double xHistogram_mean(const xHistogram *histogram);
+
+/**
+ * @brief Add all values recorded in one histogram to another.
+ *
+ * @param destination Histogram receiving values
+ * @param source Histogram whose values are added (not modified)
+ */
+void xHistogram_merge(xHistogram *destination, const xHistogram *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // XHISTOGRAM_H
@@ -0,0 +1,76 @@
+/**
+ * @file xThreadPool.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Process-wide thread pool for data parallel work.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Pool is shared by whole process and started lazily on first use (with one thread per online CPU) unless configured earlier with
+ * `xThreadPool_init`. Work is submitted as a range of task indices which are handed out dynamically to worker threads and to the
+ * submitting thread, and submission returns only after all tasks finished. Calls made from inside of a running task execute
+ * serially on calling thread, so parallel functions can be safely nested. All functions have prefix `xThreadPool_`.
+ */
+
+#ifndef XTHREADPOOL_H
+#define XTHREADPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Task function executed by pool
+ *
+ * @param context User data passed to `xThreadPool_parallelFor`
+ * @param index Index of task (0 to task count - 1)
+ */
+typedef void (*xThreadPoolTask)(void *context, uint32_t index);
+
+/**
+ * @brief Start (or restart) thread pool with given number of threads.
+ *
+ * @param threadCount Total number of threads doing work, including submitting thread (0 for one thread per online CPU)
+ * @return `int32_t`: 0 on success, -1 on failure (pool then runs all work serially)
+ *
+ * @note Blocks until work submitted by other threads is finished.
+ *
+ * @warning Must not be called from inside of running task.
+ */
+int32_t xThreadPool_init(uint32_t threadCount);
+
+/**
+ * @brief Get number of threads doing work (including submitting thread).
+ *
+ * @return `uint32_t`: Number of threads (starts pool with default size if not yet started)
+ *
+ * @note Returns 1 when called from inside of running task (nested work is not parallelized).
+ */
+uint32_t xThreadPool_threadCount(void);
+
+/**
+ * @brief Run tasks with indices 0 to taskCount - 1 on pool and wait for all of them to finish.
+ *
+ * @param taskCount Number of tasks
+ * @param task Task function
+ * @param context User data passed to every task
+ *
+ * @note Submissions from different threads are serialized.
+ */
+void xThreadPool_parallelFor(uint32_t taskCount, xThreadPoolTask task, void *context);
+
+/**
+ * @brief Stop all worker threads of pool.
+ *
+ * @note Pool is started again with default size on next use.
+ */
+void xThreadPool_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // XTHREADPOOL_H
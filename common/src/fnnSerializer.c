@@ -2,6 +2,7 @@
 #include <stdint.h>  // standard integer types for fixed integer width in file format (uint32_t, ...)
 #include <stdio.h>   // standard I/O (fprintf, ...)
 #include <stdlib.h>  // standard library (for malloc, free, ...)
+#include <string.h>  // memory copying (serialization to buffer)
 
 FnnModel *fnn_new(void)
 {
@@ -119,14 +120,15 @@ int32_t fnn_serialize(const char *filename, FnnModel *model)
     // write size counter
     uint64_t wrSize = 0;
 
-    // calculate total expected size
-    uint64_t expectedSize = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) +
-                            model->layerCount * sizeof(uint32_t) + (model->layerCount - 1) * sizeof(FnnActivation_e) +
-                            model->totalWeights * sizeof(float) + model->totalBiases * sizeof(float);
+    // calculate total expected size (models are always written in current format version)
+    uint16_t version = FNN_SERIALIZER_VERSION;
+    uint64_t valuesOffset = fnn_valuesOffset(version, model->layerCount);
+    uint64_t paddingSize = valuesOffset - fnn_valuesOffset(FNN_SERIALIZER_VERSION_UNALIGNED, model->layerCount);
+    uint64_t expectedSize = valuesOffset + model->totalWeights * sizeof(float) + model->totalBiases * sizeof(float);
 
     // write model header
     wrSize += fwrite(&model->magic, sizeof(uint32_t), 1, file) * sizeof(uint32_t);
-    wrSize += fwrite(&model->version, sizeof(uint16_t), 1, file) * sizeof(uint16_t);
+    wrSize += fwrite(&version, sizeof(uint16_t), 1, file) * sizeof(uint16_t);
     wrSize += fwrite(&model->totalWeights, sizeof(uint64_t), 1, file) * sizeof(uint64_t);
     wrSize += fwrite(&model->totalBiases, sizeof(uint64_t), 1, file) * sizeof(uint64_t);
     wrSize += fwrite(&model->layerCount, sizeof(uint32_t), 1, file) * sizeof(uint32_t);
@@ -135,6 +137,10 @@ int32_t fnn_serialize(const char *filename, FnnModel *model)
     wrSize += fwrite(model->neuronCounts, sizeof(uint32_t), model->layerCount, file) * sizeof(uint32_t);
     wrSize += fwrite(model->activationFunctions, sizeof(FnnActivation_e), (model->layerCount - 1), file) * sizeof(FnnActivation_e);
 
+    // write padding up to aligned weight values
+    const uint8_t padding[FNN_SERIALIZER_ALIGNMENT] = {0};
+    wrSize += fwrite(padding, 1, paddingSize, file);
+
     // write weight and bias values
     wrSize += fwrite(model->weightValues, sizeof(float), model->totalWeights, file) * sizeof(float);
     wrSize += fwrite(model->biasValues, sizeof(float), model->totalBiases, file) * sizeof(float);
@@ -152,6 +158,51 @@ int32_t fnn_serialize(const char *filename, FnnModel *model)
     return 0;
 }
 
+uint64_t fnn_serializedSize(const FnnModel *model)
+{
+    return fnn_valuesOffset(FNN_SERIALIZER_VERSION, model->layerCount) + model->totalWeights * sizeof(float) +
+           model->totalBiases * sizeof(float);
+}
+
+int32_t fnn_serializeBuffer(void *buffer, const FnnModel *model)
+{
+    // parameter checking
+    if (buffer == NULL || model == NULL || model->layerCount <= 1) {
+        fprintf(stderr, "FNN Serializer: fnn_serializeBuffer bad arguments\n");
+        return -1;
+    }
+
+    // write model header (same layout as file, models are always written in current format version)
+    uint8_t *position = (uint8_t *)buffer;
+    uint16_t version = FNN_SERIALIZER_VERSION;
+    memcpy(position, &model->magic, sizeof(uint32_t));
+    position += sizeof(uint32_t);
+    memcpy(position, &version, sizeof(uint16_t));
+    position += sizeof(uint16_t);
+    memcpy(position, &model->totalWeights, sizeof(uint64_t));
+    position += sizeof(uint64_t);
+    memcpy(position, &model->totalBiases, sizeof(uint64_t));
+    position += sizeof(uint64_t);
+    memcpy(position, &model->layerCount, sizeof(uint32_t));
+    position += sizeof(uint32_t);
+
+    // write layer descriptors
+    memcpy(position, model->neuronCounts, model->layerCount * sizeof(uint32_t));
+    position += model->layerCount * sizeof(uint32_t);
+    memcpy(position, model->activationFunctions, (model->layerCount - 1) * sizeof(FnnActivation_e));
+    position += (model->layerCount - 1) * sizeof(FnnActivation_e);
+
+    // write padding up to aligned weight values
+    uint8_t *values = (uint8_t *)buffer + fnn_valuesOffset(version, model->layerCount);
+    memset(position, 0, (size_t)(values - position));
+
+    // write weight and bias values
+    memcpy(values, model->weightValues, model->totalWeights * sizeof(float));
+    memcpy(values + model->totalWeights * sizeof(float), model->biasValues, model->totalBiases * sizeof(float));
+
+    return 0;
+}
+
 FnnModel *fnn_deserialize(const char *filename)
 {
     // file opening
@@ -180,7 +231,8 @@ FnnModel *fnn_deserialize(const char *filename)
     }
 
     // validate model header
-    if (model->magic != FNN_SERIALIZER_MAGIC || model->version != FNN_SERIALIZER_VERSION) {
+    if (model->magic != FNN_SERIALIZER_MAGIC ||
+        (model->version != FNN_SERIALIZER_VERSION && model->version != FNN_SERIALIZER_VERSION_UNALIGNED)) {
         fprintf(stderr, "FNN Serializer: Invalid model header\n");
         fclose(file);
         free(model);
@@ -245,6 +297,18 @@ FnnModel *fnn_deserialize(const char *filename)
         return NULL;
     }
 
+    // skip padding before weight values
+    if (fseek(file, (long)fnn_valuesOffset(model->version, model->layerCount), SEEK_SET) != 0) {
+        fprintf(stderr, "FNN Serializer: Failed to seek to weight values\n");
+        fclose(file);
+        free(model->biasValues);
+        free(model->weightValues);
+        free(model->activationFunctions);
+        free(model->neuronCounts);
+        free(model);
+        return NULL;
+    }
+
     // read weight and bias values
     uint64_t readWeights = fread(model->weightValues, sizeof(float), model->totalWeights, file);
     uint64_t readBiases = fread(model->biasValues, sizeof(float), model->totalBiases, file);
@@ -264,3 +328,50 @@ FnnModel *fnn_deserialize(const char *filename)
 
     return model;
 }
+
+uint64_t fnn_valuesOffset(uint16_t version, uint32_t layerCount)
+{
+    // header and layer descriptors
+    uint64_t offset = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) +
+                      (uint64_t)layerCount * sizeof(uint32_t) + (uint64_t)(layerCount - 1) * sizeof(FnnActivation_e);
+
+    // padding to aligned values
+    if (version != FNN_SERIALIZER_VERSION_UNALIGNED) {
+        offset = (offset + FNN_SERIALIZER_ALIGNMENT - 1) / FNN_SERIALIZER_ALIGNMENT * FNN_SERIALIZER_ALIGNMENT;
+    }
+
+    return offset;
+}
+
+uint64_t fnn_populationRecordsOffset(uint32_t layerCount)
+{
+    uint64_t offset = sizeof(FnnPopulationHeader) + (uint64_t)layerCount * sizeof(uint32_t) +
+                      (uint64_t)(layerCount - 1) * sizeof(FnnActivation_e);
+    return (offset + FNN_SERIALIZER_ALIGNMENT - 1) / FNN_SERIALIZER_ALIGNMENT * FNN_SERIALIZER_ALIGNMENT;
+}
+
+int32_t fnn_populationValidate(const FnnPopulationHeader *header, uint64_t size)
+{
+    if (size < sizeof(FnnPopulationHeader) || header->magic != FNN_POPULATION_MAGIC || header->version != FNN_POPULATION_VERSION) {
+        fprintf(stderr, "FNN Serializer: Invalid population header\n");
+        return -1;
+    }
+    if (header->layerCount <= 1 || header->count == 0) {
+        fprintf(stderr, "FNN Serializer: Invalid population architecture\n");
+        return -1;
+    }
+
+    // records hold complete models of architecture at aligned stride, table follows records
+    uint64_t recordSize = fnn_valuesOffset(FNN_SERIALIZER_VERSION, header->layerCount) +
+                          (header->totalWeights + header->totalBiases) * sizeof(float);
+    if (header->recordSize != recordSize || header->recordStride < recordSize ||
+        header->recordStride % FNN_SERIALIZER_ALIGNMENT != 0 ||
+        header->recordsOffset != fnn_populationRecordsOffset(header->layerCount) ||
+        header->tableOffset < header->recordsOffset || (header->tableOffset - header->recordsOffset) / header->recordStride < header->count ||
+        header->tableOffset > size || (size - header->tableOffset) / sizeof(FnnPopulationEntry) < header->count) {
+        fprintf(stderr, "FNN Serializer: Population records do not fit in file\n");
+        return -1;
+    }
+
+    return 0;
+}
@@ -1,12 +1,18 @@
 #include "sharedMemory.h"
-#include <fcntl.h>     // file control option flags (O_CREAT, O_RDWR)
-#include <pthread.h>   // POSIX threads (mutex)
-#include <stdbool.h>   // boolean type (true, false values)
-#include <stdio.h>     // standard I/O (perror, ...)
-#include <stdlib.h>    // standard library (exit, ...)
-#include <sys/mman.h>  // memory management (mmap, munmap)
-#include <sys/stat.h>  // status of file or file system (for mode constants)
-#include <unistd.h>    // standard symbolic constants and types (for POSIX OS API)
+#include <errno.h>        // error codes of futex waits
+#include <fcntl.h>        // file control option flags (O_CREAT, O_RDWR)
+#include <limits.h>       // INT_MAX (wake all waiters)
+#include <linux/futex.h>  // futex operations (waking agents waiting for observations)
+#include <pthread.h>      // POSIX threads (mutex)
+#include <stdbool.h>      // boolean type (true, false values)
+#include <stdint.h>       // universal integer types
+#include <stdio.h>        // standard I/O (perror, ...)
+#include <stdlib.h>       // standard library (exit, ...)
+#include <sys/mman.h>     // memory management (mmap, munmap)
+#include <sys/stat.h>     // status of file or file system (for mode constants)
+#include <sys/syscall.h>  // futex system calls
+#include <time.h>         // timeouts of futex waits
+#include <unistd.h>       // standard symbolic constants and types (for POSIX OS API)
 
 int sm_validateSharedMemoryName(const char *sharedMemoryName)
 {
@@ -179,6 +185,8 @@ void sm_initSharedOutput(struct sharedOutput_s *sharedOutput)
     sharedOutput->gameOutput06 = 0.f;
     sharedOutput->gameOutput07 = 0.f;
     sharedOutput->gameOutput08 = 0.f;
+    sharedOutput->sequence = 0;
+    sharedOutput->waiting = 0;
 }
 
 void sm_freeSharedOutput(struct sharedOutput_s *sharedOutput, const char *sharedMemoryName)
@@ -208,6 +216,80 @@ void sm_lockSharedOutput(struct sharedOutput_s *sharedOutput) { pthread_mutex_lo
 
 void sm_unlockSharedOutput(struct sharedOutput_s *sharedOutput) { pthread_mutex_unlock(&sharedOutput->mutex); }
 
+void sm_publishSharedOutput(struct sharedOutput_s *sharedOutput)
+{
+    // sequentially consistent pair with waiter (waiting flag is set before futex compares sequence)
+    __atomic_add_fetch(&sharedOutput->sequence, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&sharedOutput->waiting, __ATOMIC_SEQ_CST)) {
+        syscall(SYS_futex, &sharedOutput->sequence, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+uint32_t sm_sequenceSharedOutput(struct sharedOutput_s *sharedOutput)
+{
+    return __atomic_load_n(&sharedOutput->sequence, __ATOMIC_ACQUIRE);
+}
+
+int sm_waitSharedOutputs(struct sharedOutput_s **sharedOutputs, const uint32_t *sequences, uint32_t count, long timeoutNanoseconds)
+{
+    if (sharedOutputs == NULL || sequences == NULL || count == 0 || count > SM_MAX_WAIT_OUTPUTS || timeoutNanoseconds < 0) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        __atomic_store_n(&sharedOutputs[i]->waiting, 1, __ATOMIC_SEQ_CST);
+    }
+
+    // wait on all sequence words at once (falls back to plain futex wait or polling if kernel lacks vectored wait)
+    long result = -1;
+    errno = ENOSYS;
+#ifdef SYS_futex_waitv
+    struct futex_waitv waiters[SM_MAX_WAIT_OUTPUTS] = {0};
+    for (uint32_t i = 0; i < count; i++) {
+        waiters[i].val = sequences[i];
+        waiters[i].uaddr = (uintptr_t)&sharedOutputs[i]->sequence;
+        waiters[i].flags = FUTEX_32;
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutNanoseconds / 1000000000L;
+    deadline.tv_nsec += timeoutNanoseconds % 1000000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    result = syscall(SYS_futex_waitv, waiters, count, 0, &deadline, CLOCK_MONOTONIC);
+#endif
+    if (result == -1 && errno == ENOSYS && count == 1) {
+        struct timespec timeout = {timeoutNanoseconds / 1000000000L, timeoutNanoseconds % 1000000000L};
+        result = syscall(SYS_futex, &sharedOutputs[0]->sequence, FUTEX_WAIT, sequences[0], &timeout, NULL, 0);
+    } else if (result == -1 && errno == ENOSYS) {
+        // single futex cannot cover several words, so sequences are polled (games are not asked for wake-ups)
+        for (uint32_t i = 0; i < count; i++) {
+            __atomic_store_n(&sharedOutputs[i]->waiting, 0, __ATOMIC_RELAXED);
+        }
+        struct timespec interval = {0, SM_POLL_INTERVAL_NS};
+        for (long waited = 0; result == -1 && waited < timeoutNanoseconds; waited += SM_POLL_INTERVAL_NS) {
+            for (uint32_t i = 0; i < count; i++) {
+                if (__atomic_load_n(&sharedOutputs[i]->sequence, __ATOMIC_ACQUIRE) != sequences[i]) {
+                    result = 0;
+                }
+            }
+            if (result == -1) {
+                nanosleep(&interval, NULL);
+            }
+        }
+        errno = (result == -1) ? ETIMEDOUT : errno;
+    }
+    int timedOut = (result == -1 && errno == ETIMEDOUT) ? 1 : 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        __atomic_store_n(&sharedOutputs[i]->waiting, 0, __ATOMIC_RELAXED);
+    }
+
+    return timedOut;
+}
+
 struct sharedState_s *sm_allocateSharedState(const char *sharedMemoryName)
 {
     int sharedMemoryFd = shm_open(sharedMemoryName, O_CREAT | O_RDWR, 0666);
@@ -275,6 +357,13 @@ void sm_initSharedState(struct sharedState_s *sharedState)
     sharedState->game_gameScore = 0;
     sharedState->game_gameLevel = 0;
     sharedState->game_gameTime = 0;
+
+    sharedState->neurons_inferenceCount = 0;
+    sharedState->neurons_duplicateCount = 0;
+    sharedState->neurons_inferenceRate = 0.0f;
+    sharedState->neurons_forwardP50 = 0;
+    sharedState->neurons_forwardP99 = 0;
+    sharedState->neurons_cycleP99 = 0;
 }
 
 void sm_freeSharedState(struct sharedState_s *sharedState, const char *sharedMemoryName)
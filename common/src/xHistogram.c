@@ -0,0 +1,122 @@
+#include "xHistogram.h"
+#include <stdint.h>  // universal integer types
+#include <string.h>  // memset
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static inline uint32_t bucketIndex(uint64_t value);    // index of bucket counting given value
+static inline uint64_t bucketHighest(uint32_t index);  // highest value counted by bucket
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+void xHistogram_reset(xHistogram *histogram)
+{
+    if (histogram == NULL) {
+        return;
+    }
+
+    memset(histogram->counts, 0, sizeof(histogram->counts));
+    histogram->total = 0;
+    histogram->sum = 0;
+    histogram->min = UINT64_MAX;
+    histogram->max = 0;
+}
+
+void xHistogram_record(xHistogram *histogram, uint64_t value)
+{
+    histogram->counts[bucketIndex(value)]++;
+    histogram->total++;
+    histogram->sum += value;
+    if (value < histogram->min) {
+        histogram->min = value;
+    }
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+}
+
+uint64_t xHistogram_percentile(const xHistogram *histogram, double percentile)
+{
+    if (histogram == NULL || histogram->total == 0) {
+        return 0;
+    }
+    if (percentile < 0.0) {
+        percentile = 0.0;
+    } else if (percentile > 100.0) {
+        percentile = 100.0;
+    }
+
+    // rank of requested value (at least first one)
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)histogram->total + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < XHISTOGRAM_BUCKET_COUNT; i++) {
+        seen += histogram->counts[i];
+        if (seen >= rank) {
+            uint64_t value = bucketHighest(i);
+            if (value > histogram->max) {
+                value = histogram->max;
+            }
+            if (value < histogram->min) {
+                value = histogram->min;
+            }
+            return value;
+        }
+    }
+    return histogram->max;
+}
+
+double xHistogram_mean(const xHistogram *histogram)
+{
+    if (histogram == NULL || histogram->total == 0) {
+        return 0.0;
+    }
+    return (double)histogram->sum / (double)histogram->total;
+}
+
+void xHistogram_merge(xHistogram *destination, const xHistogram *source)
+{
+    if (destination == NULL || source == NULL || source->total == 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < XHISTOGRAM_BUCKET_COUNT; i++) {
+        destination->counts[i] += source->counts[i];
+    }
+    destination->total += source->total;
+    destination->sum += source->sum;
+    if (source->min < destination->min) {
+        destination->min = source->min;
+    }
+    if (source->max > destination->max) {
+        destination->max = source->max;
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// values below 2 * sub count map to themselves, larger ones keep only `XHISTOGRAM_SUB_BITS + 1` highest bits
+static inline uint32_t bucketIndex(uint64_t value)
+{
+    if (value < 2 * XHISTOGRAM_SUB_COUNT) {
+        return (uint32_t)value;
+    }
+    uint32_t shift = (uint32_t)(63 - __builtin_clzll(value)) - XHISTOGRAM_SUB_BITS;
+    return shift * XHISTOGRAM_SUB_COUNT + (uint32_t)(value >> shift);
+}
+
+static inline uint64_t bucketHighest(uint32_t index)
+{
+    if (index < 2 * XHISTOGRAM_SUB_COUNT) {
+        return index;
+    }
+    uint32_t shift = index / XHISTOGRAM_SUB_COUNT - 1;
+    uint64_t mantissa = index - shift * XHISTOGRAM_SUB_COUNT;
+    return (mantissa << shift) + ((UINT64_C(1) << shift) - 1);
+}
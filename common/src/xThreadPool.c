@@ -0,0 +1,218 @@
+#include "xThreadPool.h"
+#include <pthread.h>  // POSIX threads (workers, mutex, condition variables)
+#include <stdint.h>   // universal integer types
+#include <stdlib.h>   // malloc, free
+#include <unistd.h>   // sysconf (number of online CPUs)
+
+// ----------------------------------------------------------------------------------------------
+// pool state (protected by poolMutex unless stated otherwise)
+
+static pthread_mutex_t submitMutex = PTHREAD_MUTEX_INITIALIZER;  // serializes submissions and reconfiguration
+static pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;    // protects pool state below
+static pthread_cond_t workCond = PTHREAD_COND_INITIALIZER;       // signaled when new job is published (or on shutdown)
+static pthread_cond_t doneCond = PTHREAD_COND_INITIALIZER;       // signaled when last worker finishes job
+
+static pthread_t *workers = NULL;  // worker threads (without submitting thread)
+static uint32_t workerCount = 0;   // number of worker threads
+static int poolStarted = 0;        // pool was configured (possibly with zero workers)
+static int poolStopping = 0;       // workers should exit
+
+static uint64_t jobGeneration = 0;    // incremented for every published job
+static uint64_t startGeneration = 0;  // generation at time workers were started (workers wait for newer one)
+static uint32_t jobActive = 0;        // number of workers still working on current job
+static xThreadPoolTask jobTask = NULL;
+static void *jobContext = NULL;
+static uint32_t jobTaskCount = 0;
+static uint32_t jobNextIndex = 0;  // next task index to hand out (accessed atomically)
+
+static __thread int insideTask = 0;  // calling thread is executing pool task (nested calls run serially)
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static void *workerMain(void *arg);           // worker thread loop
+static void runTasks(void);                   // execute tasks of current job until none are left
+static int32_t startWorkers(uint32_t count);  // start worker threads (submitMutex must be held)
+static void stopWorkers(void);                // stop and join worker threads (submitMutex must be held)
+static uint32_t defaultThreadCount(void);     // one thread per online CPU
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+int32_t xThreadPool_init(uint32_t threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+
+    pthread_mutex_lock(&submitMutex);
+    stopWorkers();
+    int32_t result = startWorkers(threadCount - 1);
+    pthread_mutex_unlock(&submitMutex);
+
+    return result;
+}
+
+uint32_t xThreadPool_threadCount(void)
+{
+    // work submitted from inside of task runs serially
+    if (insideTask) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&submitMutex);
+    if (!poolStarted) {
+        startWorkers(defaultThreadCount() - 1);
+    }
+    uint32_t count = workerCount + 1;
+    pthread_mutex_unlock(&submitMutex);
+
+    return count;
+}
+
+void xThreadPool_parallelFor(uint32_t taskCount, xThreadPoolTask task, void *context)
+{
+    if (taskCount == 0 || task == NULL) {
+        return;
+    }
+
+    // nested or trivial submissions run directly on calling thread
+    if (insideTask || taskCount == 1) {
+        for (uint32_t i = 0; i < taskCount; i++) {
+            task(context, i);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&submitMutex);
+    if (!poolStarted) {
+        startWorkers(defaultThreadCount() - 1);
+    }
+
+    // publish job
+    pthread_mutex_lock(&poolMutex);
+    jobTask = task;
+    jobContext = context;
+    jobTaskCount = taskCount;
+    __atomic_store_n(&jobNextIndex, 0, __ATOMIC_RELAXED);
+    jobActive = workerCount;
+    jobGeneration++;
+    pthread_cond_broadcast(&workCond);
+    pthread_mutex_unlock(&poolMutex);
+
+    // submitting thread takes part in work
+    runTasks();
+
+    // wait for workers to finish their last task
+    pthread_mutex_lock(&poolMutex);
+    while (jobActive > 0) {
+        pthread_cond_wait(&doneCond, &poolMutex);
+    }
+    jobTask = NULL;
+    jobContext = NULL;
+    pthread_mutex_unlock(&poolMutex);
+
+    pthread_mutex_unlock(&submitMutex);
+}
+
+void xThreadPool_shutdown(void)
+{
+    pthread_mutex_lock(&submitMutex);
+    stopWorkers();
+    pthread_mutex_unlock(&submitMutex);
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+static void *workerMain(void *arg)
+{
+    (void)arg;
+    uint64_t seenGeneration;
+
+    pthread_mutex_lock(&poolMutex);
+    seenGeneration = startGeneration;
+    for (;;) {
+        while (jobGeneration == seenGeneration && !poolStopping) {
+            pthread_cond_wait(&workCond, &poolMutex);
+        }
+        if (poolStopping) {
+            break;
+        }
+        seenGeneration = jobGeneration;
+        pthread_mutex_unlock(&poolMutex);
+
+        runTasks();
+
+        pthread_mutex_lock(&poolMutex);
+        if (--jobActive == 0) {
+            pthread_cond_signal(&doneCond);
+        }
+    }
+    pthread_mutex_unlock(&poolMutex);
+
+    return NULL;
+}
+
+static void runTasks(void)
+{
+    insideTask = 1;
+    for (;;) {
+        uint32_t index = __atomic_fetch_add(&jobNextIndex, 1, __ATOMIC_RELAXED);
+        if (index >= jobTaskCount) {
+            break;
+        }
+        jobTask(jobContext, index);
+    }
+    insideTask = 0;
+}
+
+static int32_t startWorkers(uint32_t count)
+{
+    poolStarted = 1;
+    poolStopping = 0;
+    workerCount = 0;
+    if (count == 0) {
+        return 0;
+    }
+
+    workers = (pthread_t *)malloc(count * sizeof(pthread_t));
+    if (workers == NULL) {
+        return -1;
+    }
+
+    // workers may start running after first job is already published, so they wait for generation newer than current one
+    pthread_mutex_lock(&poolMutex);
+    startGeneration = jobGeneration;
+    pthread_mutex_unlock(&poolMutex);
+    for (uint32_t i = 0; i < count; i++) {
+        if (pthread_create(&workers[i], NULL, workerMain, NULL) != 0) {
+            break;
+        }
+        workerCount++;
+    }
+
+    return (workerCount == count) ? 0 : -1;
+}
+
+static void stopWorkers(void)
+{
+    pthread_mutex_lock(&poolMutex);
+    poolStopping = 1;
+    pthread_cond_broadcast(&workCond);
+    pthread_mutex_unlock(&poolMutex);
+
+    for (uint32_t i = 0; i < workerCount; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    workers = NULL;
+    workerCount = 0;
+    poolStarted = 0;
+}
+
+static uint32_t defaultThreadCount(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (uint32_t)count : 1;
+}
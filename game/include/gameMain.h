@@ -24,6 +24,9 @@
  * 0x08 - headless mode
  * 0x10 - use neural network (+2 parameters)
  * 0x20 - managed mode (+3 parameters)
+ * 0x40 - randomly initialized neural network
+ * 0x80 - neural network loaded from file (+1 parameter)
+ * 0x100 - event descriptor signaled on game over (+1 parameter)
  */
 enum cmdFlag_e {
     CMD_FLAG_NONE = 0x00,
@@ -34,7 +37,8 @@ enum cmdFlag_e {
     CMD_FLAG_USE_NEURAL = 0x10,
     CMD_FLAG_MANAGED = 0x20,
     CMD_FLAG_NEURAL_RANDOM = 0x40,
-    CMD_FLAG_NEURAL_FILE = 0x80
+    CMD_FLAG_NEURAL_FILE = 0x80,
+    CMD_FLAG_NOTIFY = 0x100
 };
 
 /* Control input flags
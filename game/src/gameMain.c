@@ -3,6 +3,7 @@
 #include <raylib.h>         // graphics library
 #include <raymath.h>        // math library
 #include <signal.h>         // signal handling library
+#include <stdint.h>         // fixed size integers (event counter)
 #include <stdio.h>          // standard input/output library
 #include <stdlib.h>         // standard library (malloc, free, etc.)
 #include <time.h>           // time library (game logic timer and random seed)
@@ -33,11 +34,13 @@ static char *cmd_shInputName = NULL;
 static char *cmd_shOutputName = NULL;
 static char *cmd_shStateName = NULL;
 static char *cmd_nmodelPath = NULL;
+static int cmd_notifyFd = -1;  // event descriptor inherited from manager (-1 if manager is not notified)
 static struct sharedInput_s *shInput = NULL;
 static struct sharedOutput_s *shOutput = NULL;
 static struct sharedState_s *shState = NULL;
 
 static bool gameOver = false;
+static bool gameOverNotified = false;  // manager was already woken up by end of this game
 static bool gamePaused = false;
 static unsigned int score = 0;
 static unsigned short levelsCleared = 0;
@@ -123,6 +126,13 @@ int main(int argc, char *argv[])
 
                 srand((unsigned int)atoi(argv[i + 1]));
 
+                i += 1;
+            } else if (xString_isEqualCString(tmpString, "-e") || xString_isEqualCString(tmpString, "--event")) {
+                if (i + 1 >= argc || !cu_CStringIsNumeric(argv[i + 1]))
+                    break;
+
+                flags_cmd |= CMD_FLAG_NOTIFY;
+                cmd_notifyFd = atoi(argv[i + 1]);
                 i += 1;
             } else {
                 printf("ERROR: Unknown command line argument: %s\n", argv[i]);
@@ -150,6 +160,7 @@ int main(int argc, char *argv[])
         (flags_cmd & CMD_FLAG_HELP && flags_cmd & ~CMD_FLAG_HELP) ||  // help flag is exclusive to all other flags
         (flags_cmd & CMD_FLAG_VERSION && flags_cmd & ~CMD_FLAG_VERSION) ||     // version flag is exclusive to all other flags
         (flags_cmd & CMD_FLAG_HEADLESS && !(flags_cmd & CMD_FLAG_MANAGED)) ||  // headless mode requires managed mode
+        (flags_cmd & CMD_FLAG_NOTIFY && !(flags_cmd & CMD_FLAG_MANAGED)) ||    // event descriptor is given only by manager
         (flags_cmd & CMD_FLAG_USE_NEURAL &&
          flags_cmd & CMD_FLAG_MANAGED)) {  // neural network mode and managed mode cannot be defined at the same time (managed mode
                                            // already implies neural network mode later on)
@@ -177,6 +188,7 @@ int main(int argc, char *argv[])
         printf(
             "  -m, --managed <input> <output> <state>\tRun game in managed mode (input, output and state shared memory names).\n");
         printf("  -r, --random <seed>\t\t\t\tSet random seed for game initialization.\n");
+        printf("  -e, --event <descriptor>\t\t\tSignal inherited event descriptor on game over. Use together with --managed\n");
         return 0;
     } else if (flags_cmd & CMD_FLAG_VERSION) {
         printf("Program:\t\tAsteroids-game\n");
@@ -380,6 +392,12 @@ static inline void UpdateSharedState(void)
             flags_runtime |= RUNTIME_EXIT;
         }
         sm_unlockSharedState(shState);
+
+        // wake up manager waiting for end of game (final state is already published)
+        if (gameOver && !gameOverNotified && (flags_cmd & CMD_FLAG_NOTIFY)) {
+            uint64_t increment = 1;
+            gameOverNotified = (write(cmd_notifyFd, &increment, sizeof(increment)) == sizeof(increment));
+        }
     }
     return;
 }
@@ -418,6 +436,9 @@ static inline void UpdateSharedOutput(void)
         shOutput->gameOutput04 = (closestAsteroid.x - player.collider.z) / screenDiagonal;
         shOutput->gameOutput05 = closestAsteroid.y / PI;
         sm_unlockSharedOutput(shOutput);
+
+        // wake agent waiting for new observation
+        sm_publishSharedOutput(shOutput);
     }
     return;
 }
@@ -19,6 +19,16 @@ extern "C" {
 #include <stdint.h>         // standard integer types (uint32_t, ...)
 #include "fnnSerializer.h"  // FNN model descriptor and serialization functions
 
+/**
+ * @brief Random number stream used by breeding (independent of `rand` and of other streams)
+ *
+ */
+typedef struct {
+    uint64_t state;     // splitmix64 state
+    float spare;        // second normal number of last Box-Muller transform
+    uint32_t hasSpare;  // 1 if spare normal number was not used yet
+} FnnRandom;
+
 /**
  * @brief Generate randomized feedforward neural network model based on given parameters
  *
@@ -60,6 +70,35 @@ FnnModel *fnn_generateModel(uint32_t *neuronCounts, FnnActivation_e *activationF
  */
 FnnModel *fnn_modelBreed(FnnModel *parent1, FnnModel *parent2, float sbxCrossDistrIndex, float mutationRate, float mutationStddev);
 
+/**
+ * @brief Initialize random number stream
+ *
+ * @param random Pointer to the stream to initialize
+ * @param seed Seed shared by related streams (for example all children of one generation)
+ * @param stream Index of stream within seed (for example index of child)
+ *
+ * @note Sequence of stream depends only on seed and stream index, so streams can be used from any thread in any order.
+ */
+void fnn_randomInit(FnnRandom *random, uint64_t seed, uint64_t stream);
+
+/**
+ * @brief Breed values of two parents into child values using given random number stream
+ *
+ * @param random Random number stream of child
+ * @param parent1 Pointer to the values of first parent
+ * @param parent2 Pointer to the values of second parent
+ * @param child Pointer to the array for child values (may not overlap parent arrays)
+ * @param numElements Number of values of each parent and child
+ * @param distributionIndex Distribution index for the crossover (probability value between 0 and positive infinity)
+ * @param mutationRate Rate of mutation (probability value between 0 and 1) for each value
+ * @param stddev Standard deviation for the mutation
+ *
+ * @note Crossover and mutation are same as in `fnn_modelBreed`, but values are written in place (weights and biases of serialized
+ * model can be bred as one array) and child depends only on its stream.
+ */
+void fnn_breedValues(FnnRandom *random, const float *parent1, const float *parent2, float *child, uint64_t numElements,
+                     float distributionIndex, float mutationRate, float stddev);
+
 /**
  * @brief Generate random weights for the FNN based on given layer neurons and range
  * @details The weights are generated as uniformly distributed random numbers in the given range.
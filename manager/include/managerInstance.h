@@ -2,6 +2,7 @@
 #define MANINSTANCE_H
 
 #include <inttypes.h>  // standard integer types (for fixed size integers)
+#include <stdbool.h>   // boolean type
 #include <unistd.h>    // standard symbolic constants and types (for POSIX OS API)
 #include "xArray.h"    // dynamic array structure
 
@@ -12,9 +13,24 @@
 #define BREED_CROSSOVER_INDEX 2.0f
 #define BREED_MUTATION_RATE 0.1f
 #define BREED_MUTATION_STDDEV 0.1f
+#define SELECTION_TOURNAMENT_SIZE 3  // individuals drawn per tournament (best of them becomes parent)
 
 #define AUTOKILL_TIMEOUT 20  // timeout in seconds before killing instance if no score update happens
 
+#define SUPERVISOR_TIMER_PERIOD 1  // seconds between autokill checks if no other event wakes up supervisor
+#define SUPERVISOR_MAX_EVENTS 64   // maximal number of events handled per wakeup of supervisor
+#define SUPERVISOR_MAX_THREADS 4   // maximal number of supervisor threads running evaluation tasks
+
+#define RACING_MIN_SEEDS 2          // evaluated seeds before racing may cancel remaining seeds of individual
+#define RACING_CONFIDENCE_Z 2.0f    // half width of confidence bounds of mean fitness (in standard errors)
+#define RACING_KEEP_FRACTION 0.5f   // fraction of population (at least elitism count) which racing never cancels
+
+#define PARALLEL_CONTROL_PERIOD 2      // seconds between measurements of tick rate (and adjustments of adaptive parallelism)
+#define PARALLEL_GAIN_MIN 0.03f        // relative change of tick rate treated as gain or loss (smaller changes are noise)
+#define PARALLEL_PRESSURE_HIGH 25.0f   // CPU pressure (percent of time some tasks waited for CPU) forcing back off
+#define PARALLEL_LOAD_HIGH 1.5f        // load average per allowed CPU forcing back off
+#define PARALLEL_PROBE_PERIODS 5       // stable periods after which more instances are probed
+
 enum instanceStatus_e {
     INSTANCE_INACTIVE = 0x00,
     INSTANCE_WAITING = 0x01,
@@ -25,6 +41,23 @@ enum instanceStatus_e {
     INSTANCE_ERRENDED = 0x20
 };
 
+enum selectionMethod_e {
+    SELECTION_ROULETTE = 0,    // parent is drawn with probability proportional to fitness
+    SELECTION_TOURNAMENT = 1,  // parent is best of SELECTION_TOURNAMENT_SIZE uniformly drawn individuals
+    SELECTION_RANK = 2         // parent is drawn with probability proportional to rank (worst has rank 1)
+};
+
+enum activationPrecision_e {
+    PRECISION_EXACT = 0,  // sigmoid and tanh of neurons processes are evaluated by libm
+    PRECISION_FAST = 1    // sigmoid and tanh of neurons processes use vectorized approximation
+};
+
+enum instancePlacement_e {
+    PLACEMENT_NONE = 0,     // processes are scheduled freely by kernel
+    PLACEMENT_CORES = 1,    // game and AI process of slot are pinned to two cores of same NUMA node
+    PLACEMENT_SIBLINGS = 2  // game and AI process of slot are pinned to SMT siblings of one core
+};
+
 /**
  * @brief Manager instance descriptor
  */
@@ -32,21 +65,33 @@ typedef struct {
     uint32_t instanceID;           // unique instance ID
     enum instanceStatus_e status;  // status of the instance
 
-    pid_t gamePID;  // game process ID
-    pid_t aiPID;    // AI process ID
-
-    int scoreUpdateValue;    // last updated score value
-    long scoreUpdateTime;  // time of updating score
-
-    // uint32_t sharedMemoryID;  // shared memory ID
-    char shmemInput[255];   // input shared memory key
-    char shmemOutput[255];  // output shared memory key
-    char shmemStatus[255];  // status shared memory key
+    pid_t gamePID;  // game process ID of most recently started seed (-1 if not running)
+    pid_t aiPID;    // AI process ID of most recently started seed (-1 if not running)
 
-    char *modelPath;      // path to the model file
+    char *modelPath;      // path to the model file (record "genX.fnnp[i]" of checkpoint file, marker until generation is written)
     uint32_t generation;  // generation number
     float fitnessScore;   // fitness score
-    uint32_t currSeed;    // index of currently used seed of generation
+    uint32_t currSeed;    // number of evaluated seeds of generation (seeds may be evaluated concurrently)
+
+    uint32_t seedsScored;   // number of seeds whose game ended and was scored
+    double fitnessSum;      // sum of seed fitness over scored seeds
+    double fitnessSquares;  // sum of squared seed fitness over scored seeds
+    bool raced;             // remaining seeds were cancelled by racing (fitness score is mean of scored seeds)
+    uint32_t seedsCached;   // number of scored seeds taken from fitness cache instead of being played
+    uint64_t genomeHash;    // content hash of model layout, weights and biases (fitness cache key)
+
+    uint64_t inferenceCount;  // forward passes of neural network over all evaluated seeds
+    uint64_t duplicateCount;  // forward passes on observation which was already evaluated
+    float inferenceRate;      // mean forward passes per second over evaluated seeds
+    uint32_t forwardP50;      // median forward pass time in nanoseconds (worst of evaluated seeds)
+    uint32_t forwardP99;      // 99th percentile of forward pass time in nanoseconds (worst of evaluated seeds)
+    uint32_t cycleP99;        // 99th percentile of read, forward and write cycle in nanoseconds (worst of evaluated seeds)
+
+    int gameExitStatus;  // exit code of last game process (128 + signal number if killed, -1 if not reaped yet)
+    int aiExitStatus;    // exit code of last AI process (128 + signal number if killed, -1 if not reaped yet)
+    double gameCpuTime;  // user and system CPU seconds of game processes over all evaluated seeds
+    double aiCpuTime;    // user and system CPU seconds of AI processes over all evaluated seeds
+    long aiMaxResident;  // largest resident set of AI processes in kilobytes
 } managerInstance_t;
 
 /**
@@ -68,7 +113,9 @@ void mInstancer_cleanup(void);
  * @param modelPath Path to the population directory
  * @return 0 on success, 1 on failure
  *
- * @note Generation subdirectories are named as "genX" where X is the generation number starting from 0 (initial generation)
+ * @note Last checkpoint is loaded from packed population file linked as "population.fnnp". Population which was not checkpointed
+ * yet is loaded from generation subdirectory with largest X of "genX" subdirectories (X is the generation number starting from 0)
+ * containing model files
  */
 int32_t mInstancer_loadPopulation(const char *modelPath);
 
@@ -80,6 +127,9 @@ int32_t mInstancer_loadPopulation(const char *modelPath);
  * @note For this function to work, population must be loaded first
  *
  * @note This function creates new thread which will manage running loaded instances until all instances are finished or stopped
+ *
+ * @note Each generation is split into (individual, seed) tasks run by up to SUPERVISOR_MAX_THREADS supervisor threads,
+ * seeds of one individual may be evaluated concurrently in different slots
  */
 int32_t mInstancer_startPopulation(void);
 
@@ -145,6 +195,48 @@ const xArray *mInstancer_getAll(void);
  */
 void mInstancer_setMaxParallel(uint32_t value);
 
+/**
+ * @brief Set adaptive parallelism when running population
+ *
+ * @param value If true, number of parallel instances is adjusted between 1 and maximum number of parallel instances to maximize
+ * game ticks per second (backing off when CPU pressure or load average of host is high), otherwise maximum is always used
+ */
+void mInstancer_setAdaptiveParallel(bool value);
+
+/**
+ * @brief Set racing of individuals when running population
+ *
+ * @param value If true, remaining seeds of individual are cancelled once confidence bounds of its mean fitness show it cannot
+ * reach top RACING_KEEP_FRACTION of population (or elite), otherwise all seeds of all individuals are evaluated
+ *
+ * @note Raced individuals keep mean fitness of their scored seeds, which is recorded in report together with seed count
+ */
+void mInstancer_setRacing(bool value);
+
+/**
+ * @brief Set use of persistent fitness cache when running population
+ *
+ * @param value If true, fitness of seeds already played by identical model (same weights and biases) with same game and neural
+ * network programs and activation precision is taken from `fitness.cache` file of population instead of playing the seed again
+ */
+void mInstancer_setFitnessCache(bool value);
+
+/**
+ * @brief Get fitness cache statistics of current (or last) generation
+ *
+ * @param hits Pointer to number of seeds taken from cache (output)
+ * @param lookups Pointer to number of seeds looked up in cache (output)
+ */
+void mInstancer_getCacheStatistics(uint32_t *hits, uint32_t *lookups);
+
+/**
+ * @brief Get current parallelism of running population
+ *
+ * @param activeCount Pointer to number of instances allowed to run in parallel (output)
+ * @param ticksPerSecond Pointer to game ticks per second of all running instances in last measurement period (output)
+ */
+void mInstancer_getParallelism(uint32_t *activeCount, float *ticksPerSecond);
+
 /**
  * @brief Set maximum number of evolution iterations to run
  *
@@ -166,6 +258,16 @@ void mInstancer_setEpochSize(uint32_t value);
  */
 void mInstancer_setElitismCount(uint32_t value);
 
+/**
+ * @brief Set selection of parents when breeding next generation
+ *
+ * @param value Selection method (SELECTION_ROULETTE by default)
+ *
+ * @note Tournament and rank selection depend only on order of fitness scores, not on their scale. Roulette falls back to uniform
+ * selection if no individual has positive fitness.
+ */
+void mInstancer_setSelection(enum selectionMethod_e value);
+
 /**
  * @brief Set number of seeds to use for training single generation
  *
@@ -173,4 +275,34 @@ void mInstancer_setElitismCount(uint32_t value);
  */
 void mInstancer_setSeedCount(uint32_t value);
 
+/**
+ * @brief Set number of generations between writing population to disk when running population
+ *
+ * @param value Checkpoint interval in generations (if 0, population is written only when run ends or is stopped)
+ *
+ * @note Bred generations are kept in memory and mapped by neurons processes without files. Evaluated generation is checkpointed
+ * (with its fitness table) to packed population file "genX.fnnp" and link "population.fnnp" of population directory is pointed to it
+ */
+void mInstancer_setCheckpointInterval(uint32_t value);
+
+/**
+ * @brief Set precision of sigmoid and tanh activations of AI processes when running population
+ *
+ * @param value Precision mode (PRECISION_EXACT by default)
+ *
+ * @note Fitness of exact and fast mode can be compared by running same population in both modes, fitness cached in one mode is
+ * never reused in the other
+ */
+void mInstancer_setPrecision(enum activationPrecision_e value);
+
+/**
+ * @brief Set CPU placement of game and AI processes when running population
+ *
+ * @param value Placement mode (PLACEMENT_NONE by default)
+ *
+ * @note Pairs of CPUs are built from CPUs allowed to manager, both CPUs of pair are on same NUMA node and shared memory of
+ * slot is first touched on that node, pairs of different nodes are interleaved between slots
+ */
+void mInstancer_setPlacement(enum instancePlacement_e value);
+
 #endif  // MANINSTANCE_H
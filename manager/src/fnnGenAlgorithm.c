@@ -40,6 +40,19 @@ static float normalRandom(float mean, float stddev)
     }
 }
 
+/**
+ * @brief Calculate the distance factor (beta) for SBX crossover from uniform random number
+ *
+ * @param random Uniform random number in range [0, 1)
+ * @param distrIndex Distribution index (eta) for the SBX algorithm
+ * @return `float`: Distance factor
+ */
+static float sbxBeta(float random, float distrIndex)
+{
+    return (random <= 0.5f) ? powf(2.0f * random, 1.0f / (distrIndex + 1.0f))
+                            : powf(1.0f / (2.0f * (1.0f - random)), 1.0f / (distrIndex + 1.0f));
+}
+
 /**
  * @brief Calculate the distance factor (beta) for SBX crossover
  *
@@ -48,18 +61,64 @@ static float normalRandom(float mean, float stddev)
  */
 static float distanceFactor(float distrIndex)
 {
-    // check for valid distribution index
-    if (distrIndex <= 0) {
-        return 1.0f;
-    }
-
     // generate positive random number smaller than 1
     float random = (float)rand();
     random = (random == (float)RAND_MAX) ? (random - 1.0f) / (float)RAND_MAX : random / (float)RAND_MAX;
 
-    // calculate the distance factor
-    return (random <= 0.5f) ? powf(2.0f * random, 1.0f / (distrIndex + 1.0f))
-                            : powf(1.0f / (2.0f * (1.0f - random)), 1.0f / (distrIndex + 1.0f));
+    return sbxBeta(random, distrIndex);
+}
+
+/**
+ * @brief Get next 64 random bits of stream (splitmix64)
+ *
+ * @param random Random number stream
+ * @return `uint64_t`: Random bits
+ */
+static uint64_t randomNext(FnnRandom *random)
+{
+    uint64_t z = (random->state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Get uniform random number of stream
+ *
+ * @param random Random number stream
+ * @return `float`: Random number in range [0, 1)
+ */
+static float randomUniform(FnnRandom *random)
+{
+    return (float)(randomNext(random) >> 40) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Get normally distributed random number of stream (polar Box-Muller transform, same as `normalRandom`)
+ *
+ * @param random Random number stream
+ * @param mean Mean value
+ * @param stddev Standard deviation
+ * @return `float`: Random number from normal distribution
+ */
+static float randomNormal(FnnRandom *random, float mean, float stddev)
+{
+    if (random->hasSpare) {
+        random->hasSpare = 0;
+        return random->spare * stddev + mean;
+    }
+
+    float x, y, r;
+    do {
+        x = 2.0f * randomUniform(random) - 1.0f;
+        y = 2.0f * randomUniform(random) - 1.0f;
+        r = x * x + y * y;
+    } while (r == 0.0f || r > 1.0f);
+
+    float d = sqrtf(-2.0f * logf(r) / r);
+    random->spare = y * d;
+    random->hasSpare = 1;
+    return x * d * stddev + mean;
 }
 
 /**
@@ -204,6 +263,40 @@ FnnModel *fnn_modelBreed(FnnModel *parent1, FnnModel *parent2, float sbxCrossDis
     return child;
 }
 
+void fnn_randomInit(FnnRandom *random, uint64_t seed, uint64_t stream)
+{
+    // stream index is mixed into seed, so that neighbouring streams do not start from neighbouring states
+    random->state = stream;
+    random->state = seed ^ randomNext(random);
+    random->spare = 0.0f;
+    random->hasSpare = 0;
+}
+
+void fnn_breedValues(FnnRandom *random, const float *parent1, const float *parent2, float *child, uint64_t numElements,
+                     float distributionIndex, float mutationRate, float stddev)
+{
+    // parameter checking
+    if (random == NULL || parent1 == NULL || parent2 == NULL || child == NULL || distributionIndex < 0 || mutationRate < 0 ||
+        stddev < 0) {
+        return;
+    }
+
+    for (uint64_t i = 0; i < numElements; i++) {
+        // simulated binary crossover (SBX)
+        float x1 = parent1[i];
+        float x2 = parent2[i];
+        float beta = sbxBeta(randomUniform(random), distributionIndex);
+        float value = (randomNext(random) & 1) ? 0.5f * ((1.0f + beta) * x1 + (1.0f - beta) * x2)
+                                               : 0.5f * ((1.0f - beta) * x1 + (1.0f + beta) * x2);
+
+        // mutation
+        if (randomUniform(random) < mutationRate) {
+            value = randomNormal(random, value, stddev);
+        }
+        child[i] = value;
+    }
+}
+
 float *fnn_generateWeights(const uint32_t *layerNeurons, uint32_t layerCount, float rangeMin, float rangeMax)
 {
     // parameter checking
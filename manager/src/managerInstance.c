@@ -1,13 +1,25 @@
+#define _GNU_SOURCE  // sched_setaffinity, pthread_setaffinity_np and CPU_* macros
+
 #include "managerInstance.h"
 #include <dirent.h>           // directory entry structure and functions
+#include <errno.h>            // error codes (timed wait of instance starter)
 #include <fcntl.h>            // file control options
 #include <inttypes.h>         // standard integer types
+#include <math.h>             // confidence bounds of racing
 #include <pthread.h>          // POSIX threads
+#include <sched.h>            // CPU affinity of instance processes
 #include <stdio.h>            // standard I/O
 #include <stdlib.h>           // standard library
+#include <string.h>           // copying of genome records
+#include <sys/epoll.h>        // event loop of supervisor thread
+#include <sys/eventfd.h>      // completion event signaled by games
+#include <sys/mman.h>         // anonymous memory file holding population (mapped by neurons processes)
+#include <sys/resource.h>     // resource usage of reaped children
 #include <sys/stat.h>         // file status
+#include <sys/syscall.h>      // pidfd_open, pidfd_send_signal and waitid system calls
+#include <sys/timerfd.h>      // periodic wakeup for autokill checks
 #include <sys/types.h>        // data types
-#include <sys/wait.h>         // waitpid (for child process termination)
+#include <sys/wait.h>         // waitid and waitpid (for child process termination)
 #include <time.h>             // time types and functions
 #include <unistd.h>           // standard symbolic constants and types
 #include "commonUtility.h"    // common utility functions
@@ -16,6 +28,7 @@
 #include "sharedMemory.h"     // shared memory functions
 #include "xArray.h"           // dynamic array structure and functions
 #include "xDictionary.h"      // dictionary structure and functions
+#include "xThreadPool.h"      // process-wide thread pool (breeding of children)
 
 //------------------------------------------------------------------------------------
 // program globals
@@ -33,21 +46,224 @@ static uint32_t elitismCount = 0;     // number of best instances to keep in nex
 static uint32_t randSeedCount = 0;    // number of random seeds to use before evaluating instance fitness
 static uint32_t *randSeed = NULL;     // random seeds for training generations of instances
 static char *populationDir = NULL;    // path to the loaded population directory
+static enum instancePlacement_e placementMode = PLACEMENT_NONE;  // CPU placement of instance processes
+static bool adaptiveParallel = false;                            // adjust number of parallel instances to host load
+static bool racingEnabled = false;                               // cancel remaining seeds of hopeless individuals
+static bool cacheEnabled = false;                                // take fitness of already played seeds from cache
+static uint32_t checkpointInterval = 1;                          // generations between writing population to disk
+static enum selectionMethod_e selectionMethod = SELECTION_ROULETTE;  // selection of parents of next generation
+static enum activationPrecision_e activationPrecision = PRECISION_EXACT;  // precision of activations in neurons processes
 
 static bool instancesRunning = false;  // flag indicating if instances are running
+static bool stopRequested = false;     // flag asking instance starter and supervisor threads to stop
 pthread_t thread_instanceStarter;
 
+// event loop tags of supervisor descriptors (process descriptors are tagged with task index and descriptor)
+#define SUPERVISOR_EVENT_COMPLETION UINT64_MAX
+#define SUPERVISOR_EVENT_TIMER (UINT64_MAX - 1)
+
+#ifndef P_PIDFD
+#define P_PIDFD 3  // waitid on process descriptor (missing in older C library headers)
+#endif
+
+/**
+ * @brief Exit status and resource usage of reaped child process
+ */
+typedef struct {
+    int exitStatus;    // exit code (128 + signal number if killed)
+    double cpuTime;    // user and system CPU seconds
+    long maxResident;  // largest resident set in kilobytes
+} childExit_t;
+
+/**
+ * @brief Evaluation of one individual on one game seed
+ */
+typedef struct {
+    uint32_t instanceID;           // evaluated individual
+    uint32_t seedIndex;            // index of game seed
+    enum instanceStatus_e status;  // waiting, running, finished or errored (ended or errended when slot is released)
+    uint32_t slot;                 // slot of running task (index of its shared memory blocks)
+    pid_t gamePID;                 // game process ID
+    pid_t aiPID;                   // AI process ID
+    int gamePidfd;                 // game process descriptor watched by supervisor (-1 if reaped)
+    int aiPidfd;                   // AI process descriptor watched by supervisor (-1 if reaped)
+    int scoreUpdateValue;          // last updated score value
+    long scoreUpdateTime;          // time of updating score
+    uint32_t tickSeen;             // game ticks (published observations) already counted into tick rate
+} managerTask_t;
+
+/**
+ * @brief Double-ended queue of task indices (owner takes tasks from head, other supervisors steal from tail)
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    uint32_t *items;
+    uint32_t head;
+    uint32_t tail;
+} taskDeque_t;
+
+/**
+ * @brief Supervisor thread running tasks in its own range of slots
+ */
+typedef struct {
+    pthread_t thread;
+    int epoll;            // event loop (process descriptors, completion event, timer)
+    int completionEvent;  // event counter signaled by games on game over (inherited by game processes)
+    int autokillTimer;    // periodic timer for autokill checks
+    uint32_t slotFirst;   // first slot owned by supervisor
+    uint32_t slotCount;   // number of slots owned by supervisor
+    int32_t *slotTasks;   // task running in each owned slot (-1 if slot is free)
+    uint32_t running;     // number of occupied slots
+    taskDeque_t deque;    // tasks assigned to supervisor
+    pid_t *unreaped;      // killed children without process descriptor (reaped after mutex is released)
+    uint32_t unreapedCount;
+} supervisor_t;
+
+/**
+ * @brief CPUs of game and AI process running in slot
+ *
+ */
+typedef struct cpuPair_s {
+    int gameCPU;     // CPU of game process
+    int aiCPU;       // CPU of AI process
+    uint32_t node;   // NUMA node of both CPUs
+    uint32_t order;  // position of pair within its node (pairs are interleaved by it)
+} cpuPair_t;
+
+/**
+ * @brief Fitness of one seed played by one model (record of fitness cache file)
+ */
+typedef struct {
+    uint64_t genomeHash;   // content hash of model layout, weights and biases
+    uint64_t versionHash;  // content hash of game and neural network programs and fitness weights
+    uint32_t seed;         // game seed
+    float fitness;         // fitness of seed (before averaging over seeds)
+} fitnessRecord_t;
+
+/**
+ * @brief Generation of genome records kept as packed population image in anonymous memory file
+ */
+typedef struct {
+    unsigned char *base;  // mapping of memory file (header, records and fitness table)
+    uint64_t size;        // size of memory file
+    int fd;               // memory file (inherited by neurons processes, -1 if not allocated)
+} populationArena_t;
+
+/**
+ * @brief Breeding of next generation shared by all children (children are bred in parallel)
+ */
+typedef struct {
+    const populationArena_t *parents;  // current generation
+    populationArena_t *children;       // next generation
+    const uint32_t *parentIDs;         // instance IDs of two parents of each child (elite is copied from first)
+    uint32_t eliteCount;               // number of children copied from elite parents
+    uint64_t seed;                     // seed of generation (random stream of child is derived from it and child index)
+} breedContext_t;
+
+/**
+ * @brief State of hill climbing controller of adaptive parallelism
+ */
+typedef struct {
+    struct timespec sampleTime;  // time of last measurement
+    float previousRate;          // tick rate measured before last adjustment
+    int32_t lastStep;            // last change of active slots (0 if unchanged)
+    uint32_t stablePeriods;      // periods without change of active slots
+    uint32_t cpuCount;           // CPUs allowed to manager
+} parallelControl_t;
+
+static managerTask_t *tasks = NULL;        // tasks of current generation (seeds of one individual are adjacent)
+static uint32_t taskCount = 0;             // number of tasks of current generation
+static supervisor_t *supervisors = NULL;   // supervisor threads of current generation
+static uint32_t supervisorCount = 0;       // number of supervisor threads
+static uint32_t slotsAllocated = 0;        // number of slots whose shared memory blocks were allocated
+static uint32_t supervisorsRunning = 0;    // number of supervisor threads which did not end yet
+static pthread_cond_t supervisorEnded = PTHREAD_COND_INITIALIZER;  // signaled by ending supervisor thread
+static uint32_t activeSlots = 0;           // slots allowed to take new tasks (lower slots first)
+static uint64_t tickCount = 0;             // game ticks counted since last measurement
+static float tickRate = 0.0f;              // game ticks per second in last measurement period
+static xDictionary *cacheIndex = NULL;     // index of cache record (plus one) by key of genome, version and seed
+static fitnessRecord_t *cacheRecords = NULL;  // fitness records of current version (from file and played since)
+static uint32_t cacheRecordCount = 0;      // number of fitness records
+static uint32_t cacheRecordCapacity = 0;   // capacity of fitness record array
+static FILE *cacheFile = NULL;             // fitness cache file of population (records are appended)
+static uint64_t cacheVersion = 0;          // version hash of records used by current run
+static uint32_t cacheHits = 0;             // seeds of generation taken from cache
+static uint32_t cacheLookups = 0;          // seeds of generation looked up in cache
+static cpuPair_t *cpuPairs = NULL;         // CPU pairs assigned to slots round robin (NULL if placement is disabled)
+static uint32_t cpuPairCount = 0;          // number of CPU pairs
+static cpu_set_t *nodeCPUs = NULL;         // allowed CPUs of each NUMA node
+static uint32_t nodeCount = 0;             // number of NUMA nodes
+static populationArena_t arena = {NULL, 0, -1};  // genome records of current generation (indexed by instance ID)
+static uint64_t arenaRecordsOffset = 0;    // offset of first record in packed population image
+static uint64_t arenaStride = 0;           // bytes between starts of consecutive records (multiple of serializer alignment)
+static uint64_t arenaRecordSize = 0;       // serialized size of model stored in record
+static uint32_t arenaCount = 0;            // number of records
+static uint32_t arenaGeneration = 0;       // generation of records
+static bool arenaDirty = false;            // generation of records was not written to disk yet
+static FnnModel *arenaLayout = NULL;       // layer sizes and activations shared by all records (without values)
+
 //------------------------------------------------------------------------------------
 // local function declarations
 
 static managerInstance_t *instance_new(char *modelPath);
 static void instance_free(managerInstance_t *instance);
 static int instance_compare(const managerInstance_t *a, const managerInstance_t *b);
-static int instance_start(uint32_t instanceID);
+static void instance_collectStatistics(managerInstance_t *instance, struct sharedState_s *shStat);
+static void instance_taskEnded(managerInstance_t *instance);
+static void instance_scoreSeed(managerInstance_t *instance, float seedFitness);
+static void instance_bounds(const managerInstance_t *instance, float *lower, float *upper);
+static void instance_race(void);
+static int instance_compareBounds(const void *a, const void *b);
 static void instance_writeReport(const xArray *descriptorArray);
 static int instance_nextgen(xArray *descriptorArray);
+static void breed_child(void *context, uint32_t index);
+static uint32_t selection_pick(const double *cumulative, uint32_t count);
 static void *thr_instanceStarter(void *arg);
-static int fCopy(const char *src, const char *dest);
+static void *thr_supervisor(void *arg);
+static int supervisor_open(supervisor_t *supervisor, uint32_t slotFirst, uint32_t slotCount);
+static void supervisor_close(supervisor_t *supervisor);
+static int32_t supervisor_take(supervisor_t *supervisor);
+static uint32_t supervisor_pending(void);
+static void supervisor_wake(supervisor_t *supervisor);
+static int supervisor_watch(supervisor_t *supervisor, pid_t pid, uint32_t taskIndex, int *pidfd);
+static void supervisor_drain(supervisor_t *supervisor, bool blocking);
+static int supervisor_reap(int pidfd, childExit_t *childExit);
+static void supervisor_wait(supervisor_t *supervisor);
+static int task_start(supervisor_t *supervisor, uint32_t slot, uint32_t taskIndex);
+static int task_update(uint32_t taskIndex, bool stopping);
+static void task_childExited(managerTask_t *task, int pidfd, const childExit_t *childExit);
+static void task_signal(const managerTask_t *task, int signal);
+static void task_countTicks(managerTask_t *task);
+static void parallel_control(parallelControl_t *control, uint32_t parallelMax);
+static float parallel_readPressure(void);
+static float parallel_readLoad(void);
+static int cache_open(void);
+static void cache_close(void);
+static int cache_lookup(uint64_t genomeHash, uint32_t seed, float *fitness);
+static void cache_store(uint64_t genomeHash, uint32_t seed, float fitness);
+static int cache_insert(const fitnessRecord_t *record);
+static unsigned long long cache_key(uint64_t genomeHash, uint64_t versionHash, uint32_t seed);
+static uint64_t cache_genomeHash(uint32_t instanceID);
+static uint64_t cache_fileHash(uint64_t hash, const char *path);
+static uint64_t cache_hash(uint64_t hash, const void *data, size_t size);
+static int arena_allocate(populationArena_t *population, const FnnModel *layout, uint32_t count, uint32_t generation);
+static int arena_store(populationArena_t *population, uint32_t index, const FnnModel *model);
+static void arena_view(FnnModel *view, const populationArena_t *population, uint32_t index);
+static unsigned char *arena_record(const populationArena_t *population, uint32_t index);
+static int arena_loadPacked(const char *path);
+static int arena_describe(bool checkpointed);
+static char *arena_modelPath(uint32_t index, bool checkpointed);
+static int arena_checkpoint(void);
+static void arena_release(populationArena_t *population);
+static void arena_free(void);
+static struct sharedState_s *slot_state(uint32_t slot);
+static struct sharedOutput_s *slot_output(uint32_t slot);
+static void slot_name(char *name, uint32_t slot, char suffix);
+static int placement_build(enum instancePlacement_e mode);
+static void placement_free(void);
+static int placement_readList(const char *path, cpu_set_t *set);
+static int placement_compare(const void *a, const void *b);
+static int pidfdOpen(pid_t pid);
 
 //------------------------------------------------------------------------------------
 // public function definitions
@@ -86,33 +302,41 @@ void mInstancer_cleanup(void)
 
     pthread_mutex_lock(&instancerMutex);
 
-    // free all shared memory blocks and instance descriptors
-    for (int i = 0; i < descriptors->size; i++) {
-        managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, i);
+    // free shared memory blocks of all slots used so far
+    for (uint32_t slot = 0; slot < slotsAllocated; slot++) {
+        char shmemInput[32], shmemOutput[32], shmemStatus[32];
+        slot_name(shmemInput, slot, 'i');
+        slot_name(shmemOutput, slot, 'o');
+        slot_name(shmemStatus, slot, 's');
 
-        struct sharedInput_s *shIn = (struct sharedInput_s *)xDictionary_remove(shInDict, cu_CStringHash(instance->shmemInput));
+        struct sharedInput_s *shIn = (struct sharedInput_s *)xDictionary_remove(shInDict, cu_CStringHash(shmemInput));
         if (shIn != NULL) {
-            sm_freeSharedInput(shIn, instance->shmemInput);
+            sm_freeSharedInput(shIn, shmemInput);
         }
-        struct sharedOutput_s *shOut =
-            (struct sharedOutput_s *)xDictionary_remove(shOutDict, cu_CStringHash(instance->shmemOutput));
+        struct sharedOutput_s *shOut = (struct sharedOutput_s *)xDictionary_remove(shOutDict, cu_CStringHash(shmemOutput));
         if (shOut != NULL) {
-            sm_freeSharedOutput(shOut, instance->shmemOutput);
+            sm_freeSharedOutput(shOut, shmemOutput);
         }
-        struct sharedState_s *shStat =
-            (struct sharedState_s *)xDictionary_remove(shStatDict, cu_CStringHash(instance->shmemStatus));
+        struct sharedState_s *shStat = (struct sharedState_s *)xDictionary_remove(shStatDict, cu_CStringHash(shmemStatus));
         if (shStat != NULL) {
-            sm_freeSharedState(shStat, instance->shmemStatus);
+            sm_freeSharedState(shStat, shmemStatus);
         }
-
-        instance_free(instance);
     }
+    slotsAllocated = 0;
+
+    // free instance descriptors
+    xArray_forEach(descriptors, (void (*)(void *))instance_free);
 
-    // free random seed array
+    // free random seed array and tasks of last generation
     if (randSeed != NULL) {
         free(randSeed);
         randSeed = NULL;
     }
+    free(tasks);
+    tasks = NULL;
+    taskCount = 0;
+    arena_free();
+    xThreadPool_shutdown();
 
     // free all instancer structures
     xArray_free(descriptors);
@@ -133,6 +357,7 @@ int32_t mInstancer_loadPopulation(const char *populationPath)
     // if there is already population loaded, clear it from structures
     xArray_forEach(descriptors, (void (*)(void *))instance_free);
     descriptors->size = 0;
+    arena_free();
 
     // check if given directory exists and is accessible
     struct stat st = {0};
@@ -140,6 +365,28 @@ int32_t mInstancer_loadPopulation(const char *populationPath)
         return 1;
     }
 
+    // last checkpoint is loaded from packed population file (directories of model files are scanned only if population was not
+    // checkpointed yet)
+    char *packedPath = (char *)malloc((cu_CStringLength(populationPath) + 17) * sizeof(char));
+    if (packedPath == NULL) {
+        return 1;
+    }
+    sprintf(packedPath, "%s/population.fnnp", populationPath);
+    if (stat(packedPath, &st) == 0) {
+        int result = arena_loadPacked(packedPath);
+        free(packedPath);
+        if (result != 0) {
+            return 1;
+        }
+        if (populationDir != NULL) {
+            free(populationDir);
+            populationDir = NULL;
+        }
+        cu_CStringConcat(&populationDir, populationPath);
+        return (arena_describe(true) == 0 && descriptors->size > 0) ? 0 : 1;
+    }
+    free(packedPath);
+
     // open directory and search for `genX` subdirectories
     DIR *dir;
     struct dirent *ent;
@@ -172,8 +419,17 @@ int32_t mInstancer_loadPopulation(const char *populationPath)
         return 1;
     }
 
-    // load models
+    // count models so that arena can be allocated for whole generation
+    uint32_t modelCount = 0;
     while ((ent = readdir(dir)) != NULL) {
+        if (ent->d_type == DT_REG && cu_CStringStartsWith(ent->d_name, "model_") && cu_CStringEndsWith(ent->d_name, ".fnnm")) {
+            modelCount++;
+        }
+    }
+    rewinddir(dir);
+
+    // load models into arena (record index is instance ID)
+    while ((ent = readdir(dir)) != NULL && descriptors->size < (int)modelCount) {
         if (ent->d_type != DT_REG || !cu_CStringStartsWith(ent->d_name, "model_") || !cu_CStringEndsWith(ent->d_name, ".fnnm"))
             continue;
 
@@ -186,9 +442,22 @@ int32_t mInstancer_loadPopulation(const char *populationPath)
         }
         sprintf(modelPath, "%s/%s", genPath, ent->d_name);
 
+        // copy model into its record (all models of population must share layout)
+        FnnModel *model = fnn_deserialize(modelPath);
+        if (model == NULL || (arena.base == NULL && arena_allocate(&arena, model, modelCount, genLast) != 0) ||
+            arena_store(&arena, (uint32_t)descriptors->size, model) != 0) {
+            fnn_free(model);
+            free(modelPath);
+            closedir(dir);
+            free(genPath);
+            return 1;
+        }
+        fnn_free(model);
+
         // create instance descriptor
         managerInstance_t *instance = instance_new(modelPath);
         if (instance == NULL) {
+            free(modelPath);
             closedir(dir);
             free(genPath);
             return 1;
@@ -205,6 +474,9 @@ int32_t mInstancer_loadPopulation(const char *populationPath)
     if (descriptors->size == 0) {
         return 1;
     }
+    arenaCount = (uint32_t)descriptors->size;
+    arenaGeneration = genLast;
+    arenaDirty = false;
 
     if (populationDir != NULL) {
         free(populationDir);
@@ -227,6 +499,8 @@ int32_t mInstancer_startPopulation(void)
         pthread_join(thread_instanceStarter, NULL);
         thread_instanceStarter = 0;
     }
+    instancesRunning = true;
+    stopRequested = false;
     pthread_mutex_unlock(&instancerMutex);
 
     // start worker thread to manage running instances
@@ -242,10 +516,14 @@ int32_t mInstancer_stopPopulation(void)
         return 1;
     }
 
-    // stop worker thread
-    if (pthread_cancel(thread_instanceStarter) != 0) {
-        return 1;
+    // ask supervisors to end their running tasks (they reap processes before exiting)
+    pthread_mutex_lock(&instancerMutex);
+    stopRequested = true;
+    for (uint32_t i = 0; i < supervisorCount; i++) {
+        supervisor_wake(&supervisors[i]);
     }
+    pthread_mutex_unlock(&instancerMutex);
+
     pthread_join(thread_instanceStarter, NULL);
     thread_instanceStarter = 0;
 
@@ -256,16 +534,6 @@ int32_t mInstancer_stopPopulation(void)
         if (instance->status & (INSTANCE_FINISHED | INSTANCE_RUNNING | INSTANCE_WAITING)) {
             instance->status = INSTANCE_ERRORED;
         }
-        struct sharedState_s *shStat = (struct sharedState_s *)xDictionary_get(shStatDict, cu_CStringHash(instance->shmemStatus));
-        if (shStat != NULL) {
-            sm_lockSharedState(shStat);
-            shStat->control_gameExit = true;
-            shStat->control_neuronsExit = true;
-            sm_unlockSharedState(shStat);
-
-            waitpid(instance->gamePID, NULL, 0);
-            waitpid(instance->aiPID, NULL, 0);
-        }
     }
     pthread_mutex_unlock(&instancerMutex);
 
@@ -288,9 +556,13 @@ int32_t mInstancer_killIndividual(uint32_t instanceID)
         return 1;
     }
 
-    // terminate game and AI processes
-    kill(instance->gamePID, SIGTERM);
-    kill(instance->aiPID, SIGTERM);
+    // terminate game and AI processes of all running seeds (supervisors reap them, waiting seeds are skipped)
+    for (uint32_t i = instanceID * randSeedCount; i < (instanceID + 1) * randSeedCount && i < taskCount; i++) {
+        if (tasks[i].status & INSTANCE_RUNNING) {
+            task_signal(&tasks[i], SIGTERM);
+            tasks[i].status = INSTANCE_ERRORED;
+        }
+    }
     instance->status = INSTANCE_ERRORED;
     instance->fitnessScore = 0.0f;  // avoid propagating this instance to next generation
 
@@ -314,15 +586,16 @@ int32_t mInstancer_toggleHeadless(uint32_t instanceID)
         return 1;
     }
 
-    // toggle headless mode
-    struct sharedState_s *shStat = (struct sharedState_s *)xDictionary_get(shStatDict, cu_CStringHash(instance->shmemStatus));
-    if (shStat == NULL) {
-        pthread_mutex_unlock(&instancerMutex);
-        return 1;
+    // toggle headless mode of all running seeds
+    for (uint32_t i = instanceID * randSeedCount; i < (instanceID + 1) * randSeedCount && i < taskCount; i++) {
+        struct sharedState_s *shStat = (tasks[i].status & INSTANCE_RUNNING) ? slot_state(tasks[i].slot) : NULL;
+        if (shStat == NULL) {
+            continue;
+        }
+        sm_lockSharedState(shStat);
+        shStat->game_runHeadless = !shStat->game_runHeadless;
+        sm_unlockSharedState(shStat);
     }
-    sm_lockSharedState(shStat);
-    shStat->game_runHeadless = !shStat->game_runHeadless;
-    sm_unlockSharedState(shStat);
 
     pthread_mutex_unlock(&instancerMutex);
     return 0;
@@ -361,6 +634,43 @@ void mInstancer_setMaxParallel(uint32_t value)
     pthread_mutex_unlock(&instancerMutex);
 }
 
+void mInstancer_setAdaptiveParallel(bool value)
+{
+    pthread_mutex_lock(&instancerMutex);
+    adaptiveParallel = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
+void mInstancer_setRacing(bool value)
+{
+    pthread_mutex_lock(&instancerMutex);
+    racingEnabled = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
+void mInstancer_setFitnessCache(bool value)
+{
+    pthread_mutex_lock(&instancerMutex);
+    cacheEnabled = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
+void mInstancer_getCacheStatistics(uint32_t *hits, uint32_t *lookups)
+{
+    pthread_mutex_lock(&instancerMutex);
+    *hits = cacheHits;
+    *lookups = cacheLookups;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
+void mInstancer_getParallelism(uint32_t *activeCount, float *ticksPerSecond)
+{
+    pthread_mutex_lock(&instancerMutex);
+    *activeCount = instancesRunning ? activeSlots : 0;
+    *ticksPerSecond = instancesRunning ? tickRate : 0.0f;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
 void mInstancer_setMaxIterations(uint32_t value)
 {
     if (value < 1) {
@@ -392,6 +702,17 @@ void mInstancer_setElitismCount(uint32_t value)
     pthread_mutex_unlock(&instancerMutex);
 }
 
+void mInstancer_setSelection(enum selectionMethod_e value)
+{
+    if (value > SELECTION_RANK) {
+        value = SELECTION_ROULETTE;
+    }
+
+    pthread_mutex_lock(&instancerMutex);
+    selectionMethod = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
 void mInstancer_setSeedCount(uint32_t value)
 {
     if (value < 1) {
@@ -407,6 +728,35 @@ void mInstancer_setSeedCount(uint32_t value)
     pthread_mutex_unlock(&instancerMutex);
 }
 
+void mInstancer_setCheckpointInterval(uint32_t value)
+{
+    pthread_mutex_lock(&instancerMutex);
+    checkpointInterval = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
+void mInstancer_setPrecision(enum activationPrecision_e value)
+{
+    if (value > PRECISION_FAST) {
+        value = PRECISION_EXACT;
+    }
+
+    pthread_mutex_lock(&instancerMutex);
+    activationPrecision = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
+void mInstancer_setPlacement(enum instancePlacement_e value)
+{
+    if (value > PLACEMENT_SIBLINGS) {
+        value = PLACEMENT_NONE;
+    }
+
+    pthread_mutex_lock(&instancerMutex);
+    placementMode = value;
+    pthread_mutex_unlock(&instancerMutex);
+}
+
 //------------------------------------------------------------------------------------
 // local function definitions
 
@@ -416,11 +766,6 @@ static managerInstance_t *instance_new(char *modelPath)
     if (modelPath == NULL) {
         return NULL;
     }
-    // unsigned long long pathHash = cu_CStringHash(modelPath);
-    const char *filenameStart = modelPath + cu_CStringLength(modelPath);
-    while (filenameStart > modelPath && *(filenameStart - 1) != '/') {
-        filenameStart--;
-    }
 
     // allocate new instance
     managerInstance_t *instance = (managerInstance_t *)malloc(sizeof(managerInstance_t));
@@ -433,26 +778,27 @@ static managerInstance_t *instance_new(char *modelPath)
     instance->status = INSTANCE_INACTIVE;
     instance->gamePID = -1;
     instance->aiPID = -1;
-    instance->scoreUpdateValue = 0;
-    instance->scoreUpdateTime = 0;
+    instance->gameExitStatus = -1;
+    instance->aiExitStatus = -1;
+    instance->gameCpuTime = 0.0;
+    instance->aiCpuTime = 0.0;
+    instance->aiMaxResident = 0;
     instance->modelPath = modelPath;
     instance->generation = 0;
     instance->fitnessScore = 0.0f;
     instance->currSeed = 0;
-
-    // construct shared memory keys
-    int32_t i;
-    for (i = 0; filenameStart[i] != '.'; i++) {
-        instance->shmemInput[i] = filenameStart[i];
-        instance->shmemOutput[i] = filenameStart[i];
-        instance->shmemStatus[i] = filenameStart[i];
-    }
-    instance->shmemInput[i] = 'i';
-    instance->shmemOutput[i] = 'o';
-    instance->shmemStatus[i] = 's';
-    instance->shmemInput[i + 1] = '\0';
-    instance->shmemOutput[i + 1] = '\0';
-    instance->shmemStatus[i + 1] = '\0';
+    instance->seedsScored = 0;
+    instance->fitnessSum = 0.0;
+    instance->fitnessSquares = 0.0;
+    instance->raced = false;
+    instance->seedsCached = 0;
+    instance->genomeHash = 0;
+    instance->inferenceCount = 0;
+    instance->duplicateCount = 0;
+    instance->inferenceRate = 0.0f;
+    instance->forwardP50 = 0;
+    instance->forwardP99 = 0;
+    instance->cycleP99 = 0;
 
     // add instance to loaded instances
     pthread_mutex_lock(&instancerMutex);
@@ -489,82 +835,131 @@ static int instance_compare(const managerInstance_t *a, const managerInstance_t
     return 0;
 }
 
-static int instance_start(uint32_t instanceID)
+static void instance_collectStatistics(managerInstance_t *instance, struct sharedState_s *shStat)
 {
-    // if instanceID is out of bounds or structures are not initialized, return failure
-    if (descriptors == NULL || descriptors->size == 0 || instanceID >= (uint32_t)descriptors->size) {
-        return 1;
+    if (shStat == NULL) {
+        return;
     }
 
-    // get instance descriptor
-    managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, (int)instanceID);
+    sm_lockSharedState(shStat);
+    if (shStat->neurons_inferenceCount > 0) {
+        // rate is averaged over seeds, latencies keep worst seed
+        uint32_t seedsEvaluated = instance->currSeed;
+        instance->inferenceRate = (instance->inferenceRate * (float)seedsEvaluated + shStat->neurons_inferenceRate) /
+                                  (float)(seedsEvaluated + 1);
+        instance->inferenceCount += shStat->neurons_inferenceCount;
+        instance->duplicateCount += shStat->neurons_duplicateCount;
+        if (shStat->neurons_forwardP50 > instance->forwardP50) {
+            instance->forwardP50 = shStat->neurons_forwardP50;
+        }
+        if (shStat->neurons_forwardP99 > instance->forwardP99) {
+            instance->forwardP99 = shStat->neurons_forwardP99;
+        }
+        if (shStat->neurons_cycleP99 > instance->cycleP99) {
+            instance->cycleP99 = shStat->neurons_cycleP99;
+        }
+        shStat->neurons_inferenceCount = 0;  // avoid counting same run twice
+    }
+    sm_unlockSharedState(shStat);
+}
 
-    // if instance is not waiting, return failure
-    if ((instance->status & INSTANCE_WAITING) == 0) {
-        return 1;
+// called after one of tasks of instance ended (evaluated, errored or skipped)
+static void instance_taskEnded(managerInstance_t *instance)
+{
+    bool running = false;
+    bool remaining = false;
+    for (uint32_t i = instance->instanceID * randSeedCount; i < (instance->instanceID + 1) * randSeedCount; i++) {
+        running |= (tasks[i].status & (INSTANCE_RUNNING | INSTANCE_FINISHED | INSTANCE_ERRORED)) != 0;
+        remaining |= (tasks[i].status & (INSTANCE_ENDED | INSTANCE_ERRENDED)) == 0;
     }
 
-    // create and initialize shared memory blocks
-    struct sharedInput_s *shIn = (struct sharedInput_s *)xDictionary_get(shInDict, cu_CStringHash(instance->shmemInput));
-    if (shIn == NULL) {
-        shIn = sm_allocateSharedInput(instance->shmemInput);
-        sm_initSharedInput(shIn);
-        xDictionary_insert(shInDict, cu_CStringHash(instance->shmemInput), shIn);
-    } else {
-        sm_initSharedInput(shIn);
+    if (!remaining) {
+        instance->status = (instance->status & INSTANCE_ERRORED) ? INSTANCE_ERRENDED : INSTANCE_ENDED;
+    } else if (!running && (instance->status & INSTANCE_ERRORED) == 0) {
+        instance->status = INSTANCE_WAITING;
     }
+}
 
-    struct sharedOutput_s *shOut = (struct sharedOutput_s *)xDictionary_get(shOutDict, cu_CStringHash(instance->shmemOutput));
-    if (shOut == NULL) {
-        shOut = sm_allocateSharedOutput(instance->shmemOutput);
-        sm_initSharedOutput(shOut);
-        xDictionary_insert(shOutDict, cu_CStringHash(instance->shmemOutput), shOut);
-    } else {
-        sm_initSharedOutput(shOut);
+static void instance_scoreSeed(managerInstance_t *instance, float seedFitness)
+{
+    instance->fitnessScore += seedFitness / randSeedCount;
+    instance->seedsScored++;
+    instance->fitnessSum += seedFitness;
+    instance->fitnessSquares += (double)seedFitness * seedFitness;
+}
+
+// confidence bounds of mean fitness over all seeds of generation (seeds form finite set, so bounds close as seeds are scored)
+static void instance_bounds(const managerInstance_t *instance, float *lower, float *upper)
+{
+    uint32_t scored = instance->seedsScored;
+    if (scored == 0 || (instance->status & INSTANCE_ERRORED)) {
+        *lower = -INFINITY;
+        *upper = INFINITY;
+        return;
     }
-    struct sharedState_s *shStat = (struct sharedState_s *)xDictionary_get(shStatDict, cu_CStringHash(instance->shmemStatus));
-    if (shStat == NULL) {
-        shStat = sm_allocateSharedState(instance->shmemStatus);
-        sm_initSharedState(shStat);
-        xDictionary_insert(shStatDict, cu_CStringHash(instance->shmemStatus), shStat);
-    } else {
-        sm_initSharedState(shStat);
+    double mean = instance->fitnessSum / scored;
+    double halfWidth = 0.0;
+    if (scored < 2 && scored < randSeedCount) {
+        halfWidth = INFINITY;  // spread of fitness over seeds is unknown yet
+    } else if (scored < randSeedCount) {
+        double variance = (instance->fitnessSquares - instance->fitnessSum * mean) / (scored - 1);
+        variance = (variance > 0.0) ? variance : 0.0;
+        halfWidth = RACING_CONFIDENCE_Z * sqrt(variance / scored * (randSeedCount - scored) / (randSeedCount - 1));
     }
-    shStat->state_managerAlive = true;
-    shStat->game_runHeadless = true;
+    *lower = (float)(mean - halfWidth);
+    *upper = (float)(mean + halfWidth);
+}
 
-    // start game process
-    pid_t gamePID = fork();
-    if (gamePID == 0) {
-        char randSeedStr[16];
-        sprintf(randSeedStr, "%u", randSeed[instance->currSeed]);
-        char *gameArgs[] = {"./bin/game",          "-m", instance->shmemInput, instance->shmemOutput,
-                            instance->shmemStatus, "-r", randSeedStr,          NULL};
-        execv(gameArgs[0], gameArgs);
-    } else if (gamePID < 0) {
-        instance->status = INSTANCE_ERRORED;
-        return 1;
+// cancels remaining seeds of individuals whose upper bound is below lower bounds of at least kept number of individuals
+static void instance_race(void)
+{
+    uint32_t populationSize = (uint32_t)descriptors->size;
+    uint32_t keepCount = (uint32_t)ceilf((float)populationSize * RACING_KEEP_FRACTION);
+    keepCount = (keepCount > elitismCount) ? keepCount : elitismCount;
+    keepCount = (keepCount > 0) ? keepCount : 1;
+    float *lowerBounds = (float *)malloc(populationSize * sizeof(float));
+    if (keepCount >= populationSize || lowerBounds == NULL) {
+        free(lowerBounds);
+        return;
     }
-    instance->gamePID = gamePID;
 
-    // start neurons process
-    pid_t aiPID = fork();
-    if (aiPID == 0) {
-        char *aiArgs[] = {"./bin/neurons",       "-m", instance->shmemInput, instance->shmemOutput,
-                          instance->shmemStatus, "-l", instance->modelPath,  NULL};
-        execv(aiArgs[0], aiArgs);
-    } else if (aiPID < 0) {
-        kill(gamePID, SIGTERM);
-        instance->status = INSTANCE_ERRORED;
-        return 1;
+    // racing cutoff is lower bound of individual ranked at keep count
+    float upper;
+    for (uint32_t i = 0; i < populationSize; i++) {
+        instance_bounds((managerInstance_t *)xArray_get(descriptors, (int)i), &lowerBounds[i], &upper);
+    }
+    qsort(lowerBounds, populationSize, sizeof(float), instance_compareBounds);
+    float cutoff = lowerBounds[keepCount - 1];
+    free(lowerBounds);
+
+    bool cancelled = false;
+    for (uint32_t i = 0; i < populationSize; i++) {
+        managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, (int)i);
+        float lower;
+        if (instance->raced || (instance->status & INSTANCE_ERRORED) || instance->seedsScored < RACING_MIN_SEEDS ||
+            instance->seedsScored >= randSeedCount) {
+            continue;
+        }
+        instance_bounds(instance, &lower, &upper);
+        if (upper < cutoff) {
+            instance->raced = true;
+            instance->fitnessScore = (float)(instance->fitnessSum / instance->seedsScored);
+            cancelled = true;
+        }
     }
-    instance->aiPID = aiPID;
 
-    // update instance status
-    instance->status = INSTANCE_RUNNING;
-    instance->scoreUpdateTime = 5;  // give initial 5 seconds on start to avoid instant autokill
+    // supervisors end running seeds of cancelled individuals without waiting for autokill timer
+    for (uint32_t t = 0; cancelled && t < supervisorCount; t++) {
+        supervisor_wake(&supervisors[t]);
+    }
+}
 
-    return 0;
+// orders bounds from highest to lowest
+static int instance_compareBounds(const void *a, const void *b)
+{
+    float boundA = *(const float *)a;
+    float boundB = *(const float *)b;
+    return (boundA < boundB) - (boundA > boundB);
 }
 
 static void instance_writeReport(const xArray *descriptorArray)
@@ -591,7 +986,9 @@ static void instance_writeReport(const xArray *descriptorArray)
             pthread_mutex_unlock(&instancerMutex);
             return;
         }
-        fprintf(reportFile, "Instance ID,Exit status,Model path,Generation ID,Game seed,Fitness\n");
+        fprintf(reportFile, "Instance ID,Exit status,Model path,Generation ID,Game seed,Fitness,Inferences,Duplicate inferences,"
+                            "Inferences per second,Forward p50 (ns),Forward p99 (ns),Cycle p99 (ns),Game exit code,"
+                            "Neurons exit code,Game CPU (s),Neurons CPU (s),Neurons max RSS (KiB),Scored seeds,Raced,Cached seeds\n");
     }
     fseek(reportFile, 0, SEEK_END);
 
@@ -602,7 +999,10 @@ static void instance_writeReport(const xArray *descriptorArray)
         for (uint32_t j = 0; j < randSeedCount; j++) {
             fprintf(reportFile, "%u%s", randSeed[j], (j < randSeedCount - 1) ? "|" : "");
         }
-        fprintf(reportFile, ",%f\n", instance->fitnessScore);
+        fprintf(reportFile, ",%f,%" PRIu64 ",%" PRIu64 ",%.1f,%u,%u,%u,%d,%d,%.3f,%.3f,%ld,%u,%d,%u\n", instance->fitnessScore,
+                instance->inferenceCount, instance->duplicateCount, instance->inferenceRate, instance->forwardP50, instance->forwardP99,
+                instance->cycleP99, instance->gameExitStatus, instance->aiExitStatus, instance->gameCpuTime, instance->aiCpuTime,
+                instance->aiMaxResident, instance->seedsScored, instance->raced ? 1 : 0, instance->seedsCached);
     }
 
     pthread_mutex_unlock(&instancerMutex);
@@ -617,95 +1017,119 @@ static int instance_nextgen(xArray *descriptorArray)
         return 1;
     }
 
-    // create copy of population directory path
-    char *popDir = NULL;
-    cu_CStringConcat(&popDir, populationDir);
-
-    // create next generation folder
-    char *genDir = (char *)malloc((cu_CStringLength(populationDir) + 15) * sizeof(char));
-    if (genDir == NULL) {
-        return 1;
-    }
-    sprintf(genDir, "%s/gen%u", populationDir, ((managerInstance_t *)xArray_get(descriptorArray, 0))->generation + 1);
-    mkdir(genDir, 0750);
-
     uint32_t generationSizeTarget = (uint32_t)descriptorArray->size;
 
-    // copy over two best model files to next generation (and rename to model_0.fnnm and model_1.fnnm)
+    // next generation is built in new arena from records of current one (no files are read or written)
     pthread_mutex_lock(&instancerMutex);
+    populationArena_t nextArena;
+    uint32_t *parentIDs = (uint32_t *)malloc(2 * generationSizeTarget * sizeof(uint32_t));
+    if (parentIDs == NULL || arena_allocate(&nextArena, arenaLayout, generationSizeTarget, arenaGeneration + 1) != 0) {
+        pthread_mutex_unlock(&instancerMutex);
+        free(parentIDs);
+        return 1;
+    }
 
+    // cumulative selection weights are computed once per generation over population sorted from best to worst (tournament
+    // needs no weights, roulette without positive fitness selects uniformly)
     xArray_sort(descriptorArray, (int (*)(const void *, const void *))instance_compare);
-    for (uint32_t i = 0; i < generationSizeTarget; i++) {
-        // construct destination path of model file
-        char *modelDest = (char *)malloc((cu_CStringLength(genDir) + 23) * sizeof(char));
-        if (modelDest == NULL) {
+    double *cumulative = NULL;
+    if (selectionMethod != SELECTION_TOURNAMENT) {
+        cumulative = (double *)malloc(generationSizeTarget * sizeof(double));
+        if (cumulative == NULL) {
             pthread_mutex_unlock(&instancerMutex);
-            free(genDir);
+            arena_release(&nextArena);
+            free(parentIDs);
             return 1;
         }
-        sprintf(modelDest, "%s/model_%u.fnnm", genDir, i);
-
-        // copy over two best models from previous generation
-        if (i < elitismCount) {
-            char *modelPath = ((managerInstance_t *)xArray_get(descriptorArray, i))->modelPath;
-            fCopy(modelPath, modelDest);
-            free(modelDest);
-            continue;
-        }
-
-        // select two parents based on weighted random selection of fitness scores
-        float fitnessSum = 0.0f;
-        for (uint32_t j = 0; j < generationSizeTarget; j++) {
-            fitnessSum += ((managerInstance_t *)xArray_get(descriptorArray, j))->fitnessScore;
-        }
-        float fitnessRand = (float)rand() / (float)RAND_MAX * fitnessSum;
-        float fitnessAcc = 0.0f;
-        uint32_t parent1 = 0;
-        uint32_t parent2 = 0;
+        double weightSum = 0.0;
         for (uint32_t j = 0; j < generationSizeTarget; j++) {
-            fitnessAcc += ((managerInstance_t *)xArray_get(descriptorArray, j))->fitnessScore;
-            if (fitnessAcc >= fitnessRand) {
-                parent1 = j;
-                break;
-            }
+            float fitness = ((managerInstance_t *)xArray_get(descriptorArray, j))->fitnessScore;
+            weightSum += (selectionMethod == SELECTION_RANK) ? (double)(generationSizeTarget - j) : ((fitness > 0.0f) ? fitness : 0.0);
+            cumulative[j] = weightSum;
         }
-        fitnessRand = (float)rand() / (float)RAND_MAX * fitnessSum;
-        fitnessAcc = 0.0f;
-        for (uint32_t j = 0; j < generationSizeTarget; j++) {
-            fitnessAcc += ((managerInstance_t *)xArray_get(descriptorArray, j))->fitnessScore;
-            if (fitnessAcc >= fitnessRand) {
-                parent2 = j;
-                break;
+        if (weightSum <= 0.0) {
+            for (uint32_t j = 0; j < generationSizeTarget; j++) {
+                cumulative[j] = (double)(j + 1);
             }
         }
+    }
 
-        // breed two parents to create new model
-        FnnModel *model1 = fnn_deserialize(((managerInstance_t *)xArray_get(descriptorArray, parent1))->modelPath);
-        FnnModel *model2 = fnn_deserialize(((managerInstance_t *)xArray_get(descriptorArray, parent2))->modelPath);
-        FnnModel *modelNew = fnn_modelBreed(model1, model2, BREED_CROSSOVER_INDEX, BREED_MUTATION_RATE, BREED_MUTATION_STDDEV);
-        if (modelNew == NULL) {
-            pthread_mutex_unlock(&instancerMutex);
-            free(genDir);
-            free(modelDest);
-            return 1;
-        }
-
-        // serialize new model to file
-        fnn_serialize(modelDest, modelNew);
-        free(modelDest);
-        fnn_free(model1);
-        fnn_free(model2);
-        fnn_free(modelNew);
+    // parents are selected serially (draws of `rand` stay in same order), elites are their own parents
+    for (uint32_t i = 0; i < generationSizeTarget; i++) {
+        uint32_t parent1 = (i < elitismCount) ? i : selection_pick(cumulative, generationSizeTarget);
+        uint32_t parent2 = (i < elitismCount) ? i : selection_pick(cumulative, generationSizeTarget);
+        parentIDs[2 * i] = ((managerInstance_t *)xArray_get(descriptorArray, parent1))->instanceID;
+        parentIDs[2 * i + 1] = ((managerInstance_t *)xArray_get(descriptorArray, parent2))->instanceID;
     }
+    free(cumulative);
+    breedContext_t breed = {&arena, &nextArena, parentIDs, elitismCount, ((uint64_t)rand() << 32) ^ (uint64_t)rand()};
     pthread_mutex_unlock(&instancerMutex);
 
-    // auto-load next generation
-    mInstancer_loadPopulation(popDir);
+    // children are bred on thread pool without holding instancer mutex (arena is changed only by this thread, each child has own
+    // random stream, so next generation does not depend on number of threads)
+    xThreadPool_parallelFor(generationSizeTarget, breed_child, &breed);
+    free(parentIDs);
 
-    free(genDir);
-    free(popDir);
+    // replace current generation by next one
+    pthread_mutex_lock(&instancerMutex);
+    arena_release(&arena);
+    arena = nextArena;
+    arenaCount = generationSizeTarget;
+    arenaGeneration++;
+    arenaDirty = true;
+    pthread_mutex_unlock(&instancerMutex);
 
-    return 0;
+    // descriptors of next generation refer to records by instance ID (generation is on disk only after its checkpoint)
+    return arena_describe(false);
+}
+
+// selects position of parent in population sorted from best to worst (by binary search over cumulative selection weights, or by
+// tournament if there are no weights)
+static uint32_t selection_pick(const double *cumulative, uint32_t count)
+{
+    if (cumulative == NULL) {
+        uint32_t best = count - 1;
+        for (uint32_t k = 0; k < SELECTION_TOURNAMENT_SIZE; k++) {
+            uint32_t drawn = (uint32_t)((double)rand() / ((double)RAND_MAX + 1.0) * count);
+            best = (drawn < best) ? drawn : best;
+        }
+        return best;
+    }
+
+    // first individual whose cumulative weight exceeds drawn value (individuals without weight are never selected)
+    double target = (double)rand() / ((double)RAND_MAX + 1.0) * cumulative[count - 1];
+    uint32_t low = 0, high = count - 1;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (cumulative[middle] > target) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+// copies elite or breeds child record from records of its parents
+static void breed_child(void *context, uint32_t index)
+{
+    const breedContext_t *breed = (const breedContext_t *)context;
+    unsigned char *child = arena_record(breed->children, index);
+    const unsigned char *parent1 = arena_record(breed->parents, breed->parentIDs[2 * index]);
+    const unsigned char *parent2 = arena_record(breed->parents, breed->parentIDs[2 * index + 1]);
+    if (index < breed->eliteCount) {
+        memcpy(child, parent1, arenaStride);
+        return;
+    }
+
+    // header and layer descriptors are same for whole population, weights and biases follow each other and are bred as one array
+    uint64_t valuesOffset = fnn_valuesOffset(FNN_SERIALIZER_VERSION, arenaLayout->layerCount);
+    memcpy(child, parent1, valuesOffset);
+    FnnRandom random;
+    fnn_randomInit(&random, breed->seed, index);
+    fnn_breedValues(&random, (const float *)(parent1 + valuesOffset), (const float *)(parent2 + valuesOffset),
+                    (float *)(child + valuesOffset), arenaLayout->totalWeights + arenaLayout->totalBiases, BREED_CROSSOVER_INDEX,
+                    BREED_MUTATION_RATE, BREED_MUTATION_STDDEV);
 }
 
 static void *thr_instanceStarter(void *arg)
@@ -714,24 +1138,44 @@ static void *thr_instanceStarter(void *arg)
 
     randSeed = (uint32_t *)malloc(randSeedCount * sizeof(uint32_t));
     if (randSeed == NULL) {
+        pthread_mutex_lock(&instancerMutex);
+        instancesRunning = false;
+        pthread_mutex_unlock(&instancerMutex);
         return NULL;
     }
     for (uint32_t i = 0; i < randSeedCount; i++) {
         randSeed[i] = (uint32_t)rand();
     }
     uint32_t nextUpdateSeed = 0;
-    uint32_t parallelMax = maxParallel;
+    uint32_t parallelMax = (maxParallel > 0) ? maxParallel : 1;
     uint32_t iterationMax = maxIterations;
 
+    // without CPU pairs (placement disabled or topology unreadable) processes are scheduled freely
+    placement_build(placementMode);
+
+    // without cache file (disabled or not writable) all seeds are played
+    if (cacheEnabled) {
+        cache_open();
+    }
+
+    // slots are split between supervisor threads (each supervises at least one slot)
+    uint32_t threadCount = (parallelMax < SUPERVISOR_MAX_THREADS) ? parallelMax : SUPERVISOR_MAX_THREADS;
+
+    // adaptive parallelism starts from one instance per two allowed CPUs (game and AI process of instance alternate)
+    parallelControl_t control = {{0, 0}, 0.0f, 0, 0, 1};
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0) {
+        control.cpuCount = (uint32_t)CPU_COUNT(&allowed);
+    }
     pthread_mutex_lock(&instancerMutex);
-    instancesRunning = true;
+    activeSlots = parallelMax;
+    if (adaptiveParallel && control.cpuCount / 2 < parallelMax) {
+        activeSlots = (control.cpuCount > 1) ? control.cpuCount / 2 : 1;
+    }
+    tickRate = 0.0f;
     pthread_mutex_unlock(&instancerMutex);
 
     for (uint32_t iteration = 0; iteration < iterationMax; iteration++) {
-        uint32_t nextStarting = 0;
-        uint32_t runningInstances = 0;
-        bool allEnded = false;
-
         if (epochIterations > 0 && iteration % epochIterations == 0) {
             srand((unsigned int)time(NULL) ^ (unsigned int)rand());
             for (uint32_t i = 0; i < randSeedCount; i++) {
@@ -739,156 +1183,1306 @@ static void *thr_instanceStarter(void *arg)
             }
         }
 
-        // set all loaded instances to waiting state
+        // flatten generation into (individual, seed) tasks
         pthread_mutex_lock(&instancerMutex);
+        uint32_t generationTasks = (uint32_t)descriptors->size * randSeedCount;
+        managerTask_t *taskArray = (managerTask_t *)realloc(tasks, generationTasks * sizeof(managerTask_t));
+        supervisor_t *supervisorArray = (supervisor_t *)calloc(threadCount, sizeof(supervisor_t));
+        if (taskArray == NULL || supervisorArray == NULL || stopRequested) {
+            free(supervisorArray);
+            pthread_mutex_unlock(&instancerMutex);
+            break;
+        }
+        tasks = taskArray;
+        taskCount = generationTasks;
         for (int i = 0; i < descriptors->size; i++) {
             managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, i);
             instance->status = INSTANCE_WAITING;
         }
-        pthread_mutex_unlock(&instancerMutex);
-
-        // start instances and wait for them to finish
-        while (!allEnded) {
-            allEnded = true;
-            pthread_mutex_lock(&instancerMutex);
+        for (uint32_t i = 0; i < taskCount; i++) {
+            tasks[i] = (managerTask_t){i / randSeedCount, i % randSeedCount, INSTANCE_WAITING, 0, -1, -1, -1, -1, 0, 0, 0};
+        }
 
-            // start next instance if possible
-            for (uint32_t i = nextStarting; runningInstances < parallelMax && i < (uint32_t)descriptors->size; i++) {
-                managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, i);
-                if (instance->status & INSTANCE_WAITING) {
-                    if (instance_start(instance->instanceID) == 0) {
-                        runningInstances++;
-                    } else {
-                        nextStarting = i;
-                        break;
-                    }
+        // seeds already played by same genome are scored from cache (elites and duplicated children skip most of their seeds)
+        cacheHits = 0;
+        cacheLookups = 0;
+        for (int i = 0; cacheFile != NULL && i < descriptors->size; i++) {
+            managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, i);
+            instance->genomeHash = cache_genomeHash(instance->instanceID);
+            for (uint32_t s = 0; s < randSeedCount; s++) {
+                float seedFitness;
+                cacheLookups++;
+                if (instance->genomeHash == 0 || cache_lookup(instance->genomeHash, randSeed[s], &seedFitness) != 0) {
+                    continue;
                 }
+                cacheHits++;
+                instance_scoreSeed(instance, seedFitness);
+                instance->seedsCached++;
+                instance->currSeed++;
+                tasks[(uint32_t)i * randSeedCount + s].status = INSTANCE_ENDED;
             }
-            nextStarting %= (uint32_t)descriptors->size;
-
-            // update descriptors of finished, errored and running instances
-            for (int i = 0; i < descriptors->size; i++) {
-                managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, i);
-                if ((instance->status & (INSTANCE_ENDED | INSTANCE_ERRENDED)) == 0) {
-                    allEnded = false;
-                }
-                if (instance->status & INSTANCE_RUNNING) {
-                    allEnded = false;
-
-                    if (kill(instance->gamePID, 0) == -1 || kill(instance->aiPID, 0) == -1) {
-                        instance->status = INSTANCE_ERRORED;
-                        kill(instance->gamePID, SIGTERM);
-                        kill(instance->aiPID, SIGTERM);
-                        waitpid(instance->gamePID, NULL, 0);
-                        waitpid(instance->aiPID, NULL, 0);
-                        runningInstances--;
-                    } else {
-                        struct sharedState_s *shStat =
-                            (struct sharedState_s *)xDictionary_get(shStatDict, cu_CStringHash(instance->shmemStatus));
-                        sm_lockSharedState(shStat);
-                        if (shStat->game_isOver) {
-                            // game ended, evaluate instance and end processes
-                            instance->status = INSTANCE_FINISHED;
-                            instance->fitnessScore +=
-                                (shStat->game_gameScore * FITNESS_WEIGHT_SCORE + shStat->game_gameTime * FITNESS_WEIGHT_TIME +
-                                 shStat->game_gameLevel * FITNESS_WEIGHT_LEVEL) /
-                                randSeedCount;
-                            shStat->control_gameExit = true;
-                            shStat->control_neuronsExit = true;
-                        } else {
-                            if (instance->scoreUpdateValue != shStat->game_gameScore) {
-                                // autokill mechanism (score changed, reset kill timer)
-                                instance->scoreUpdateValue = shStat->game_gameScore;
-                                instance->scoreUpdateTime = shStat->game_gameTime;
-                            } else if (shStat->game_gameTime - instance->scoreUpdateTime > AUTOKILL_TIMEOUT) {
-                                // autokill mechanism (if score doesn't progress for set amount of time, kill the instance)
-                                instance->status = INSTANCE_ERRORED;
-                                shStat->control_gameExit = true;
-                                shStat->control_neuronsExit = true;
-                                instance->fitnessScore = 0.0f;  // reset fitness to remove this instance fully
-                            }
-                        }
-                        sm_unlockSharedState(shStat);
-                    }
-                }
-                if (instance->status & (INSTANCE_FINISHED | INSTANCE_ERRORED)) {
-                    // wait for game and AI processes to exit
-                    waitpid(instance->gamePID, NULL, 0);
-                    waitpid(instance->aiPID, NULL, 0);
-
-                    instance->gamePID = -1;
-                    instance->aiPID = -1;
-
-                    // update instance status
-                    instance->currSeed = instance->currSeed + 1;
-                    if (instance->status & INSTANCE_ERRORED) {
-                        instance->status = INSTANCE_ERRENDED;
-                    } else {
-                        if (instance->currSeed >= randSeedCount) {
-                            instance->status = INSTANCE_ENDED;
-                        } else {
-                            instance->status = INSTANCE_WAITING;
-                        }
-                    }
+            if (instance->seedsCached > 0) {
+                instance_taskEnded(instance);
+            }
+        }
+        if (racingEnabled && cacheHits > 0) {
+            instance_race();
+        }
 
-                    runningInstances--;
-                }
+        // seeds of one individual are dealt to different supervisors so that they run concurrently (racing deals first seed of
+        // all individuals first, so that every individual has early estimate of fitness)
+        supervisors = supervisorArray;
+        supervisorCount = 0;
+        for (uint32_t t = 0; t < threadCount; t++) {
+            uint32_t slotFirst = parallelMax * t / threadCount;
+            if (supervisor_open(&supervisors[t], slotFirst, parallelMax * (t + 1) / threadCount - slotFirst) != 0) {
+                break;
+            }
+            supervisorCount++;
+        }
+        for (uint32_t i = 0, dealt = 0; supervisorCount > 0 && i < taskCount; i++) {
+            uint32_t populationSize = (uint32_t)descriptors->size;
+            uint32_t taskIndex = racingEnabled ? (i % populationSize) * randSeedCount + i / populationSize : i;
+            if (tasks[taskIndex].status != INSTANCE_WAITING) {
+                continue;  // scored from cache
             }
+            taskDeque_t *deque = &supervisors[dealt++ % supervisorCount].deque;
+            deque->items[deque->tail++] = taskIndex;
+        }
+        supervisorsRunning = supervisorCount;
+        tickCount = 0;
+        clock_gettime(CLOCK_MONOTONIC, &control.sampleTime);
+        pthread_mutex_unlock(&instancerMutex);
 
-            pthread_mutex_unlock(&instancerMutex);
+        // supervisors end when no task is left to take or steal, tick rate is measured (and parallelism adjusted) meanwhile
+        for (uint32_t t = 0; t < supervisorCount; t++) {
+            pthread_create(&supervisors[t].thread, NULL, thr_supervisor, &supervisors[t]);
+        }
+        pthread_mutex_lock(&instancerMutex);
+        while (supervisorsRunning > 0) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += PARALLEL_CONTROL_PERIOD;
+            if (pthread_cond_timedwait(&supervisorEnded, &instancerMutex, &deadline) == ETIMEDOUT) {
+                parallel_control(&control, parallelMax);
+            }
+        }
+        pthread_mutex_unlock(&instancerMutex);
+        for (uint32_t t = 0; t < supervisorCount; t++) {
+            pthread_join(supervisors[t].thread, NULL);
+        }
 
-            // write report and create next generation (if needed) if all instances ended
-            if (allEnded) {
-                instance_writeReport(descriptors);
+        pthread_mutex_lock(&instancerMutex);
+        bool generationEvaluated = (supervisorCount > 0 && !stopRequested);
+        if (cacheFile != NULL) {
+            fflush(cacheFile);
+        }
+        for (uint32_t t = 0; t < supervisorCount; t++) {
+            supervisor_close(&supervisors[t]);
+        }
+        free(supervisors);
+        supervisors = NULL;
+        supervisorCount = 0;
+        pthread_mutex_unlock(&instancerMutex);
+        if (!generationEvaluated) {
+            break;
+        }
 
-                if (instance_nextgen(descriptors) != 0) {
-                    break;
-                }
+        // checkpoint evaluated generation (together with its fitness), write report and create next generation (report
+        // refers to checkpoint file only if generation was written)
+        if (checkpointInterval > 0 && arenaGeneration % checkpointInterval == 0) {
+            arena_checkpoint();
+        }
+        instance_writeReport(descriptors);
 
-                if (epochIterations == 0) {
-                    randSeed[nextUpdateSeed] = (uint32_t)rand();
-                    nextUpdateSeed = (nextUpdateSeed + 1) % randSeedCount;
-                }
-            }
+        if (instance_nextgen(descriptors) != 0) {
+            break;
+        }
 
-            sleep(1);
+        if (epochIterations == 0) {
+            randSeed[nextUpdateSeed] = (uint32_t)rand();
+            nextUpdateSeed = (nextUpdateSeed + 1) % randSeedCount;
         }
     }
 
+    // generation bred since last checkpoint is written when run ends (or is stopped)
+    if (arenaDirty) {
+        arena_checkpoint();
+    }
+
     pthread_mutex_lock(&instancerMutex);
+    placement_free();
+    cache_close();
     instancesRunning = false;
     pthread_mutex_unlock(&instancerMutex);
 
     return NULL;
 }
 
-static int fCopy(const char *src, const char *dest)
+static void *thr_supervisor(void *arg)
 {
-    int in, out;
-    char buffer[4096];
-    ssize_t nread;
+    supervisor_t *supervisor = (supervisor_t *)arg;
+    int32_t *taken = (int32_t *)malloc(supervisor->slotCount * sizeof(int32_t));
 
-    in = open(src, O_RDONLY);
-    if (in == -1) {
-        return 1;
-    }
-
-    out = open(dest, O_WRONLY | O_CREAT | O_TRUNC, 0644);
-    if (out == -1) {
-        close(in);
-        return 1;
-    }
+    while (taken != NULL) {
+        // update running tasks and release slots of ended ones
+        pthread_mutex_lock(&instancerMutex);
+        bool stopping = stopRequested;
+        for (uint32_t k = 0; k < supervisor->slotCount; k++) {
+            if (supervisor->slotTasks[k] >= 0 && task_update((uint32_t)supervisor->slotTasks[k], stopping)) {
+                supervisor->slotTasks[k] = -1;
+                supervisor->running--;
+            }
+        }
 
-    while ((nread = read(in, buffer, sizeof(buffer))) > 0) {
-        if (write(out, buffer, nread) != nread) {
-            close(in);
-            close(out);
+        // only slots below active limit take new tasks (tasks in other slots finish after parallelism shrinks)
+        uint32_t usableSlots = (activeSlots > supervisor->slotFirst) ? activeSlots - supervisor->slotFirst : 0;
+        usableSlots = (usableSlots < supervisor->slotCount) ? usableSlots : supervisor->slotCount;
+        uint32_t freeSlots = 0;
+        for (uint32_t k = 0; k < usableSlots; k++) {
+            freeSlots += (supervisor->slotTasks[k] < 0) ? 1 : 0;
+        }
+        pthread_mutex_unlock(&instancerMutex);
+
+        // take tasks for free slots (from own deque first, then stolen from other supervisors)
+        uint32_t takenCount = 0;
+        while (!stopping && takenCount < freeSlots) {
+            int32_t taskIndex = supervisor_take(supervisor);
+            if (taskIndex < 0) {
+                break;
+            }
+            taken[takenCount++] = taskIndex;
+        }
+        if (supervisor->running == 0 && takenCount == 0 && (stopping || freeSlots > 0 || supervisor_pending() == 0)) {
+            break;
+        }
+
+        // start taken tasks in free slots (pass is repeated without waiting if task was skipped or failed to start)
+        bool repeatPass = false;
+        uint32_t slot = 0;
+        pthread_mutex_lock(&instancerMutex);
+        for (uint32_t t = 0; t < takenCount; t++) {
+            managerTask_t *task = &tasks[taken[t]];
+            managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, (int)task->instanceID);
+            if (instance->raced) {
+                // racing cancelled remaining seeds of individual
+                task->status = INSTANCE_ENDED;
+                instance_taskEnded(instance);
+                repeatPass = true;
+                continue;
+            } else if (instance->status & INSTANCE_ERRORED) {
+                // other seed of individual already failed
+                task->status = INSTANCE_ERRENDED;
+                instance_taskEnded(instance);
+                repeatPass = true;
+                continue;
+            }
+
+            while (supervisor->slotTasks[slot] >= 0) {
+                slot++;
+            }
+            if (task_start(supervisor, supervisor->slotFirst + slot, (uint32_t)taken[t]) != 0) {
+                repeatPass = true;
+            }
+            supervisor->slotTasks[slot] = taken[t];
+            supervisor->running++;
+        }
+        pthread_mutex_unlock(&instancerMutex);
+        supervisor_drain(supervisor, false);
+
+        // sleep until game ends, process exits, autokill timer expires or parallelism grows
+        if (!repeatPass) {
+            supervisor_wait(supervisor);
+        }
+    }
+    supervisor_drain(supervisor, true);
+
+    pthread_mutex_lock(&instancerMutex);
+    supervisorsRunning--;
+    pthread_cond_signal(&supervisorEnded);
+    pthread_mutex_unlock(&instancerMutex);
+
+    free(taken);
+    return NULL;
+}
+
+static int supervisor_open(supervisor_t *supervisor, uint32_t slotFirst, uint32_t slotCount)
+{
+    supervisor->epoll = epoll_create1(EPOLL_CLOEXEC);
+    supervisor->completionEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    supervisor->autokillTimer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    supervisor->slotFirst = slotFirst;
+    supervisor->slotCount = slotCount;
+    supervisor->slotTasks = (int32_t *)malloc(slotCount * sizeof(int32_t));
+    supervisor->running = 0;
+    supervisor->unreaped = NULL;
+    supervisor->unreapedCount = 0;
+    supervisor->deque.items = (uint32_t *)malloc(taskCount * sizeof(uint32_t));
+    supervisor->deque.head = 0;
+    supervisor->deque.tail = 0;
+    pthread_mutex_init(&supervisor->deque.mutex, NULL);
+    if (supervisor->epoll == -1 || supervisor->completionEvent == -1 || supervisor->autokillTimer == -1 ||
+        supervisor->slotTasks == NULL || supervisor->deque.items == NULL) {
+        supervisor_close(supervisor);
+        return 1;
+    }
+    for (uint32_t k = 0; k < slotCount; k++) {
+        supervisor->slotTasks[k] = -1;
+    }
+
+    struct itimerspec period = {{SUPERVISOR_TIMER_PERIOD, 0}, {SUPERVISOR_TIMER_PERIOD, 0}};
+    struct epoll_event completionWatch = {.events = EPOLLIN, .data.u64 = SUPERVISOR_EVENT_COMPLETION};
+    struct epoll_event timerWatch = {.events = EPOLLIN, .data.u64 = SUPERVISOR_EVENT_TIMER};
+    if (timerfd_settime(supervisor->autokillTimer, 0, &period, NULL) == -1 ||
+        epoll_ctl(supervisor->epoll, EPOLL_CTL_ADD, supervisor->completionEvent, &completionWatch) == -1 ||
+        epoll_ctl(supervisor->epoll, EPOLL_CTL_ADD, supervisor->autokillTimer, &timerWatch) == -1) {
+        supervisor_close(supervisor);
+        return 1;
+    }
+    return 0;
+}
+
+static void supervisor_close(supervisor_t *supervisor)
+{
+    if (supervisor->autokillTimer != -1) {
+        close(supervisor->autokillTimer);
+        supervisor->autokillTimer = -1;
+    }
+    if (supervisor->completionEvent != -1) {
+        close(supervisor->completionEvent);
+        supervisor->completionEvent = -1;
+    }
+    if (supervisor->epoll != -1) {
+        close(supervisor->epoll);
+        supervisor->epoll = -1;
+    }
+    free(supervisor->slotTasks);
+    supervisor->slotTasks = NULL;
+    free(supervisor->deque.items);
+    supervisor->deque.items = NULL;
+    free(supervisor->unreaped);
+    supervisor->unreaped = NULL;
+    supervisor->unreapedCount = 0;
+    pthread_mutex_destroy(&supervisor->deque.mutex);
+}
+
+// own tasks are taken in generation order, other supervisors are robbed from tail of their deques
+static int32_t supervisor_take(supervisor_t *supervisor)
+{
+    uint32_t own = (uint32_t)(supervisor - supervisors);
+    for (uint32_t k = 0; k < supervisorCount; k++) {
+        taskDeque_t *deque = &supervisors[(own + k) % supervisorCount].deque;
+        int32_t taskIndex = -1;
+
+        pthread_mutex_lock(&deque->mutex);
+        if (deque->head < deque->tail) {
+            taskIndex = (int32_t)((k == 0) ? deque->items[deque->head++] : deque->items[--deque->tail]);
+        }
+        pthread_mutex_unlock(&deque->mutex);
+
+        if (taskIndex >= 0) {
+            return taskIndex;
+        }
+    }
+    return -1;
+}
+
+// number of tasks not taken by any supervisor yet
+static uint32_t supervisor_pending(void)
+{
+    uint32_t pending = 0;
+    for (uint32_t t = 0; t < supervisorCount; t++) {
+        pthread_mutex_lock(&supervisors[t].deque.mutex);
+        pending += supervisors[t].deque.tail - supervisors[t].deque.head;
+        pthread_mutex_unlock(&supervisors[t].deque.mutex);
+    }
+    return pending;
+}
+
+// wakes up supervisor through its completion event (supervisor re-evaluates its slots)
+static void supervisor_wake(supervisor_t *supervisor)
+{
+    uint64_t increment = 1;
+    if (write(supervisor->completionEvent, &increment, sizeof(increment)) != sizeof(increment)) {
+        return;
+    }
+}
+
+// registers process descriptor of child in event loop, returns 1 if child could not be watched and was killed (its
+// unwatched descriptor is reaped by update pass of task, child without descriptor is left to supervisor_drain)
+static int supervisor_watch(supervisor_t *supervisor, pid_t pid, uint32_t taskIndex, int *pidfd)
+{
+    *pidfd = pidfdOpen(pid);
+    if (*pidfd == -1) {
+        kill(pid, SIGKILL);
+        pid_t *unreaped = (pid_t *)realloc(supervisor->unreaped, (supervisor->unreapedCount + 1) * sizeof(pid_t));
+        if (unreaped != NULL) {
+            supervisor->unreaped = unreaped;
+            supervisor->unreaped[supervisor->unreapedCount++] = pid;
+        }
+        return 1;
+    }
+
+    struct epoll_event watch = {.events = EPOLLIN, .data.u64 = ((uint64_t)taskIndex << 32) | (uint32_t)*pidfd};
+    if (epoll_ctl(supervisor->epoll, EPOLL_CTL_ADD, *pidfd, &watch) == -1) {
+        syscall(SYS_pidfd_send_signal, *pidfd, SIGKILL, NULL, 0);
+        return 1;
+    }
+    return 0;
+}
+
+// reaps killed children which had no process descriptor (called without mutex, blocks only when supervisor ends)
+static void supervisor_drain(supervisor_t *supervisor, bool blocking)
+{
+    uint32_t kept = 0;
+    for (uint32_t k = 0; k < supervisor->unreapedCount; k++) {
+        if (waitpid(supervisor->unreaped[k], NULL, blocking ? 0 : WNOHANG) == 0) {
+            supervisor->unreaped[kept++] = supervisor->unreaped[k];
+        }
+    }
+    supervisor->unreapedCount = kept;
+}
+
+// returns 0 if child was reaped (never blocks)
+static int supervisor_reap(int pidfd, childExit_t *childExit)
+{
+    siginfo_t info = {0};
+    struct rusage usage = {0};
+
+    // waitid of C library does not report resource usage of child
+    if (syscall(SYS_waitid, P_PIDFD, pidfd, &info, WEXITED | WNOHANG, &usage) == -1 || info.si_pid == 0) {
+        return 1;
+    }
+    childExit->exitStatus = (info.si_code == CLD_EXITED) ? info.si_status : 128 + info.si_status;
+    childExit->cpuTime = (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                         (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+    childExit->maxResident = usage.ru_maxrss;
+    return 0;
+}
+
+static void supervisor_wait(supervisor_t *supervisor)
+{
+    struct epoll_event events[SUPERVISOR_MAX_EVENTS];
+    int eventCount = epoll_wait(supervisor->epoll, events, SUPERVISOR_MAX_EVENTS, -1);
+
+    for (int i = 0; i < eventCount; i++) {
+        uint64_t counter;
+        if (events[i].data.u64 == SUPERVISOR_EVENT_COMPLETION) {
+            // games publish final state before signaling, it is evaluated by following pass
+            if (read(supervisor->completionEvent, &counter, sizeof(counter)) != sizeof(counter)) {
+                continue;
+            }
+        } else if (events[i].data.u64 == SUPERVISOR_EVENT_TIMER) {
+            if (read(supervisor->autokillTimer, &counter, sizeof(counter)) != sizeof(counter)) {
+                continue;
+            }
+        } else {
+            // child is reaped before locking, only descriptors are updated under mutex
+            int pidfd = (int)(uint32_t)events[i].data.u64;
+            managerTask_t *task = &tasks[events[i].data.u64 >> 32];
+            childExit_t childExit;
+            if (supervisor_reap(pidfd, &childExit) != 0) {
+                continue;
+            }
+
+            pthread_mutex_lock(&instancerMutex);
+            task_childExited(task, pidfd, &childExit);
+            if (task->status & INSTANCE_RUNNING) {
+                // game or neural network process exited before game was over
+                task->status = INSTANCE_ERRORED;
+                task_signal(task, SIGTERM);
+            }
+            pthread_mutex_unlock(&instancerMutex);
+        }
+    }
+}
+
+static int task_start(supervisor_t *supervisor, uint32_t slot, uint32_t taskIndex)
+{
+    managerTask_t *task = &tasks[taskIndex];
+    managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, (int)task->instanceID);
+    task->slot = slot;
+    task->status = INSTANCE_ERRORED;  // until both processes are started
+
+    // create (on first use of slot) and initialize shared memory blocks
+    char shmemInput[32], shmemOutput[32], shmemStatus[32];
+    slot_name(shmemInput, slot, 'i');
+    slot_name(shmemOutput, slot, 'o');
+    slot_name(shmemStatus, slot, 's');
+    struct sharedInput_s *shIn = (struct sharedInput_s *)xDictionary_get(shInDict, cu_CStringHash(shmemInput));
+    struct sharedOutput_s *shOut = (struct sharedOutput_s *)xDictionary_get(shOutDict, cu_CStringHash(shmemOutput));
+    struct sharedState_s *shStat = (struct sharedState_s *)xDictionary_get(shStatDict, cu_CStringHash(shmemStatus));
+
+    // new blocks are first touched by supervisor running on NUMA node of slot, so their pages are placed there
+    const cpuPair_t *pair = (cpuPairs != NULL) ? &cpuPairs[slot % cpuPairCount] : NULL;
+    cpu_set_t supervisorCPUs;
+    bool firstTouch = (pair != NULL && (shIn == NULL || shOut == NULL || shStat == NULL) &&
+                       pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &supervisorCPUs) == 0 &&
+                       pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &nodeCPUs[pair->node]) == 0);
+
+    if (shIn == NULL && (shIn = sm_allocateSharedInput(shmemInput)) != NULL) {
+        xDictionary_insert(shInDict, cu_CStringHash(shmemInput), shIn);
+    }
+    if (shOut == NULL && (shOut = sm_allocateSharedOutput(shmemOutput)) != NULL) {
+        xDictionary_insert(shOutDict, cu_CStringHash(shmemOutput), shOut);
+    }
+    if (shStat == NULL && (shStat = sm_allocateSharedState(shmemStatus)) != NULL) {
+        xDictionary_insert(shStatDict, cu_CStringHash(shmemStatus), shStat);
+    }
+    slotsAllocated = (slot >= slotsAllocated) ? slot + 1 : slotsAllocated;
+    if (shIn != NULL && shOut != NULL && shStat != NULL) {
+        sm_initSharedInput(shIn);
+        sm_initSharedOutput(shOut);
+        sm_initSharedState(shStat);
+    }
+    if (firstTouch) {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &supervisorCPUs);
+    }
+    if (shIn == NULL || shOut == NULL || shStat == NULL) {
+        return 1;
+    }
+    shStat->state_managerAlive = true;
+    shStat->game_runHeadless = true;
+
+    // CPUs of processes are set by children before executing programs
+    cpu_set_t gameCPUs, aiCPUs;
+    CPU_ZERO(&gameCPUs);
+    CPU_ZERO(&aiCPUs);
+    if (pair != NULL) {
+        CPU_SET(pair->gameCPU, &gameCPUs);
+        CPU_SET(pair->aiCPU, &aiCPUs);
+    }
+
+    // start game process
+    pid_t gamePID = fork();
+    if (gamePID == 0) {
+        char randSeedStr[16];
+        char completionStr[16];
+        sprintf(randSeedStr, "%u", randSeed[task->seedIndex]);
+        sprintf(completionStr, "%d", supervisor->completionEvent);
+        fcntl(supervisor->completionEvent, F_SETFD, 0);  // only game process inherits completion event
+        if (pair != NULL) {
+            sched_setaffinity(0, sizeof(cpu_set_t), &gameCPUs);
+        }
+        char *gameArgs[] = {"./bin/game", "-m", shmemInput, shmemOutput, shmemStatus, "-r", randSeedStr, "-e", completionStr, NULL};
+        execv(gameArgs[0], gameArgs);
+        _exit(1);
+    } else if (gamePID < 0) {
+        return 1;
+    }
+
+    // exit of game process wakes up supervisor
+    task->gamePID = gamePID;
+    if (supervisor_watch(supervisor, gamePID, taskIndex, &task->gamePidfd) != 0) {
+        return 1;
+    }
+
+    // start neurons process (deterministic kernels so that fitness of model does not depend on CPU of host)
+    pid_t aiPID = fork();
+    if (aiPID == 0) {
+        if (pair != NULL) {
+            sched_setaffinity(0, sizeof(cpu_set_t), &aiCPUs);
+        }
+
+        // genome is mapped by its index from population memory file (population is on disk only at checkpoints)
+        char populationStr[32];
+        char genomeStr[16];
+        fcntl(arena.fd, F_SETFD, 0);  // only AI process inherits population memory file
+        sprintf(populationStr, "/proc/self/fd/%d", arena.fd);
+        sprintf(genomeStr, "%u", task->instanceID);
+        char *precisionName = (activationPrecision == PRECISION_FAST) ? "fast" : "exact";
+        char *aiArgs[] = {"./bin/neurons", "-m", shmemInput, shmemOutput, shmemStatus, "-l", populationStr, "-g", genomeStr, "-D",
+                          "-p", precisionName, NULL};
+        execv(aiArgs[0], aiArgs);
+        _exit(1);
+    } else if (aiPID < 0) {
+        task_signal(task, SIGTERM);
+        return 1;
+    }
+
+    // exit of AI process wakes up supervisor
+    task->aiPID = aiPID;
+    if (supervisor_watch(supervisor, aiPID, taskIndex, &task->aiPidfd) != 0) {
+        task_signal(task, SIGTERM);
+        return 1;
+    }
+
+    // update task and instance status
+    task->status = INSTANCE_RUNNING;
+    task->scoreUpdateValue = 0;
+    task->scoreUpdateTime = 5;  // give initial 5 seconds on start to avoid instant autokill
+    instance->status = INSTANCE_RUNNING;
+    instance->gamePID = gamePID;
+    instance->aiPID = aiPID;
+
+    return 0;
+}
+
+// returns 1 if task ended and released its slot
+static int task_update(uint32_t taskIndex, bool stopping)
+{
+    managerTask_t *task = &tasks[taskIndex];
+    managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, (int)task->instanceID);
+    struct sharedState_s *shStat = slot_state(task->slot);
+
+    bool raceNeeded = false;
+    if (task->status & INSTANCE_RUNNING) {
+        task_countTicks(task);
+        sm_lockSharedState(shStat);
+        if (stopping) {
+            // population is stopped, end processes without evaluating seed
+            task->status = INSTANCE_ERRORED;
+            shStat->control_gameExit = true;
+            shStat->control_neuronsExit = true;
+        } else if (instance->raced) {
+            // racing cancelled remaining seeds of individual, end processes without evaluating seed
+            task->status = INSTANCE_FINISHED;
+            shStat->control_gameExit = true;
+            shStat->control_neuronsExit = true;
+        } else if (shStat->game_isOver) {
+            // game ended, evaluate seed and end processes (seeds finishing after failure of other seed are not counted)
+            task->status = INSTANCE_FINISHED;
+            if ((instance->status & INSTANCE_ERRORED) == 0) {
+                float seedFitness = shStat->game_gameScore * FITNESS_WEIGHT_SCORE + shStat->game_gameTime * FITNESS_WEIGHT_TIME +
+                                    shStat->game_gameLevel * FITNESS_WEIGHT_LEVEL;
+                instance_scoreSeed(instance, seedFitness);
+                if (cacheFile != NULL) {
+                    cache_store(instance->genomeHash, randSeed[task->seedIndex], seedFitness);
+                }
+                raceNeeded = racingEnabled;
+            }
+            shStat->control_gameExit = true;
+            shStat->control_neuronsExit = true;
+        } else {
+            if (task->scoreUpdateValue != shStat->game_gameScore) {
+                // autokill mechanism (score changed, reset kill timer)
+                task->scoreUpdateValue = shStat->game_gameScore;
+                task->scoreUpdateTime = shStat->game_gameTime;
+            } else if (shStat->game_gameTime - task->scoreUpdateTime > AUTOKILL_TIMEOUT) {
+                // autokill mechanism (if score doesn't progress for set amount of time, kill the instance)
+                task->status = INSTANCE_ERRORED;
+                shStat->control_gameExit = true;
+                shStat->control_neuronsExit = true;
+                instance->status = INSTANCE_ERRORED;
+                instance->fitnessScore = 0.0f;  // reset fitness to remove this instance fully
+            }
+        }
+        sm_unlockSharedState(shStat);
+    }
+    if (raceNeeded) {
+        instance_race();
+    }
+
+    // children of task which failed to start may not be watched by event loop, their exit is polled here
+    if (task->status & (INSTANCE_FINISHED | INSTANCE_ERRORED)) {
+        childExit_t childExit;
+        if (task->gamePidfd != -1 && supervisor_reap(task->gamePidfd, &childExit) == 0) {
+            task_childExited(task, task->gamePidfd, &childExit);
+        }
+        if (task->aiPidfd != -1 && supervisor_reap(task->aiPidfd, &childExit) == 0) {
+            task_childExited(task, task->aiPidfd, &childExit);
+        }
+    }
+
+    // slot is released after game and AI processes were reaped (or were not started if task errored on start)
+    if ((task->status & (INSTANCE_FINISHED | INSTANCE_ERRORED)) == 0 || task->gamePidfd != -1 || task->aiPidfd != -1) {
+        return 0;
+    }
+
+    // neural network program publishes final inference statistics before exiting
+    instance_collectStatistics(instance, shStat);
+
+    instance->currSeed = instance->currSeed + 1;
+    if (task->status & INSTANCE_ERRORED) {
+        task->status = INSTANCE_ERRENDED;
+        instance->status = INSTANCE_ERRORED;
+    } else {
+        task->status = INSTANCE_ENDED;
+    }
+    instance_taskEnded(instance);
+
+    return 1;
+}
+
+static void task_childExited(managerTask_t *task, int pidfd, const childExit_t *childExit)
+{
+    managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, (int)task->instanceID);
+    if (pidfd == task->gamePidfd) {
+        instance->gamePID = (instance->gamePID == task->gamePID) ? -1 : instance->gamePID;
+        instance->gameExitStatus = childExit->exitStatus;
+        instance->gameCpuTime += childExit->cpuTime;
+        task->gamePID = -1;
+        task->gamePidfd = -1;
+    } else if (pidfd == task->aiPidfd) {
+        instance->aiPID = (instance->aiPID == task->aiPID) ? -1 : instance->aiPID;
+        instance->aiExitStatus = childExit->exitStatus;
+        instance->aiCpuTime += childExit->cpuTime;
+        if (childExit->maxResident > instance->aiMaxResident) {
+            instance->aiMaxResident = childExit->maxResident;
+        }
+        task->aiPID = -1;
+        task->aiPidfd = -1;
+    } else {
+        return;
+    }
+
+    // closing descriptor also removes it from event loop
+    close(pidfd);
+}
+
+// signal is sent through process descriptors (never to reused process ID of already reaped child)
+static void task_signal(const managerTask_t *task, int signal)
+{
+    if (task->gamePidfd != -1) {
+        syscall(SYS_pidfd_send_signal, task->gamePidfd, signal, NULL, 0);
+    }
+    if (task->aiPidfd != -1) {
+        syscall(SYS_pidfd_send_signal, task->aiPidfd, signal, NULL, 0);
+    }
+}
+
+// adds game ticks published since last count to tick counter of measurement period
+static void task_countTicks(managerTask_t *task)
+{
+    struct sharedOutput_s *shOut = slot_output(task->slot);
+    if (shOut == NULL) {
+        return;
+    }
+    uint32_t sequence = __atomic_load_n(&shOut->sequence, __ATOMIC_ACQUIRE);
+    tickCount += (uint32_t)(sequence - task->tickSeen);
+    task->tickSeen = sequence;
+}
+
+// measures tick rate and (if adaptive) steps active slots towards higher rate, called with instancer mutex locked
+static void parallel_control(parallelControl_t *control, uint32_t parallelMax)
+{
+    uint32_t running = 0;
+    for (uint32_t t = 0; t < supervisorCount; t++) {
+        for (uint32_t k = 0; k < supervisors[t].slotCount; k++) {
+            int32_t taskIndex = supervisors[t].slotTasks[k];
+            if (taskIndex >= 0 && (tasks[taskIndex].status & INSTANCE_RUNNING)) {
+                task_countTicks(&tasks[taskIndex]);
+                running++;
+            }
+        }
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double period = (double)(now.tv_sec - control->sampleTime.tv_sec) + (double)(now.tv_nsec - control->sampleTime.tv_nsec) * 1e-9;
+    tickRate = (period > 0.0) ? (float)((double)tickCount / period) : 0.0f;
+    tickCount = 0;
+    control->sampleTime = now;
+
+    // rate drops at end of generation when queue runs dry, such periods say nothing about parallelism
+    if (!adaptiveParallel || running == 0 || supervisor_pending() == 0) {
+        return;
+    }
+
+    // host is oversubscribed (by instances themselves or by other jobs), otherwise climb towards higher tick rate
+    float pressure = parallel_readPressure();
+    float load = parallel_readLoad();
+    int32_t stride = (activeSlots >= 8) ? (int32_t)(activeSlots / 8) : 1;
+    int32_t step = 0;
+    if (pressure > PARALLEL_PRESSURE_HIGH || load > (float)control->cpuCount * PARALLEL_LOAD_HIGH) {
+        step = -stride;
+    } else if (control->previousRate <= 0.0f) {
+        step = stride;
+    } else if (tickRate > control->previousRate * (1.0f + PARALLEL_GAIN_MIN)) {
+        step = (control->lastStep < 0) ? -stride : stride;  // last change helped, continue in same direction
+    } else if (tickRate < control->previousRate * (1.0f - PARALLEL_GAIN_MIN)) {
+        step = (control->lastStep < 0) ? stride : -stride;  // last change (or other job if unchanged) hurt, go back
+    } else if (++control->stablePeriods >= PARALLEL_PROBE_PERIODS) {
+        step = stride;  // probe if host got more capacity
+    }
+
+    int64_t target = (int64_t)activeSlots + step;
+    target = (target < 1) ? 1 : (target > (int64_t)parallelMax) ? (int64_t)parallelMax : target;
+    control->lastStep = (int32_t)(target - (int64_t)activeSlots);
+    control->previousRate = tickRate;
+    if (control->lastStep == 0) {
+        return;
+    }
+    control->stablePeriods = 0;
+    activeSlots = (uint32_t)target;
+
+    // supervisors fill new slots immediately
+    for (uint32_t t = 0; control->lastStep > 0 && t < supervisorCount; t++) {
+        supervisor_wake(&supervisors[t]);
+    }
+}
+
+// percentage of time some runnable tasks waited for CPU in last 10 seconds (-1 if kernel does not report pressure)
+static float parallel_readPressure(void)
+{
+    float pressure = -1.0f;
+    FILE *file = fopen("/proc/pressure/cpu", "r");
+    if (file != NULL) {
+        if (fscanf(file, "some avg10=%f", &pressure) != 1) {
+            pressure = -1.0f;
+        }
+        fclose(file);
+    }
+    return pressure;
+}
+
+// load average of last minute (-1 if unavailable)
+static float parallel_readLoad(void)
+{
+    float load = -1.0f;
+    FILE *file = fopen("/proc/loadavg", "r");
+    if (file != NULL) {
+        if (fscanf(file, "%f", &load) != 1) {
+            load = -1.0f;
+        }
+        fclose(file);
+    }
+    return load;
+}
+
+// loads records of current version from cache file of population and keeps file open for appending, returns 0 on success
+static int cache_open(void)
+{
+    // version covers everything fitness of seed depends on besides genome (programs, fitness weights and activation precision)
+    const float fitnessWeights[] = {FITNESS_WEIGHT_SCORE, FITNESS_WEIGHT_TIME, FITNESS_WEIGHT_LEVEL, (float)AUTOKILL_TIMEOUT};
+    const uint32_t precision = (uint32_t)activationPrecision;
+    cacheVersion = cache_hash(0xcbf29ce484222325, fitnessWeights, sizeof(fitnessWeights));
+    cacheVersion = cache_hash(cacheVersion, &precision, sizeof(precision));
+    cacheVersion = cache_fileHash(cacheVersion, "./bin/game");
+    cacheVersion = cache_fileHash(cacheVersion, "./bin/neurons");
+
+    char *cachePath = (char *)malloc((cu_CStringLength(populationDir) + 16) * sizeof(char));
+    if (cachePath == NULL || (cacheIndex = xDictionary_new()) == NULL) {
+        free(cachePath);
+        return 1;
+    }
+    sprintf(cachePath, "%s/fitness.cache", populationDir);
+    cacheFile = fopen(cachePath, "a+b");
+    free(cachePath);
+    if (cacheFile == NULL) {
+        cache_close();
+        return 1;
+    }
+
+    // records of other versions stay in file but are never matched
+    fitnessRecord_t record;
+    rewind(cacheFile);
+    while (fread(&record, sizeof(fitnessRecord_t), 1, cacheFile) == 1) {
+        if (record.versionHash == cacheVersion) {
+            cache_insert(&record);
+        }
+    }
+    fseek(cacheFile, 0, SEEK_END);
+    return 0;
+}
+
+static void cache_close(void)
+{
+    if (cacheFile != NULL) {
+        fclose(cacheFile);
+        cacheFile = NULL;
+    }
+    if (cacheIndex != NULL) {
+        xDictionary_free(cacheIndex);
+        cacheIndex = NULL;
+    }
+    free(cacheRecords);
+    cacheRecords = NULL;
+    cacheRecordCount = 0;
+    cacheRecordCapacity = 0;
+}
+
+// returns 0 and fitness of seed if genome already played it with current programs
+static int cache_lookup(uint64_t genomeHash, uint32_t seed, float *fitness)
+{
+    uintptr_t index = (uintptr_t)xDictionary_get(cacheIndex, cache_key(genomeHash, cacheVersion, seed));
+    if (index == 0 || cacheRecords[index - 1].genomeHash != genomeHash || cacheRecords[index - 1].seed != seed) {
+        return 1;
+    }
+    *fitness = cacheRecords[index - 1].fitness;
+    return 0;
+}
+
+// records fitness in memory and in cache file
+static void cache_store(uint64_t genomeHash, uint32_t seed, float fitness)
+{
+    fitnessRecord_t record = {genomeHash, cacheVersion, seed, fitness};
+    if (cache_insert(&record) == 0) {
+        fwrite(&record, sizeof(fitnessRecord_t), 1, cacheFile);
+    }
+}
+
+// returns 0 if record was added to memory (1 if already known or out of memory)
+static int cache_insert(const fitnessRecord_t *record)
+{
+    float cachedFitness;
+    if (cache_lookup(record->genomeHash, record->seed, &cachedFitness) == 0) {
+        return 1;
+    }
+    if (cacheRecordCount == cacheRecordCapacity) {
+        uint32_t capacity = (cacheRecordCapacity > 0) ? cacheRecordCapacity * 2 : 256;
+        fitnessRecord_t *records = (fitnessRecord_t *)realloc(cacheRecords, capacity * sizeof(fitnessRecord_t));
+        if (records == NULL) {
+            return 1;
+        }
+        cacheRecords = records;
+        cacheRecordCapacity = capacity;
+    }
+    cacheRecords[cacheRecordCount++] = *record;
+    xDictionary_insert(cacheIndex, cache_key(record->genomeHash, record->versionHash, record->seed),
+                       (void *)(uintptr_t)cacheRecordCount);
+    return 0;
+}
+
+static unsigned long long cache_key(uint64_t genomeHash, uint64_t versionHash, uint32_t seed)
+{
+    uint64_t key = cache_hash(genomeHash, &versionHash, sizeof(versionHash));
+    return cache_hash(key, &seed, sizeof(seed));
+}
+
+// hash of layer sizes, activations, weights and biases of record (0 if there is no record)
+static uint64_t cache_genomeHash(uint32_t instanceID)
+{
+    if (arena.base == NULL || instanceID >= arenaCount) {
+        return 0;
+    }
+    FnnModel model;
+    arena_view(&model, &arena, instanceID);
+    uint64_t hash = cache_hash(0xcbf29ce484222325, &model.layerCount, sizeof(model.layerCount));
+    hash = cache_hash(hash, model.neuronCounts, model.layerCount * sizeof(uint32_t));
+    hash = cache_hash(hash, model.activationFunctions, (model.layerCount - 1) * sizeof(FnnActivation_e));
+    hash = cache_hash(hash, model.weightValues, model.totalWeights * sizeof(float));
+    hash = cache_hash(hash, model.biasValues, model.totalBiases * sizeof(float));
+    return hash;
+}
+
+// continues hash over content of file (missing file leaves hash unchanged)
+static uint64_t cache_fileHash(uint64_t hash, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return hash;
+    }
+    unsigned char buffer[65536];
+    size_t readSize;
+    while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        hash = cache_hash(hash, buffer, readSize);
+    }
+    fclose(file);
+    return hash;
+}
+
+// FNV-1a continued from given hash
+static uint64_t cache_hash(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+// allocates packed population image with zeroed records for models of layout (first allocation also sets layout and geometry)
+static int arena_allocate(populationArena_t *population, const FnnModel *layout, uint32_t count, uint32_t generation)
+{
+    *population = (populationArena_t){NULL, 0, -1};
+    if (layout == NULL || count == 0) {
+        return 1;
+    }
+    if (arenaLayout == NULL) {
+        arenaLayout = fnn_new();
+        if (arenaLayout == NULL) {
+            return 1;
+        }
+        arenaLayout->totalWeights = layout->totalWeights;
+        arenaLayout->totalBiases = layout->totalBiases;
+        arenaLayout->layerCount = layout->layerCount;
+        arenaLayout->neuronCounts = (uint32_t *)malloc(layout->layerCount * sizeof(uint32_t));
+        arenaLayout->activationFunctions = (FnnActivation_e *)malloc((layout->layerCount - 1) * sizeof(FnnActivation_e));
+        if (arenaLayout->neuronCounts == NULL || arenaLayout->activationFunctions == NULL) {
+            fnn_free(arenaLayout);
+            arenaLayout = NULL;
+            return 1;
+        }
+        memcpy(arenaLayout->neuronCounts, layout->neuronCounts, layout->layerCount * sizeof(uint32_t));
+        memcpy(arenaLayout->activationFunctions, layout->activationFunctions, (layout->layerCount - 1) * sizeof(FnnActivation_e));
+        arenaRecordsOffset = fnn_populationRecordsOffset(layout->layerCount);
+        arenaRecordSize = fnn_serializedSize(arenaLayout);
+        arenaStride = (arenaRecordSize + FNN_SERIALIZER_ALIGNMENT - 1) / FNN_SERIALIZER_ALIGNMENT * FNN_SERIALIZER_ALIGNMENT;
+    }
+
+    // memory file is zero filled, so only header and architecture are written
+    uint64_t tableOffset = arenaRecordsOffset + count * arenaStride;
+    population->size = tableOffset + count * sizeof(FnnPopulationEntry);
+    population->fd = memfd_create("population", MFD_CLOEXEC);
+    if (population->fd == -1 || ftruncate(population->fd, (off_t)population->size) != 0) {
+        arena_release(population);
+        return 1;
+    }
+    void *base = mmap(NULL, population->size, PROT_READ | PROT_WRITE, MAP_SHARED, population->fd, 0);
+    if (base == MAP_FAILED) {
+        arena_release(population);
+        return 1;
+    }
+    population->base = (unsigned char *)base;
+
+    FnnPopulationHeader header = {FNN_POPULATION_MAGIC, FNN_POPULATION_VERSION, 0, generation, count, arenaRecordSize, arenaStride,
+                                  arenaRecordsOffset, tableOffset, arenaLayout->totalWeights, arenaLayout->totalBiases,
+                                  arenaLayout->layerCount, 0};
+    unsigned char *architecture = population->base + sizeof(FnnPopulationHeader);
+    memcpy(population->base, &header, sizeof(FnnPopulationHeader));
+    memcpy(architecture, arenaLayout->neuronCounts, arenaLayout->layerCount * sizeof(uint32_t));
+    memcpy(architecture + arenaLayout->layerCount * sizeof(uint32_t), arenaLayout->activationFunctions,
+           (arenaLayout->layerCount - 1) * sizeof(FnnActivation_e));
+    return 0;
+}
+
+// serializes model into record (fails if model does not have layout of population)
+static int arena_store(populationArena_t *population, uint32_t index, const FnnModel *model)
+{
+    if (model->layerCount != arenaLayout->layerCount || model->totalWeights != arenaLayout->totalWeights ||
+        model->totalBiases != arenaLayout->totalBiases ||
+        memcmp(model->neuronCounts, arenaLayout->neuronCounts, model->layerCount * sizeof(uint32_t)) != 0 ||
+        memcmp(model->activationFunctions, arenaLayout->activationFunctions, (model->layerCount - 1) * sizeof(FnnActivation_e)) != 0) {
+        return 1;
+    }
+    return (fnn_serializeBuffer(arena_record(population, index), model) == 0) ? 0 : 1;
+}
+
+// fills descriptor whose values point into record (descriptor must not be freed)
+static void arena_view(FnnModel *view, const populationArena_t *population, uint32_t index)
+{
+    *view = *arenaLayout;
+    const unsigned char *values = arena_record(population, index) + fnn_valuesOffset(FNN_SERIALIZER_VERSION, arenaLayout->layerCount);
+    view->weightValues = (float *)values;
+    view->biasValues = view->weightValues + arenaLayout->totalWeights;
+}
+
+static unsigned char *arena_record(const populationArena_t *population, uint32_t index)
+{
+    return population->base + arenaRecordsOffset + index * arenaStride;
+}
+
+// loads records of packed population file into arena (fitness table of file is not used, generation is evaluated again)
+static int arena_loadPacked(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return 1;
+    }
+    struct stat fileStat;
+    FnnPopulationHeader header;
+    if (fstat(fd, &fileStat) != 0 || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        fnn_populationValidate(&header, (uint64_t)fileStat.st_size) != 0) {
+        close(fd);
+        return 1;
+    }
+    unsigned char *file = (unsigned char *)mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED) {
+        return 1;
+    }
+
+    // architecture follows header, records of file may use other stride than arena
+    FnnModel layout = {0};
+    layout.totalWeights = header.totalWeights;
+    layout.totalBiases = header.totalBiases;
+    layout.layerCount = header.layerCount;
+    layout.neuronCounts = (uint32_t *)(file + sizeof(FnnPopulationHeader));
+    layout.activationFunctions = (FnnActivation_e *)(layout.neuronCounts + header.layerCount);
+    int result = arena_allocate(&arena, &layout, header.count, header.generation);
+    for (uint32_t i = 0; result == 0 && i < header.count; i++) {
+        memcpy(arena_record(&arena, i), file + header.recordsOffset + i * header.recordStride, arenaRecordSize);
+    }
+    munmap(file, (size_t)fileStat.st_size);
+    if (result != 0) {
+        arena_free();
+        return 1;
+    }
+
+    arenaCount = header.count;
+    arenaGeneration = header.generation;
+    arenaDirty = false;
+    return 0;
+}
+
+// replaces descriptors by descriptors of arena generation (model paths refer to records of its checkpoint file if it exists)
+static int arena_describe(bool checkpointed)
+{
+    pthread_mutex_lock(&instancerMutex);
+    xArray_forEach(descriptors, (void (*)(void *))instance_free);
+    descriptors->size = 0;
+    pthread_mutex_unlock(&instancerMutex);
+
+    for (uint32_t i = 0; i < arenaCount; i++) {
+        char *modelPath = arena_modelPath(i, checkpointed);
+        if (modelPath == NULL) {
             return 1;
         }
+        managerInstance_t *instance = instance_new(modelPath);
+        if (instance == NULL) {
+            free(modelPath);
+            return 1;
+        }
+        instance->generation = arenaGeneration;
+    }
+    return 0;
+}
+
+// returns allocated model path of arena record (marker if generation was not checkpointed)
+static char *arena_modelPath(uint32_t index, bool checkpointed)
+{
+    char *modelPath = (char *)malloc((cu_CStringLength(populationDir) + 32) * sizeof(char));
+    if (modelPath == NULL) {
+        return NULL;
+    }
+    if (checkpointed) {
+        sprintf(modelPath, "%s/gen%u.fnnp[%u]", populationDir, arenaGeneration, index);
+    } else {
+        sprintf(modelPath, "(not checkpointed)");
+    }
+    return modelPath;
+}
+
+// writes arena generation with fitness of its descriptors as packed population file and points population link to it
+// (model paths of descriptors are pointed to records of written file)
+static int arena_checkpoint(void)
+{
+    FnnPopulationEntry *table = (FnnPopulationEntry *)(arena.base + ((const FnnPopulationHeader *)arena.base)->tableOffset);
+    for (int i = 0; i < descriptors->size; i++) {
+        const managerInstance_t *instance = (const managerInstance_t *)xArray_get(descriptors, i);
+        if (instance->instanceID < arenaCount) {
+            table[instance->instanceID] =
+                (FnnPopulationEntry){instance->fitnessScore, instance->seedsScored, instance->seedsCached, instance->raced ? 1 : 0};
+        }
+    }
+
+    // generation file is written under temporary name, so that population link never points to partially written file
+    char genName[24];
+    sprintf(genName, "gen%u.fnnp", arenaGeneration);
+    char *genPath = (char *)malloc((cu_CStringLength(populationDir) + 30) * sizeof(char));
+    char *tempPath = (char *)malloc((cu_CStringLength(populationDir) + 30) * sizeof(char));
+    char *linkPath = (char *)malloc((cu_CStringLength(populationDir) + 30) * sizeof(char));
+    if (genPath == NULL || tempPath == NULL || linkPath == NULL) {
+        free(genPath);
+        free(tempPath);
+        free(linkPath);
+        return 1;
+    }
+    sprintf(genPath, "%s/%s", populationDir, genName);
+    sprintf(tempPath, "%s/%s.tmp", populationDir, genName);
+    sprintf(linkPath, "%s/population.fnnp", populationDir);
+
+    int result = 1;
+    int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd != -1) {
+        uint64_t written = 0;
+        ssize_t count = 0;
+        while (written < arena.size && (count = write(fd, arena.base + written, arena.size - written)) > 0) {
+            written += (uint64_t)count;
+        }
+        result = (close(fd) == 0 && written == arena.size && rename(tempPath, genPath) == 0) ? 0 : 1;
+    }
+
+    // population link is replaced atomically by link to new generation file
+    if (result == 0) {
+        sprintf(tempPath, "%s/population.fnnp.tmp", populationDir);
+        unlink(tempPath);
+        result = (symlink(genName, tempPath) == 0 && rename(tempPath, linkPath) == 0) ? 0 : 1;
+    }
+    free(genPath);
+    free(tempPath);
+    free(linkPath);
+
+    if (result == 0) {
+        arenaDirty = false;
+        pthread_mutex_lock(&instancerMutex);
+        for (int i = 0; i < descriptors->size; i++) {
+            managerInstance_t *instance = (managerInstance_t *)xArray_get(descriptors, i);
+            char *modelPath = arena_modelPath(instance->instanceID, true);
+            if (modelPath != NULL) {
+                free(instance->modelPath);
+                instance->modelPath = modelPath;
+            }
+        }
+        pthread_mutex_unlock(&instancerMutex);
+    }
+    return result;
+}
+
+static void arena_release(populationArena_t *population)
+{
+    if (population->base != NULL) {
+        munmap(population->base, population->size);
+    }
+    if (population->fd != -1) {
+        close(population->fd);
+    }
+    *population = (populationArena_t){NULL, 0, -1};
+}
+
+static void arena_free(void)
+{
+    arena_release(&arena);
+    fnn_free(arenaLayout);
+    arenaLayout = NULL;
+    arenaRecordsOffset = 0;
+    arenaStride = 0;
+    arenaRecordSize = 0;
+    arenaCount = 0;
+    arenaDirty = false;
+}
+
+static struct sharedState_s *slot_state(uint32_t slot)
+{
+    char shmemStatus[32];
+    slot_name(shmemStatus, slot, 's');
+    return (struct sharedState_s *)xDictionary_get(shStatDict, cu_CStringHash(shmemStatus));
+}
+
+static struct sharedOutput_s *slot_output(uint32_t slot)
+{
+    char shmemOutput[32];
+    slot_name(shmemOutput, slot, 'o');
+    return (struct sharedOutput_s *)xDictionary_get(shOutDict, cu_CStringHash(shmemOutput));
+}
+
+// shared memory names of slot (suffix 'i', 'o' or 's' for input, output and state block)
+static void slot_name(char *name, uint32_t slot, char suffix)
+{
+    sprintf(name, "slot%u%c", slot, suffix);
+}
+
+// CPUs of each node are paired in order of cores (siblings of one core, or same sibling of two cores), leftover CPU is
+// paired with itself
+static int placement_build(enum instancePlacement_e mode)
+{
+    cpu_set_t allowed, nodeIDs;
+    if (mode == PLACEMENT_NONE || sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) {
+        return 1;
+    }
+
+    // NUMA nodes of kernel (all allowed CPUs form single node if kernel has no NUMA support)
+    if (placement_readList("/sys/devices/system/node/online", &nodeIDs) != 0 || CPU_COUNT(&nodeIDs) == 0) {
+        CPU_ZERO(&nodeIDs);
+        CPU_SET(0, &nodeIDs);
+    }
+    nodeCPUs = (cpu_set_t *)malloc((size_t)CPU_COUNT(&nodeIDs) * sizeof(cpu_set_t));
+    cpuPairs = (cpuPair_t *)malloc((size_t)CPU_COUNT(&allowed) * sizeof(cpuPair_t));
+    if (nodeCPUs == NULL || cpuPairs == NULL) {
+        placement_free();
+        return 1;
+    }
+    for (int id = 0; id < CPU_SETSIZE; id++) {
+        char path[64];
+        sprintf(path, "/sys/devices/system/node/node%d/cpulist", id);
+        if (CPU_ISSET(id, &nodeIDs) == 0) {
+            continue;
+        } else if (CPU_COUNT(&nodeIDs) == 1 || placement_readList(path, &nodeCPUs[nodeCount]) != 0) {
+            nodeCPUs[nodeCount] = allowed;
+        }
+        CPU_AND(&nodeCPUs[nodeCount], &nodeCPUs[nodeCount], &allowed);
+        nodeCount++;
     }
 
-    close(in);
-    close(out);
+    for (uint32_t node = 0; node < nodeCount; node++) {
+        // cores of node as lists of their allowed SMT siblings
+        int sequence[CPU_SETSIZE];
+        int sequenceLength = 0;
+        cpu_set_t cores[CPU_SETSIZE / 2];
+        int coreCount = 0;
+        cpu_set_t seen;
+        CPU_ZERO(&seen);
+        for (int cpu = 0; cpu < CPU_SETSIZE && coreCount < CPU_SETSIZE / 2; cpu++) {
+            char path[96];
+            sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+            if (CPU_ISSET(cpu, &nodeCPUs[node]) == 0 || CPU_ISSET(cpu, &seen)) {
+                continue;
+            } else if (placement_readList(path, &cores[coreCount]) != 0 || CPU_ISSET(cpu, &cores[coreCount]) == 0) {
+                CPU_ZERO(&cores[coreCount]);
+                CPU_SET(cpu, &cores[coreCount]);
+            }
+            CPU_AND(&cores[coreCount], &cores[coreCount], &nodeCPUs[node]);
+            CPU_OR(&seen, &seen, &cores[coreCount]);
+            coreCount++;
+        }
 
-    return (nread == -1) ? 1 : 0;
+        // siblings placement walks core by core, cores placement walks sibling by sibling
+        int rankCount = (mode == PLACEMENT_SIBLINGS) ? 1 : CPU_SETSIZE;
+        for (int rank = 0; rank < rankCount && sequenceLength < CPU_COUNT(&nodeCPUs[node]); rank++) {
+            for (int core = 0; core < coreCount; core++) {
+                for (int cpu = 0, sibling = 0; cpu < CPU_SETSIZE; cpu++) {
+                    if (CPU_ISSET(cpu, &cores[core]) == 0) {
+                        continue;
+                    } else if (mode == PLACEMENT_SIBLINGS || sibling == rank) {
+                        sequence[sequenceLength++] = cpu;
+                    }
+                    sibling++;
+                }
+            }
+        }
+
+        for (int i = 0; i < sequenceLength; i += 2) {
+            int aiCPU = (i + 1 < sequenceLength) ? sequence[i + 1] : sequence[i];
+            cpuPairs[cpuPairCount++] = (cpuPair_t){sequence[i], aiCPU, node, (uint32_t)i / 2};
+        }
+    }
+
+    if (cpuPairCount == 0) {
+        placement_free();
+        return 1;
+    }
+    qsort(cpuPairs, cpuPairCount, sizeof(cpuPair_t), placement_compare);
+    return 0;
+}
+
+static void placement_free(void)
+{
+    free(cpuPairs);
+    cpuPairs = NULL;
+    cpuPairCount = 0;
+    free(nodeCPUs);
+    nodeCPUs = NULL;
+    nodeCount = 0;
+}
+
+// reads kernel list format ("0-3,8-11") into CPU set, returns 0 on success
+static int placement_readList(const char *path, cpu_set_t *set)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return 1;
+    }
+    char line[4096];
+    char *cursor = fgets(line, sizeof(line), file);
+    fclose(file);
+    if (cursor == NULL) {
+        return 1;
+    }
+
+    CPU_ZERO(set);
+    while (cursor != NULL && *cursor >= '0' && *cursor <= '9') {
+        long first = strtol(cursor, &cursor, 10);
+        long last = (*cursor == '-') ? strtol(cursor + 1, &cursor, 10) : first;
+        for (long id = first; id <= last && id < CPU_SETSIZE; id++) {
+            CPU_SET(id, set);
+        }
+        cursor = (*cursor == ',') ? cursor + 1 : NULL;
+    }
+    return (cursor == line) ? 1 : 0;
+}
+
+static int placement_compare(const void *a, const void *b)
+{
+    const cpuPair_t *pairA = (const cpuPair_t *)a;
+    const cpuPair_t *pairB = (const cpuPair_t *)b;
+    if (pairA->order != pairB->order) {
+        return (pairA->order < pairB->order) ? -1 : 1;
+    }
+    return (pairA->node < pairB->node) ? -1 : (pairA->node > pairB->node);
+}
+
+static int pidfdOpen(pid_t pid)
+{
+    return (int)syscall(SYS_pidfd_open, pid, 0);
 }
@@ -500,8 +500,8 @@ int cmd_populationLoad(void)
 
 int cmd_generationStart(void)
 {
-    // ask user for max parallel instances, evolution iterations, epoch size, elitism count and number of random seeds to use for
-    // single generation
+    // ask user for max parallel instances, parallelism mode, evolution iterations, epoch size, elitism count, number of random
+    // seeds to use for single generation, racing mode, fitness cache mode, activation precision and CPU placement of instances
     printf("\tMax parallel instances: ");
     xString *parallelCountStr = xString_readInSafe(6);
     if (parallelCountStr == NULL) {
@@ -514,6 +514,18 @@ int cmd_generationStart(void)
     mInstancer_setMaxParallel((uint32_t)xString_toInt(parallelCountStr));
     xString_free(parallelCountStr);
 
+    printf("\tAdaptive parallelism (0 - fixed, 1 - adaptive up to max parallel instances): ");
+    xString *adaptiveStr = xString_readInSafe(2);
+    if (adaptiveStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(adaptiveStr)) {
+        printf("\t[ERR]: Invalid parallelism mode\n");
+        xString_free(adaptiveStr);
+        return 0;
+    }
+    mInstancer_setAdaptiveParallel(xString_toInt(adaptiveStr) != 0);
+    xString_free(adaptiveStr);
+
     printf("\tEvolution iterations: ");
     xString *iterationCountStr = xString_readInSafe(6);
     if (iterationCountStr == NULL) {
@@ -550,6 +562,18 @@ int cmd_generationStart(void)
     mInstancer_setElitismCount((uint32_t)xString_toInt(elitismCountStr));
     xString_free(elitismCountStr);
 
+    printf("\tParent selection (0 - fitness proportional, 1 - tournament, 2 - rank): ");
+    xString *selectionStr = xString_readInSafe(2);
+    if (selectionStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(selectionStr)) {
+        printf("\t[ERR]: Invalid parent selection\n");
+        xString_free(selectionStr);
+        return 0;
+    }
+    mInstancer_setSelection((enum selectionMethod_e)xString_toInt(selectionStr));
+    xString_free(selectionStr);
+
     printf("\tSeed count (minimally 1): ");
     xString *seedCountStr = xString_readInSafe(6);
     if (seedCountStr == NULL) {
@@ -562,6 +586,66 @@ int cmd_generationStart(void)
     mInstancer_setSeedCount((uint32_t)xString_toInt(seedCountStr));
     xString_free(seedCountStr);
 
+    printf("\tRacing (0 - evaluate all seeds, 1 - cancel remaining seeds of hopeless individuals): ");
+    xString *racingStr = xString_readInSafe(2);
+    if (racingStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(racingStr)) {
+        printf("\t[ERR]: Invalid racing mode\n");
+        xString_free(racingStr);
+        return 0;
+    }
+    mInstancer_setRacing(xString_toInt(racingStr) != 0);
+    xString_free(racingStr);
+
+    printf("\tFitness cache (0 - play all seeds, 1 - reuse fitness of seeds already played by same model): ");
+    xString *cacheStr = xString_readInSafe(2);
+    if (cacheStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(cacheStr)) {
+        printf("\t[ERR]: Invalid fitness cache mode\n");
+        xString_free(cacheStr);
+        return 0;
+    }
+    mInstancer_setFitnessCache(xString_toInt(cacheStr) != 0);
+    xString_free(cacheStr);
+
+    printf("\tCheckpoint interval (generations between writing population to disk, 0 - only at end of run): ");
+    xString *checkpointStr = xString_readInSafe(6);
+    if (checkpointStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(checkpointStr)) {
+        printf("\t[ERR]: Invalid checkpoint interval\n");
+        xString_free(checkpointStr);
+        return 0;
+    }
+    mInstancer_setCheckpointInterval((uint32_t)xString_toInt(checkpointStr));
+    xString_free(checkpointStr);
+
+    printf("\tActivation precision (0 - exact, 1 - fast approximation): ");
+    xString *precisionStr = xString_readInSafe(2);
+    if (precisionStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(precisionStr)) {
+        printf("\t[ERR]: Invalid activation precision\n");
+        xString_free(precisionStr);
+        return 0;
+    }
+    mInstancer_setPrecision((enum activationPrecision_e)xString_toInt(precisionStr));
+    xString_free(precisionStr);
+
+    printf("\tCPU placement (0 - none, 1 - core pairs, 2 - SMT sibling pairs): ");
+    xString *placementStr = xString_readInSafe(2);
+    if (placementStr == NULL) {
+        return 1;
+    } else if (xString_isEmpty(placementStr)) {
+        printf("\t[ERR]: Invalid CPU placement\n");
+        xString_free(placementStr);
+        return 0;
+    }
+    mInstancer_setPlacement((enum instancePlacement_e)xString_toInt(placementStr));
+    xString_free(placementStr);
+
     if (mInstancer_startPopulation() != 0) {
         printf("\t[ERR]: Failed to start generation\n");
         return 1;
@@ -588,6 +672,23 @@ int cmd_generationStatus(void)
                instance->fitnessScore);
     }
 
+    // print parallelism of running population
+    uint32_t activeCount;
+    float ticksPerSecond;
+    mInstancer_getParallelism(&activeCount, &ticksPerSecond);
+    if (activeCount > 0) {
+        printf("Parallel instances: %u (%.0f game ticks per second, %.0f per instance)\n", activeCount, ticksPerSecond,
+               ticksPerSecond / (float)activeCount);
+    }
+
+    // print fitness cache hit rate of generation
+    uint32_t cacheHits, cacheLookups;
+    mInstancer_getCacheStatistics(&cacheHits, &cacheLookups);
+    if (cacheLookups > 0) {
+        printf("Fitness cache: %u of %u seeds (%.1f%% hit rate)\n", cacheHits, cacheLookups,
+               100.0f * (float)cacheHits / (float)cacheLookups);
+    }
+
     return 0;
 }
 
@@ -618,9 +719,15 @@ int cmd_instanceStatus(void)
            "\tAI PID: %d\n"
            "\tModel: %s\n"
            "\tGeneration: %d\n"
-           "\tFitness score: %.2f\n",
+           "\tFitness score: %.2f\n"
+           "\tInferences: %" PRIu64 " (%" PRIu64 " duplicate, %.0f per second)\n"
+           "\tForward pass: p50 %u ns, p99 %u ns (cycle p99 %u ns)\n"
+           "\tLast exit codes: game %d, AI %d\n"
+           "\tCPU time: game %.2f s, AI %.2f s (AI max RSS %ld KiB)\n",
            instance->instanceID, instance->status, instance->gamePID, instance->aiPID, instance->modelPath, instance->generation,
-           instance->fitnessScore);
+           instance->fitnessScore, instance->inferenceCount, instance->duplicateCount, instance->inferenceRate,
+           instance->forwardP50, instance->forwardP99, instance->cycleP99, instance->gameExitStatus, instance->aiExitStatus,
+           instance->gameCpuTime, instance->aiCpuTime, instance->aiMaxResident);
 
     return 0;
 }
@@ -0,0 +1,66 @@
+/**
+ * @file fnnActivation.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Vectorized activation functions for FNN layers with selectable precision.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Activation functions are applied to whole layer output vector at once. Two precision modes are available:
+ * - Exact: sigmoid and tanh are computed using libm (`expf`, `tanhf`) for each neuron.
+ * - Fast: sigmoid and tanh are computed using rational approximation of tanh (sigmoid(x) = 0.5 + 0.5 * tanh(x / 2)) evaluated 8
+ *   (AVX2) or 16 (AVX-512) lanes at a time. Maximum absolute error against double precision reference is
+ *   `FNN_FAST_TANH_MAX_ERROR` for tanh and `FNN_FAST_SIGMOID_MAX_ERROR` for sigmoid over the whole float range.
+ *
+ * Pass-through and ReLU activations are exact in both modes.
+ */
+
+#ifndef FNN_ACTIVATION_H
+#define FNN_ACTIVATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnSerializer.h"  // activation function identifiers
+
+#define FNN_FAST_TANH_MAX_ERROR 4.2e-7f     // measured maximum absolute error of fast tanh
+#define FNN_FAST_SIGMOID_MAX_ERROR 2.3e-7f  // measured maximum absolute error of fast sigmoid
+
+/**
+ * @brief Precision mode of activation functions
+ *
+ */
+typedef enum {
+    FNN_PRECISION_EXACT = 0,  // libm evaluation (reference)
+    FNN_PRECISION_FAST = 1    // vectorized rational approximation
+} FnnPrecision_e;
+
+/**
+ * @brief Apply activation function in-place to array of values
+ *
+ * @param values Pointer to values (layer output before activation)
+ * @param count Number of values
+ * @param activation Activation function to apply
+ * @param precision Precision mode used for sigmoid and tanh
+ *
+ * @note Unknown activation identifiers are treated as pass-through.
+ */
+void fnn_activate(float *values, uint32_t count, FnnActivation_e activation, FnnPrecision_e precision);
+
+/**
+ * @brief Parse precision mode from its name
+ *
+ * @param name Name of precision mode ("exact" or "fast")
+ * @param precision Pointer for storing parsed precision mode
+ * @return `int32_t`: 0 if successful, -1 if name is not recognized
+ */
+int32_t fnn_precisionFromName(const char *name, FnnPrecision_e *precision);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_ACTIVATION_H
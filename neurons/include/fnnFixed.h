@@ -0,0 +1,86 @@
+/**
+ * @file fnnFixed.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Inference kernels specialized at compile time for fixed FNN architectures.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Every architecture listed in `FNN_FIXED_ARCHITECTURES_1` (one hidden layer) or `FNN_FIXED_ARCHITECTURES_2` (two hidden layers)
+ * gets its own forward functions (one per SIMD level) with all dimensions and activations known at compile time, so loops over
+ * layer inputs are fully unrolled and loops over layer outputs vectorized without remainder handling. Loaded model uses specialized
+ * function only if its neuron counts and activation functions match one of listed architectures exactly, otherwise generic
+ * inference path has to be used. Inputs are summed in same order as in generic float inference, so results differ from it only by
+ * rounding of fused multiply-add in vectorized kernels.
+ */
+
+#ifndef FNN_FIXED_H
+#define FNN_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnActivation.h"  // activation functions and precision modes
+#include "xList.h"          // lists of loaded layer matrices
+
+/* Architectures with one hidden layer (inputs, hidden, outputs, hidden activation, output activation).
+ * Activation names are suffixes of FnnActivation_e identifiers (NONE, SIGMOID, RELU, TANH).
+ * 5-32-4 ReLU/sigmoid is default architecture of agent.
+ */
+#define FNN_FIXED_ARCHITECTURES_1(X)      \
+    X(5, 32, 4, RELU, SIGMOID)            \
+    X(5, 16, 4, RELU, SIGMOID)            \
+    X(5, 64, 4, RELU, SIGMOID)            \
+    X(5, 32, 4, TANH, SIGMOID)
+
+/* Architectures with two hidden layers (inputs, hidden 1, hidden 2, outputs, activations of hidden 1, hidden 2 and output).
+ */
+#define FNN_FIXED_ARCHITECTURES_2(X)      \
+    X(5, 32, 32, 4, RELU, RELU, SIGMOID)  \
+    X(5, 64, 64, 4, RELU, RELU, SIGMOID)
+
+/**
+ * @brief Model bound to specialized forward function
+ *
+ */
+typedef struct {
+    const char *name;  // architecture description (for example "5-32-4 RELU/SIGMOID")
+    void (*forward)(const float *parameters, const float *input, float *output, FnnPrecision_e precision);
+    float *parameters;  // weights and biases of all layers packed in order of inference (weights, biases, weights, ...)
+} FnnFixedModel;
+
+/**
+ * @brief Select specialized forward function for loaded model
+ *
+ * @param weightMatrices List of weight matrices (inputs x outputs) as loaded by `fnn_loadModel`
+ * @param biasMatrices List of bias matrices (1 x outputs)
+ * @param activationFunctions List of activation function identifiers
+ * @return `FnnFixedModel*`: Model with copied parameters, NULL if architecture is not specialized (or allocation failed)
+ */
+FnnFixedModel *fnn_fixedSelect(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions);
+
+/**
+ * @brief Free specialized model from memory
+ *
+ * @param model Model to free
+ */
+void fnn_fixedFree(FnnFixedModel *model);
+
+/**
+ * @brief Run inference using specialized forward function
+ *
+ * @param model Specialized model
+ * @param input Input values (number of inputs of first layer)
+ * @param output Output values (number of outputs of last layer)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ */
+void fnn_fixedForward(const FnnFixedModel *model, const float *input, float *output, FnnPrecision_e precision);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_FIXED_H
@@ -0,0 +1,63 @@
+/**
+ * @file fnnForward.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Batched inference of FNN models with float weights.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Batch of observations is stored as matrix with one observation per row, so every layer becomes single matrix product (using
+ * cache-blocked kernel of xLinear for large batches) followed by bias addition and activation over whole block. Parallel variant
+ * splits batch rows across process-wide thread pool.
+ */
+
+#ifndef FNN_FORWARD_H
+#define FNN_FORWARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnActivation.h"  // activation functions and precision modes
+#include "xLinear.h"        // matrix operations
+#include "xList.h"          // lists of loaded layer matrices
+
+#define FNN_PARALLEL_BATCH_ROWS 64  // minimal number of batch rows processed by one thread
+
+/**
+ * @brief Run inference on batch of observations
+ *
+ * @param weightMatrices List of weight matrices (inputs x outputs) as loaded by `fnn_loadModel`
+ * @param biasMatrices List of bias matrices (1 x outputs)
+ * @param activationFunctions List of activation function identifiers
+ * @param inputs Input matrix (batch size x inputs of first layer)
+ * @param outputs Output matrix (batch size x outputs of last layer)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ * @return `int32_t`: 0 on success, -1 on invalid arguments or allocation failure
+ */
+int32_t fnn_forwardBatch(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, xMatrix *inputs, xMatrix *outputs,
+                         FnnPrecision_e precision);
+
+/**
+ * @brief Run inference on batch of observations using thread pool
+ *
+ * @param weightMatrices List of weight matrices (inputs x outputs) as loaded by `fnn_loadModel`
+ * @param biasMatrices List of bias matrices (1 x outputs)
+ * @param activationFunctions List of activation function identifiers
+ * @param inputs Input matrix (batch size x inputs of first layer)
+ * @param outputs Output matrix (batch size x outputs of last layer)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ * @return `int32_t`: 0 on success, -1 on invalid arguments or allocation failure
+ *
+ * @note Batch is split into one band of rows per pool thread (at least `FNN_PARALLEL_BATCH_ROWS` rows each).
+ */
+int32_t fnn_forwardBatchParallel(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, xMatrix *inputs,
+                                 xMatrix *outputs, FnnPrecision_e precision);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_FORWARD_H
@@ -0,0 +1,103 @@
+/**
+ * @file fnnHalf.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Half precision (FP16/BF16) weight storage for FNN inference.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Weights are converted from float to 16-bit format once at load and widened back to float inside of matrix-vector kernel, while
+ * accumulation is done in single precision. Widening uses F16C (FP16) or integer shifts (BF16) on AVX2/AVX-512 hosts and software
+ * conversion otherwise. Biases stay in single precision.
+ */
+
+#ifndef FNN_HALF_H
+#define FNN_HALF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnActivation.h"  // activation functions and precision modes
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xList.h"          // lists of loaded layer matrices
+
+/**
+ * @brief 16-bit floating point formats
+ *
+ */
+typedef enum {
+    FNN_HALF_FP16 = 0,  // IEEE 754 binary16 (10-bit mantissa, 5-bit exponent)
+    FNN_HALF_BF16 = 1   // bfloat16 (7-bit mantissa, 8-bit exponent, same range as float)
+} FnnHalfFormat_e;
+
+/**
+ * @brief FNN layer with 16-bit weights
+ *
+ */
+typedef struct {
+    uint32_t inputs;             // number of layer inputs
+    uint32_t outputs;            // number of layer outputs (neurons)
+    uint32_t outputsPadded;      // outputs rounded up to multiple of 16
+    uint16_t *weights;           // weights stored as [inputs][outputsPadded] (zero padded)
+    float *biases;               // biases for each output (single precision)
+    FnnActivation_e activation;  // activation function of the layer
+} FnnHalfLayer;
+
+/**
+ * @brief FNN model with 16-bit weights
+ *
+ */
+typedef struct {
+    FnnHalfFormat_e format;  // storage format of weights
+    uint32_t layerCount;     // number of layers (without input layer)
+    FnnHalfLayer *layers;    // layers in order of inference
+    float *accBuffer;        // scratch buffer for matrix-vector product (padded)
+    float *valueBuffer;      // scratch buffer for layer outputs
+} FnnHalfModel;
+
+/**
+ * @brief Convert loaded FNN model to 16-bit weights
+ *
+ * @param weightMatrices List of weight matrices (inputs x outputs) as loaded by `fnn_loadModel`
+ * @param biasMatrices List of bias matrices (1 x outputs)
+ * @param activationFunctions List of activation function identifiers
+ * @param format Target 16-bit format
+ * @return `FnnHalfModel*`: Pointer to converted model, NULL on failure
+ *
+ * @note Float weights are rounded to nearest representable value (ties to even).
+ */
+FnnHalfModel *fnn_halfConvert(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, FnnHalfFormat_e format);
+
+/**
+ * @brief Free converted FNN model from memory
+ *
+ * @param model Model to free
+ */
+void fnn_halfFree(FnnHalfModel *model);
+
+/**
+ * @brief Run inference of model with 16-bit weights
+ *
+ * @param model Converted model
+ * @param input Input values (number of inputs of first layer)
+ * @param output Output values (number of outputs of last layer)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ */
+void fnn_halfForward(FnnHalfModel *model, const float *input, float *output, FnnPrecision_e precision);
+
+/**
+ * @brief Get number of bytes used by 16-bit weights
+ *
+ * @param model Converted model
+ * @return `uint64_t`: Size of weights in bytes (including padding)
+ */
+uint64_t fnn_halfWeightBytes(const FnnHalfModel *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_HALF_H
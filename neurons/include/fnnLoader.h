@@ -8,6 +8,10 @@
  *
  * @copyright All rights reserved (c) 2024
  *
+ * Model can either be copied into newly allocated matrices (`fnn_loadModel`) or memory mapped (`fnn_mapModel`), in which case
+ * matrices are read-only views over weight and bias values of mapped file. Mapped files are shared through page cache, so agents
+ * running the same model do not keep separate copies of its weights. Single genome of packed population file can be mapped by
+ * its index (`fnn_mapPopulationModel`).
  */
 
 #ifndef FNN_LOADER_H
@@ -44,6 +48,61 @@ extern "C" {
  */
 int32_t fnn_loadModel(const char *filename, xList *weightMatrices, xList *biasMatrices, xList *activationFunctions);
 
+/**
+ * @brief Memory mapped FNN model file
+ *
+ */
+typedef struct {
+    void *address;  // start of mapping (NULL if values had to be copied)
+    uint64_t size;  // size of mapping in bytes
+} FnnMappedModel;
+
+/**
+ * @brief Map FNN model file into memory and load list of xMatrix views over its weights and biases
+ *
+ * @param filename Path to the file containing data of the FNN model
+ * @param weightMatrices Pointer to the list for storing weight matrices
+ * @param biasMatrices Pointer to the list for storing bias matrices
+ * @param activationFunctions Pointer to the list for storing activation
+ * functions
+ * @return `FnnMappedModel*`: Mapping of the file if successful, NULL if error occurred
+ *
+ * @warning Matrices in lists do not own their data and must not be modified. They are valid only until `fnn_unmapModel` is called.
+ * Caller is still responsible for freeing the lists and their elements.
+ *
+ * @note Header and layer descriptors are validated against size of the file before any matrix is created. Files in format version
+ * 0.02 (weights not aligned in file) are loaded by copying values out of mapping into allocated matrices.
+ *
+ * @note The order of elements in the lists follow the order of inference in the
+ * FNN model.
+ *
+ */
+FnnMappedModel *fnn_mapModel(const char *filename, xList *weightMatrices, xList *biasMatrices, xList *activationFunctions);
+
+/**
+ * @brief Map genome record of packed population file into memory and load list of xMatrix views over its weights and biases
+ *
+ * @param filename Path to the packed population file
+ * @param index Index of genome record in population
+ * @param weightMatrices Pointer to the list for storing weight matrices
+ * @param biasMatrices Pointer to the list for storing bias matrices
+ * @param activationFunctions Pointer to the list for storing activation
+ * functions
+ * @return `FnnMappedModel*`: Mapping of the record if successful, NULL if error occurred
+ *
+ * @note Only pages of selected record are mapped, matrices follow same rules as matrices of `fnn_mapModel`.
+ *
+ */
+FnnMappedModel *fnn_mapPopulationModel(const char *filename, uint32_t index, xList *weightMatrices, xList *biasMatrices,
+                                       xList *activationFunctions);
+
+/**
+ * @brief Unmap FNN model file from memory
+ *
+ * @param mapping Mapping returned by `fnn_mapModel`
+ */
+void fnn_unmapModel(FnnMappedModel *mapping);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,99 @@
+/**
+ * @file fnnQuantize.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Post-training int8 quantization of FNN weights and integer inference.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Weights of every layer are quantized symmetrically to int8 with one scale per output channel (neuron). Layer inputs are
+ * quantized dynamically on each inference with one scale per layer. Dot products are accumulated in int32 and dequantized into
+ * float right before bias and activation function are applied. Integer kernels use AVX-512 VNNI (`vpdpbusd`) or AVX2
+ * (`vpmaddubsw`) where available and fall back to portable C code otherwise. All kernels produce bitwise identical results.
+ */
+
+#ifndef FNN_QUANTIZE_H
+#define FNN_QUANTIZE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnActivation.h"  // activation functions and precision modes
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xList.h"          // lists of loaded layer matrices
+
+/**
+ * @brief Quantized FNN layer
+ *
+ * @note Weights are packed as [inputsPadded / 4][outputsPadded][4] so that four consecutive inputs of one output channel occupy one
+ * 32-bit lane.
+ */
+typedef struct {
+    uint32_t inputs;             // number of layer inputs
+    uint32_t outputs;            // number of layer outputs (neurons)
+    uint32_t inputsPadded;       // inputs rounded up to multiple of 4
+    uint32_t outputsPadded;      // outputs rounded up to multiple of 16
+    int8_t *weights;             // packed quantized weights (zero padded)
+    int32_t *weightSums;         // sum of quantized weights for each output channel
+    float *scales;               // dequantization scale for each output channel
+    float *biases;               // biases for each output channel (not quantized)
+    FnnActivation_e activation;  // activation function of the layer
+} FnnQuantLayer;
+
+/**
+ * @brief Quantized FNN model
+ *
+ */
+typedef struct {
+    uint32_t layerCount;    // number of layers (without input layer)
+    FnnQuantLayer *layers;  // quantized layers in order of inference
+    int8_t *inputBuffer;    // scratch buffer for quantized layer inputs
+    int32_t *accBuffer;     // scratch buffer for integer accumulators
+    float *valueBuffer;     // scratch buffer for dequantized layer outputs
+} FnnQuantModel;
+
+/**
+ * @brief Quantize loaded FNN model to int8 weights
+ *
+ * @param weightMatrices List of weight matrices (inputs x outputs) as loaded by `fnn_loadModel`
+ * @param biasMatrices List of bias matrices (1 x outputs)
+ * @param activationFunctions List of activation function identifiers
+ * @return `FnnQuantModel*`: Pointer to quantized model, NULL on failure
+ *
+ * @note Source matrices are not modified and can be freed after quantization.
+ */
+FnnQuantModel *fnn_quantize(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions);
+
+/**
+ * @brief Free quantized FNN model from memory
+ *
+ * @param model Quantized model to free
+ */
+void fnn_quantFree(FnnQuantModel *model);
+
+/**
+ * @brief Run inference of quantized model
+ *
+ * @param model Quantized model
+ * @param input Input values (number of inputs of first layer)
+ * @param output Output values (number of outputs of last layer)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ */
+void fnn_quantForward(FnnQuantModel *model, const float *input, float *output, FnnPrecision_e precision);
+
+/**
+ * @brief Get number of bytes used by quantized weights
+ *
+ * @param model Quantized model
+ * @return `uint64_t`: Size of packed weights in bytes (including padding)
+ */
+uint64_t fnn_quantWeightBytes(const FnnQuantModel *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_QUANTIZE_H
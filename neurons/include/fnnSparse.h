@@ -0,0 +1,113 @@
+/**
+ * @file fnnSparse.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Magnitude pruning of FNN weights and sparse inference.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Weights with magnitude below pruning threshold are removed and every layer is stored in format with least work per inference:
+ * - blocked: nonzero blocks of `FNN_SPARSE_BLOCK` consecutive outputs for each input (regular, vectorizable updates)
+ * - CSR: nonzero weights of each output neuron with their input indices (best for scattered weights)
+ * - dense: pruned weights in original layout (used when density is above `FNN_SPARSE_DENSITY_THRESHOLD`)
+ * Inputs are summed in the same order in all formats, so they produce bitwise identical results for the same pruned model.
+ */
+
+#ifndef FNN_SPARSE_H
+#define FNN_SPARSE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnActivation.h"  // activation functions and precision modes
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xList.h"          // lists of loaded layer matrices
+
+#define FNN_SPARSE_BLOCK 8                 // outputs per block of blocked format
+#define FNN_SPARSE_DENSITY_THRESHOLD 0.30f  // layers with larger fraction of stored weights stay dense
+
+/**
+ * @brief Storage format of sparse layer
+ *
+ */
+typedef enum {
+    FNN_SPARSE_DENSE = 0,   // [inputs][outputs] pruned weights
+    FNN_SPARSE_CSR = 1,     // compressed rows of output neurons
+    FNN_SPARSE_BLOCKED = 2  // compressed rows of inputs with blocks of outputs
+} FnnSparseFormat_e;
+
+/**
+ * @brief Pruned FNN layer
+ *
+ */
+typedef struct {
+    uint32_t inputs;             // number of layer inputs
+    uint32_t outputs;            // number of layer outputs (neurons)
+    uint32_t nonzeros;           // number of weights left after pruning
+    FnnSparseFormat_e format;    // storage format chosen for density of layer
+    uint32_t *rowStarts;         // CSR: first value of each output (outputs + 1), blocked: first block of each input (inputs + 1)
+    uint32_t *indices;           // CSR: input of each value, blocked: first output of each block
+    float *values;               // dense: all weights, CSR: nonzero weights, blocked: `FNN_SPARSE_BLOCK` weights of each block
+    float *biases;               // biases for each output
+    FnnActivation_e activation;  // activation function of the layer
+} FnnSparseLayer;
+
+/**
+ * @brief Pruned FNN model
+ *
+ */
+typedef struct {
+    uint32_t layerCount;     // number of layers (without input layer)
+    FnnSparseLayer *layers;  // pruned layers in order of inference
+    float *accBuffer;        // scratch buffer for layer products (padded to whole blocks)
+    float *valueBuffer;      // scratch buffer for hidden layer outputs
+    uint64_t totalWeights;   // number of weights before pruning
+    uint64_t nonzeros;       // number of weights after pruning
+} FnnSparseModel;
+
+/**
+ * @brief Prune weights of loaded FNN model and convert it to sparse formats
+ *
+ * @param weightMatrices List of weight matrices (inputs x outputs) as loaded by `fnn_loadModel`
+ * @param biasMatrices List of bias matrices (1 x outputs)
+ * @param activationFunctions List of activation function identifiers
+ * @param threshold Weights with magnitude below threshold are removed (0 removes only zero weights)
+ * @return `FnnSparseModel*`: Pointer to pruned model, NULL on failure
+ *
+ * @note Source matrices are not modified and can be freed after conversion.
+ */
+FnnSparseModel *fnn_sparsify(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, float threshold);
+
+/**
+ * @brief Free pruned FNN model from memory
+ *
+ * @param model Pruned model to free
+ */
+void fnn_sparseFree(FnnSparseModel *model);
+
+/**
+ * @brief Run inference of pruned model
+ *
+ * @param model Pruned model
+ * @param input Input values (number of inputs of first layer)
+ * @param output Output values (number of outputs of last layer)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ */
+void fnn_sparseForward(FnnSparseModel *model, const float *input, float *output, FnnPrecision_e precision);
+
+/**
+ * @brief Get name of sparse layer format
+ *
+ * @param format Storage format
+ * @return `const char*`: Name of format ("dense", "csr" or "blocked")
+ */
+const char *fnn_sparseFormatName(FnnSparseFormat_e format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_SPARSE_H
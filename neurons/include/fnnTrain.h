@@ -0,0 +1,172 @@
+/**
+ * @file fnnTrain.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Supervised training of dense FNN models (backpropagation with SGD or Adam updates).
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Trainer copies weights of `FnnModel` into matrices and trains them on mini-batches of observations with known target outputs
+ * (behaviour cloning of recorded play). Forward pass keeps outputs of every layer for backward pass, and all products of both
+ * passes (layer outputs, weight gradients and propagated errors) are done by `xMatrix_gemmParallel` over whole batch. Trained
+ * values are copied back into model with `fnn_trainerExport`, after which model can be stored with `fnn_serialize`.
+ */
+
+#ifndef FNN_TRAIN_H
+#define FNN_TRAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnSerializer.h"  // FNN model descriptor
+#include "xLinear.h"        // matrix operations
+
+#define FNN_TRAIN_DEFAULT_RATE_SGD 0.05f    // default learning rate of SGD
+#define FNN_TRAIN_DEFAULT_RATE_ADAM 0.001f  // default learning rate of Adam
+#define FNN_TRAIN_ADAM_BETA1 0.9f           // decay rate of Adam first moment estimates
+#define FNN_TRAIN_ADAM_BETA2 0.999f         // decay rate of Adam second moment estimates
+#define FNN_TRAIN_ADAM_EPSILON 1e-8f        // Adam denominator offset
+#define FNN_TRAIN_BCE_CLAMP 1e-7f           // outputs are clamped to [c, 1 - c] when computing cross-entropy loss
+
+/**
+ * @brief Optimizer updating weights from gradients
+ *
+ */
+typedef enum {
+    FNN_OPTIMIZER_SGD = 0,  // plain stochastic gradient descent
+    FNN_OPTIMIZER_ADAM = 1  // Adam (adaptive moment estimation)
+} FnnOptimizer_e;
+
+/**
+ * @brief Loss function minimized by training
+ *
+ */
+typedef enum {
+    FNN_LOSS_MSE = 0,  // 0.5 * (output - target)^2 summed over outputs (any output activation)
+    FNN_LOSS_BCE = 1   // binary cross-entropy summed over outputs (sigmoid output layer only, targets in [0, 1])
+} FnnLoss_e;
+
+/**
+ * @brief Trained FNN layer with its gradients, optimizer state and batch cache
+ *
+ */
+typedef struct {
+    xMatrix *weights;            // inputs x outputs
+    xMatrix *biases;             // 1 x outputs
+    xMatrix *weightGradients;    // gradients of loss with respect to weights
+    xMatrix *biasGradients;      // gradients of loss with respect to biases
+    xMatrix *weightMoments[2];   // Adam first and second moment estimates of weights (NULL for SGD)
+    xMatrix *biasMoments[2];     // Adam first and second moment estimates of biases (NULL for SGD)
+    xMatrix *outputs;            // activated outputs of last forward pass (batch capacity x outputs)
+    xMatrix *errors;             // gradients of loss with respect to pre-activation values (batch capacity x outputs)
+    FnnActivation_e activation;  // activation function of the layer
+} FnnTrainLayer;
+
+/**
+ * @brief FNN model being trained
+ *
+ */
+typedef struct {
+    uint32_t layerCount;       // number of layers (without input layer)
+    FnnTrainLayer *layers;     // layers in order of inference
+    uint32_t batchCapacity;    // maximal number of observations per batch
+    uint32_t batchRows;        // number of observations in last forward pass
+    xMatrixView predictions;   // outputs of last layer for observations of last forward pass
+    FnnOptimizer_e optimizer;  // weight update rule
+    FnnLoss_e loss;            // minimized loss function
+    float learningRate;        // step size of updates
+    uint64_t steps;            // number of updates done (for Adam bias correction)
+} FnnTrainer;
+
+/**
+ * @brief Create trainer initialized with weights of FNN model
+ *
+ * @param model FNN model (not modified, can be freed after creating trainer)
+ * @param batchCapacity Maximal number of observations in one batch
+ * @param optimizer Weight update rule
+ * @param loss Loss function (cross-entropy requires sigmoid output layer)
+ * @param learningRate Step size of updates (0 for default of optimizer)
+ * @return `FnnTrainer*`: Pointer to trainer, NULL on failure
+ */
+FnnTrainer *fnn_trainerNew(FnnModel *model, uint32_t batchCapacity, FnnOptimizer_e optimizer, FnnLoss_e loss, float learningRate);
+
+/**
+ * @brief Free trainer from memory
+ *
+ * @param trainer Trainer to free
+ */
+void fnn_trainerFree(FnnTrainer *trainer);
+
+/**
+ * @brief Run forward pass over batch and keep outputs of every layer
+ *
+ * @param trainer Trainer
+ * @param inputs Batch of observations (rows x inputs of first layer, at most batch capacity rows)
+ * @return `xMatrix*`: Outputs of last layer (view over trainer cache, valid until next forward pass), NULL on failure
+ */
+xMatrix *fnn_trainForward(FnnTrainer *trainer, xMatrix *inputs);
+
+/**
+ * @brief Compute gradients of loss over batch of last forward pass
+ *
+ * @param trainer Trainer
+ * @param inputs Same batch of observations as passed to last `fnn_trainForward`
+ * @param targets Target outputs (rows x outputs of last layer)
+ * @param loss Mean loss per observation of batch (can be NULL)
+ * @return `int32_t`: 0 on success, -1 on failure
+ */
+int32_t fnn_trainBackward(FnnTrainer *trainer, xMatrix *inputs, xMatrix *targets, float *loss);
+
+/**
+ * @brief Update weights and biases from gradients of last backward pass
+ *
+ * @param trainer Trainer
+ */
+void fnn_trainUpdate(FnnTrainer *trainer);
+
+/**
+ * @brief Do one training step (forward pass, backward pass and update) on batch
+ *
+ * @param trainer Trainer
+ * @param inputs Batch of observations
+ * @param targets Target outputs
+ * @param loss Mean loss per observation of batch before update (can be NULL)
+ * @return `int32_t`: 0 on success, -1 on failure
+ */
+int32_t fnn_trainBatch(FnnTrainer *trainer, xMatrix *inputs, xMatrix *targets, float *loss);
+
+/**
+ * @brief Copy trained weights and biases back into FNN model
+ *
+ * @param trainer Trainer
+ * @param model FNN model trainer was created from (or model of same architecture)
+ * @return `int32_t`: 0 on success, -1 if architecture does not match
+ */
+int32_t fnn_trainerExport(FnnTrainer *trainer, FnnModel *model);
+
+/**
+ * @brief Get optimizer from its name
+ *
+ * @param name Optimizer name ("sgd" or "adam")
+ * @param optimizer Output optimizer
+ * @return `int32_t`: 0 on success, -1 if name is unknown
+ */
+int32_t fnn_optimizerFromName(const char *name, FnnOptimizer_e *optimizer);
+
+/**
+ * @brief Get loss function from its name
+ *
+ * @param name Loss function name ("mse" or "bce")
+ * @param loss Output loss function
+ * @return `int32_t`: 0 on success, -1 if name is unknown
+ */
+int32_t fnn_lossFromName(const char *name, FnnLoss_e *loss);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FNN_TRAIN_H
@@ -21,6 +21,14 @@
  * 0x04 - standalone mode (+2 parameters)
  * 0x08 - managed mode (+3 parameters)
  * 0x10 - load config file (+1 parameter)
+ * 0x20 - activation precision mode (+1 parameter)
+ * 0x40 - weight storage format (+1 parameter)
+ * 0x80 - calibration of reduced precision weights (+1 parameter)
+ * 0x100 - thread count for batched work (+1 parameter)
+ * 0x200 - magnitude pruning of weights (+1 parameter)
+ * 0x400 - serve many game instances (+1 parameter)
+ * 0x800 - deterministic float kernels
+ * 0x1000 - genome index in packed population file (+1 parameter)
  */
 enum cmdFlag_e {
     CMD_FLAG_NONE = 0x00,
@@ -28,7 +36,15 @@ enum cmdFlag_e {
     CMD_FLAG_VERSION = 0x02,
     CMD_FLAG_STANDALONE = 0x04,
     CMD_FLAG_MANAGED = 0x08,
-    CMD_FLAG_LOADCFG = 0x10
+    CMD_FLAG_LOADCFG = 0x10,
+    CMD_FLAG_PRECISION = 0x20,
+    CMD_FLAG_WEIGHTS = 0x40,
+    CMD_FLAG_CALIBRATE = 0x80,
+    CMD_FLAG_THREADS = 0x100,
+    CMD_FLAG_PRUNE = 0x200,
+    CMD_FLAG_SERVE = 0x400,
+    CMD_FLAG_DETERMINISTIC = 0x800,
+    CMD_FLAG_GENOME = 0x1000
 };
 
 /* Runtime flags of neural network program:
@@ -38,8 +54,18 @@ enum cmdFlag_e {
  */
 enum neuronsRuntime_e { RUNTIME_NONE = 0x00, RUNTIME_RUNNING = 0x01, RUNTIME_PAUSED = 0x02, RUNTIME_EXIT = 0x04 };
 
+/* Weight storage formats used for inference:
+ * 0 - single precision float (reference)
+ * 1 - 8-bit integer with per neuron scales
+ * 2 - IEEE half precision float
+ * 3 - bfloat16
+ */
+enum weightFormat_e { WEIGHTS_FP32 = 0, WEIGHTS_INT8 = 1, WEIGHTS_FP16 = 2, WEIGHTS_BF16 = 3 };
+
 // ------------------------------------------------------------------
 // neural network constant definitions
-#define ACTIVATION_THRESHOLD 0.70f  // threshold for binary activation of network output
+#define ACTIVATION_THRESHOLD 0.70f     // threshold for binary activation of network output
+#define PRUNE_CALIBRATION_SAMPLES 10000  // samples used to report agreement of pruned model if calibration is not requested
+#define STATS_PUBLISH_PERIOD_NS 500000000ULL  // time between publishing inference statistics to shared state (0.5 s)
 
 #endif  // MAIN_H
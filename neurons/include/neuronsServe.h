@@ -0,0 +1,59 @@
+/**
+ * @file neuronsServe.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Serving many game instances from one neural network process.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Server connects to shared memory of every instance listed in instance file and loads their models (instances listing the same
+ * model file or the same genome of packed population file share one mapping). Instances are split between small number of
+ * serving threads. Each thread sleeps on futexes of its instances' shared outputs (see `sm_waitSharedOutputs`) and, once woken,
+ * collects all pending observations and runs them through one batched forward pass per model, so instances playing the same model
+ * are evaluated together. Inference statistics of every instance are published to its shared state as by agent in managed mode.
+ *
+ * Serve mode is standalone tool, games and instance file are set up by its user. Manager does not use it and starts one agent
+ * process per running game.
+ */
+
+#ifndef NEURONS_SERVE_H
+#define NEURONS_SERVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fnnActivation.h"  // activation precision modes
+
+#define SERVE_INSTANCES_PER_THREAD 16    // instances handled by one serving thread if thread count is not given
+#define SERVE_WAIT_TIMEOUT_NS 10000000L  // longest sleep between checks of exit requests (10 ms)
+#define SERVE_MAX_LINE 4096              // maximal length of instance file line
+#define SERVE_NO_GENOME UINT32_MAX       // genome index of instance whose model is single model file
+
+/**
+ * @brief Serve all instances listed in instance file until each of them is told to exit (or server is stopped).
+ *
+ * Every non-empty line of instance file describes one instance as `<input> <output> <state> <model> [<genome>]` (shared memory
+ * names as in managed mode followed by model file path). If genome index is given, model file is packed population file (for
+ * example checkpoint `genX.fnnp` of manager) and instance plays genome of that index. Lines starting with '#' are ignored.
+ *
+ * @param instanceFilename Path to instance file
+ * @param threadCount Number of serving threads (0 for one per `SERVE_INSTANCES_PER_THREAD` instances, limited by CPU count)
+ * @param precision Precision mode used for sigmoid and tanh activations
+ * @return `int32_t`: 0 on success, -1 on failure
+ */
+int32_t neuronsServe_run(const char *instanceFilename, uint32_t threadCount, FnnPrecision_e precision);
+
+/**
+ * @brief Request all serving threads to exit (safe to call from signal handler).
+ *
+ */
+void neuronsServe_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NEURONS_SERVE_H
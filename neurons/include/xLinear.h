@@ -2,8 +2,8 @@
  * @file xLinear.h
  * @author 0xDontCare (https://github.com/0xDontCare)
  * @brief Basic linear algebra library for C.
- * @version 0.5
- * @date 05.03.2024.
+ * @version 0.7
+ * @date 17.10.2026.
  *
  * @copyright All rights reserved (c) 2024
  *
@@ -18,12 +18,56 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Minimal number of multiply-add operations (rows * cols * inner dimension) for which matrix product uses cache-blocked
+ * kernel. Smaller products use simple row-streaming loop which has no packing overhead.
+ *
+ */
+#define XLINEAR_GEMM_THRESHOLD (32u * 32u * 32u)
+
+/**
+ * @brief Minimal number of multiply-add operations for which `xMatrix_dotParallel` and `xMatrix_gemmParallel` use thread pool.
+ *
+ */
+#define XLINEAR_PARALLEL_GEMM_THRESHOLD (128u * 128u * 128u)
+
+/**
+ * @brief Minimal number of matrix elements for which `xMatrix_addParallel` and `xMatrix_scaleParallel` use thread pool.
+ *
+ */
+#define XLINEAR_PARALLEL_THRESHOLD (1u << 18)
+
+/**
+ * @brief Operation applied to matrix operand of `xMatrix_gemm`
+ *
+ */
+typedef enum {
+    XMATRIX_NORMAL = 0,    // matrix is used as is
+    XMATRIX_TRANSPOSE = 1  // matrix is used transposed (without modifying it)
+} xMatrixOp_e;
+
+/**
+ * @brief Alignment of matrix storage in bytes (cache line, widest SIMD register)
+ *
+ */
+#define XLINEAR_ALIGNMENT 64
+
 typedef struct {
-    uint32_t rows;  // number of rows
-    uint32_t cols;  // number of columns
-    float *data;    // matrix data
+    uint32_t rows;    // number of rows
+    uint32_t cols;    // number of columns
+    uint32_t stride;  // distance between starts of consecutive rows in elements (leading dimension, at least cols)
+    uint8_t owner;    // matrix owns its data (views only alias storage of another matrix or buffer)
+    float *data;      // matrix data (row-major, aligned to XLINEAR_ALIGNMENT if owned)
 } xMatrix;
 
+/**
+ * @brief Non-owning matrix aliasing storage of parent matrix or external buffer.
+ *
+ * Views are plain values created by `xMatrix_view*` functions and can be passed (by address) to every function taking matrix.
+ * Writes through view modify parent storage. Views must not outlive their parent and must not be passed to `xMatrix_free`.
+ */
+typedef xMatrix xMatrixView;
+
 // constructor/destructor
 // ----------------------------------------------------------------------------------------------
 
@@ -34,6 +78,8 @@ typedef struct {
  * @param cols Number of columns.
  * @return Pointer to allocated matrix. NULL if allocation fails or invalid
  * dimensions.
+ *
+ * @note Storage is zero initialized, aligned to `XLINEAR_ALIGNMENT` bytes and contiguous (stride equals number of columns).
  */
 xMatrix *xMatrix_new(uint32_t rows, uint32_t cols);
 
@@ -42,7 +88,7 @@ xMatrix *xMatrix_new(uint32_t rows, uint32_t cols);
  *
  * @param mat Pointer to matrix.
  *
- * @note Make sure to remove dangling pointers to freed matrix.
+ * @note Make sure to remove dangling pointers to freed matrix (including views of it).
  */
 void xMatrix_free(xMatrix *mat);
 
@@ -88,6 +134,50 @@ xMatrix *xMatrix_row(xMatrix *mat, uint32_t rowIndex);
  */
 xMatrix *xMatrix_col(xMatrix *mat, uint32_t colIndex);
 
+// view functions (do not allocate memory, returned views alias existing storage)
+// ----------------------------------------------------------------------------------------------
+
+/**
+ * @brief Create view over external buffer (for example weights inside of loaded model file).
+ *
+ * @param data Pointer to first element.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param stride Distance between starts of consecutive rows in elements (at least cols).
+ * @return Matrix view. Empty view (NULL data, zero dimensions) if arguments are invalid.
+ */
+xMatrixView xMatrix_view(float *data, uint32_t rows, uint32_t cols, uint32_t stride);
+
+/**
+ * @brief Create view of selected range in matrix (without copying).
+ *
+ * @param mat Pointer to matrix.
+ * @param row_start Starting index of slice row (inclusive).
+ * @param row_end Ending index of slice row (exclusive).
+ * @param col_start Starting index of slice column (inclusive).
+ * @param col_end Ending index of slice column (exclusive).
+ * @return Matrix view. Empty view (NULL data, zero dimensions) if indices are invalid.
+ */
+xMatrixView xMatrix_viewSlice(xMatrix *mat, uint32_t row_start, uint32_t row_end, uint32_t col_start, uint32_t col_end);
+
+/**
+ * @brief Create view of single matrix row (without copying).
+ *
+ * @param mat Pointer to matrix.
+ * @param rowIndex Index of row.
+ * @return Row view (1 x cols). Empty view if index is invalid.
+ */
+xMatrixView xMatrix_viewRow(xMatrix *mat, uint32_t rowIndex);
+
+/**
+ * @brief Create view of single matrix column (without copying).
+ *
+ * @param mat Pointer to matrix.
+ * @param colIndex Index of column.
+ * @return Column view (rows x 1, stride of parent). Empty view if index is invalid.
+ */
+xMatrixView xMatrix_viewCol(xMatrix *mat, uint32_t colIndex);
+
 // non-instantiating functions (does not allocate memory for returned values)
 // ----------------------------------------------------------------------------------------------
 
@@ -129,15 +219,88 @@ void xMatrix_sub(xMatrix *res, xMatrix *mat1, xMatrix *mat2);
  * @warning Result matrix can not have same pointer as input matrices (due to in-place operations).
  *
  * @note Does nothing if any matrix is NULL or dimensions are invalid.
+ *
+ * @note Products above `XLINEAR_GEMM_THRESHOLD` are computed with cache-blocked, register-tiled kernel (see `xMatrix_gemm`).
  */
 void xMatrix_dot(xMatrix *res, xMatrix *mat1, xMatrix *mat2);
 
+/**
+ * @brief General matrix multiplication (res = alpha * op(mat1) * op(mat2) + beta * res).
+ *
+ * @param res Pointer to result matrix.
+ * @param mat1 Pointer to first matrix.
+ * @param op1 Operation applied to first matrix.
+ * @param mat2 Pointer to second matrix.
+ * @param op2 Operation applied to second matrix.
+ * @param alpha Scalar multiplying matrix product.
+ * @param beta Scalar multiplying previous result matrix values (if 0, previous values are ignored).
+ *
+ * @note Result matrix must be of size (op(mat1)->rows x op(mat2)->cols).
+ *
+ * @note Large products are split into blocks fitting L2 (first operand) and L1 (second operand) cache, operands are packed into
+ * contiguous panels and multiplied by 6x16 register-tiled micro-kernel (AVX-512, AVX2 or portable C, chosen at runtime).
+ *
+ * @warning Result matrix can not have same pointer as input matrices (or overlap them through views).
+ *
+ * @note Does nothing if any matrix is NULL or dimensions are invalid.
+ */
+void xMatrix_gemm(xMatrix *res, xMatrix *mat1, xMatrixOp_e op1, xMatrix *mat2, xMatrixOp_e op2, float alpha, float beta);
+
+// parallel functions (split work across process-wide thread pool, see xThreadPool.h)
+// ----------------------------------------------------------------------------------------------
+
+/**
+ * @brief Multiply two matrices using thread pool (same semantics as `xMatrix_dot`).
+ *
+ * @param res Pointer to result matrix.
+ * @param mat1 Pointer to first matrix.
+ * @param mat2 Pointer to second matrix.
+ *
+ * @note Result is split into bands of rows (or columns for wide results), one per pool thread. Products below
+ * `XLINEAR_PARALLEL_GEMM_THRESHOLD` run on calling thread.
+ */
+void xMatrix_dotParallel(xMatrix *res, xMatrix *mat1, xMatrix *mat2);
+
+/**
+ * @brief General matrix multiplication using thread pool (same semantics as `xMatrix_gemm`).
+ *
+ * @param res Pointer to result matrix.
+ * @param mat1 Pointer to first matrix.
+ * @param op1 Operation applied to first matrix.
+ * @param mat2 Pointer to second matrix.
+ * @param op2 Operation applied to second matrix.
+ * @param alpha Scalar multiplying matrix product.
+ * @param beta Scalar multiplying previous result matrix values (if 0, previous values are ignored).
+ */
+void xMatrix_gemmParallel(xMatrix *res, xMatrix *mat1, xMatrixOp_e op1, xMatrix *mat2, xMatrixOp_e op2, float alpha, float beta);
+
+/**
+ * @brief Add two matrices using thread pool (same semantics as `xMatrix_add`).
+ *
+ * @param res Pointer to result matrix.
+ * @param mat1 Pointer to first matrix.
+ * @param mat2 Pointer to second matrix.
+ *
+ * @note Matrices below `XLINEAR_PARALLEL_THRESHOLD` elements are processed on calling thread.
+ */
+void xMatrix_addParallel(xMatrix *res, xMatrix *mat1, xMatrix *mat2);
+
+/**
+ * @brief Scale matrix by scalar in-place using thread pool (same semantics as `xMatrix_scale`).
+ *
+ * @param mat Pointer to matrix.
+ * @param scale Scalar value to scale matrix by.
+ *
+ * @note Matrices below `XLINEAR_PARALLEL_THRESHOLD` elements are processed on calling thread.
+ */
+void xMatrix_scaleParallel(xMatrix *mat, float scale);
+
 /**
  * @brief Transpose matrix in-place.
  *
  * @param mat Pointer to matrix.
  *
- * @note Does nothing if matrix is NULL.
+ * @note Does nothing if matrix is NULL or view.
  */
 void xMatrix_transpose(xMatrix *mat);
 
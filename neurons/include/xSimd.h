@@ -0,0 +1,113 @@
+/**
+ * @file xSimd.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Runtime detection and selection of SIMD instruction set used by numeric kernels.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ * Kernels are compiled for every supported instruction set (using function target attributes) and one of them is picked at runtime
+ * based on what the host CPU supports. All functions have prefix `xSimd_`.
+ *
+ * Vector kernels normally use fused multiply-add, so the same float computation rounds differently on each SIMD level. In
+ * deterministic mode (`xSimd_setDeterministic`) every float kernel rounds each multiplication and addition separately and sums
+ * products of each output in the same order as portable kernel, so results are bitwise identical on every SIMD level and thread
+ * count (at some throughput cost). Portable C code of the project is compiled without floating point contraction for the same
+ * reason.
+ */
+
+#ifndef XSIMD_H
+#define XSIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define XSIMD_X86 1  // x86 specific kernels are compiled in
+#else
+#define XSIMD_X86 0
+#endif
+
+/**
+ * @brief SIMD instruction set levels (ordered from least to most capable)
+ *
+ */
+typedef enum {
+    XSIMD_SCALAR = 0,  // portable C code (no explicit vectorization)
+    XSIMD_AVX2 = 1,    // AVX2 + FMA, 8 float lanes
+    XSIMD_AVX512 = 2   // AVX-512 F/BW/DQ/VL, 16 float lanes
+} xSimdLevel_e;
+
+/**
+ * @brief Optional instruction set extensions (used on top of SIMD level)
+ *
+ */
+typedef enum {
+    XSIMD_FEATURE_VNNI = 0,  // AVX-512 vector neural network instructions (8-bit dot products)
+    XSIMD_FEATURE_F16C = 1   // half precision conversion instructions
+} xSimdFeature_e;
+
+/**
+ * @brief Detect highest SIMD level supported by host CPU.
+ *
+ * @return Highest supported SIMD level (XSIMD_SCALAR on non-x86 hosts).
+ */
+xSimdLevel_e xSimd_detect(void);
+
+/**
+ * @brief Get SIMD level currently used by kernels.
+ *
+ * @return Active SIMD level (detected level unless overridden with `xSimd_setLevel`).
+ */
+xSimdLevel_e xSimd_level(void);
+
+/**
+ * @brief Override SIMD level used by kernels.
+ *
+ * @param level Requested SIMD level.
+ *
+ * @note Level is clamped to the highest level supported by host CPU.
+ */
+void xSimd_setLevel(xSimdLevel_e level);
+
+/**
+ * @brief Check if optional instruction set extension can be used by kernels.
+ *
+ * @param feature Extension to check.
+ * @return 1 if host CPU supports the extension and active SIMD level allows its use, 0 otherwise.
+ *
+ * @note VNNI requires AVX-512 level, F16C requires at least AVX2 level.
+ */
+int xSimd_supports(xSimdFeature_e feature);
+
+/**
+ * @brief Get human readable name of SIMD level.
+ *
+ * @param level SIMD level.
+ * @return Constant C string with level name.
+ */
+const char *xSimd_levelName(xSimdLevel_e level);
+
+/**
+ * @brief Enable or disable deterministic mode of float kernels.
+ *
+ * @param enabled 1 for results independent of SIMD level and thread count, 0 for fastest kernels (default).
+ *
+ * @note Kernels bound to model on conversion (specialized and reduced precision forward functions) are affected immediately.
+ */
+void xSimd_setDeterministic(int enabled);
+
+/**
+ * @brief Check if deterministic mode of float kernels is enabled.
+ *
+ * @return 1 if deterministic mode is enabled, 0 otherwise.
+ */
+int xSimd_deterministic(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // XSIMD_H
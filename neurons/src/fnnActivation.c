@@ -0,0 +1,238 @@
+#include "fnnActivation.h"
+#include <math.h>           // libm functions (expf, tanhf) for exact precision mode
+#include <stdint.h>         // universal integer types
+#include "commonUtility.h"  // C string comparison (for parsing precision names)
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xSimd.h"          // SIMD level detection and dispatch
+#if XSIMD_X86
+#include <immintrin.h>  // x86 SIMD intrinsics
+#endif
+
+// ----------------------------------------------------------------------------------------------
+// rational approximation of tanh(x) = x * P(x^2) / Q(x^2) on [-TANH_CLAMP, TANH_CLAMP] (outside of that range tanh(x) rounds to
+// +-1 in single precision)
+
+#define TANH_CLAMP 7.90531110763549805f
+#define TANH_ALPHA_1 4.89352455891786e-03f
+#define TANH_ALPHA_3 6.37261928875436e-04f
+#define TANH_ALPHA_5 1.48572235717979e-05f
+#define TANH_ALPHA_7 5.12229709037114e-08f
+#define TANH_ALPHA_9 -8.60467152213735e-11f
+#define TANH_ALPHA_11 2.00018790482477e-13f
+#define TANH_ALPHA_13 -2.76076847742355e-16f
+#define TANH_BETA_0 4.89352518554385e-03f
+#define TANH_BETA_2 2.26843463243900e-03f
+#define TANH_BETA_4 1.18534705686654e-04f
+#define TANH_BETA_6 1.19825839466702e-06f
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static inline float fastTanh(float x);
+static void activateExact(float *values, uint32_t count, FnnActivation_e activation);
+static void tanhFastScalar(float *values, uint32_t count, float inScale, float outScale, float outOffset);
+#if XSIMD_X86
+static void tanhFastAvx2(float *values, uint32_t count, float inScale, float outScale, float outOffset, int fused);
+static void tanhFastAvx512(float *values, uint32_t count, float inScale, float outScale, float outOffset, int fused);
+#endif
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+void fnn_activate(float *values, uint32_t count, FnnActivation_e activation, FnnPrecision_e precision)
+{
+    // pointer checking
+    if (values == NULL || count == 0) {
+        return;
+    }
+
+    // precision independent activations
+    if (activation == FNN_ACTIVATION_RELU) {
+        for (uint32_t i = 0; i < count; i++) {
+            values[i] = (values[i] > 0.0f) ? values[i] : 0.0f;
+        }
+        return;
+    } else if (activation != FNN_ACTIVATION_SIGMOID && activation != FNN_ACTIVATION_TANH) {
+        return;
+    }
+
+    if (precision == FNN_PRECISION_EXACT) {
+        activateExact(values, count, activation);
+        return;
+    }
+
+    // sigmoid(x) = 0.5 + 0.5 * tanh(0.5 * x), tanh(x) = 0.0 + 1.0 * tanh(1.0 * x)
+    float inScale = (activation == FNN_ACTIVATION_SIGMOID) ? 0.5f : 1.0f;
+    float outScale = inScale;
+    float outOffset = (activation == FNN_ACTIVATION_SIGMOID) ? 0.5f : 0.0f;
+
+    switch (xSimd_level()) {
+#if XSIMD_X86
+    case XSIMD_AVX512:
+        tanhFastAvx512(values, count, inScale, outScale, outOffset, !xSimd_deterministic());
+        break;
+    case XSIMD_AVX2:
+        tanhFastAvx2(values, count, inScale, outScale, outOffset, !xSimd_deterministic());
+        break;
+#endif
+    default:
+        tanhFastScalar(values, count, inScale, outScale, outOffset);
+        break;
+    }
+}
+
+int32_t fnn_precisionFromName(const char *name, FnnPrecision_e *precision)
+{
+    if (name == NULL || precision == NULL) {
+        return -1;
+    }
+
+    if (cu_CStringCompare(name, "exact") == 0) {
+        *precision = FNN_PRECISION_EXACT;
+    } else if (cu_CStringCompare(name, "fast") == 0) {
+        *precision = FNN_PRECISION_FAST;
+    } else {
+        return -1;
+    }
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// single lane evaluation of tanh approximation (also used for tails of vector kernels)
+static inline float fastTanh(float x)
+{
+    x = fminf(fmaxf(x, -TANH_CLAMP), TANH_CLAMP);
+    float x2 = x * x;
+
+    float p = x2 * TANH_ALPHA_13 + TANH_ALPHA_11;
+    p = x2 * p + TANH_ALPHA_9;
+    p = x2 * p + TANH_ALPHA_7;
+    p = x2 * p + TANH_ALPHA_5;
+    p = x2 * p + TANH_ALPHA_3;
+    p = x2 * p + TANH_ALPHA_1;
+    p = x * p;
+
+    float q = x2 * TANH_BETA_6 + TANH_BETA_4;
+    q = x2 * q + TANH_BETA_2;
+    q = x2 * q + TANH_BETA_0;
+
+    return p / q;
+}
+
+// libm reference evaluation
+static void activateExact(float *values, uint32_t count, FnnActivation_e activation)
+{
+    if (activation == FNN_ACTIVATION_SIGMOID) {
+        for (uint32_t i = 0; i < count; i++) {
+            values[i] = 1.0f / (1.0f + expf(-values[i]));
+        }
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            values[i] = tanhf(values[i]);
+        }
+    }
+}
+
+// portable fast kernel (branch free so compiler can auto-vectorize it for baseline instruction set)
+static void tanhFastScalar(float *values, uint32_t count, float inScale, float outScale, float outOffset)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        values[i] = fastTanh(values[i] * inScale) * outScale + outOffset;
+    }
+}
+
+#if XSIMD_X86
+// multiply-add of vector kernels (fused, or rounded after multiplication and after addition like portable kernel)
+#define TANH_MADD256(FUSED, A, B, C) ((FUSED) ? _mm256_fmadd_ps(A, B, C) : _mm256_add_ps(_mm256_mul_ps(A, B), C))
+#define TANH_MADD512(FUSED, A, B, C) ((FUSED) ? _mm512_fmadd_ps(A, B, C) : _mm512_add_ps(_mm512_mul_ps(A, B), C))
+
+// 8 lanes at a time, remaining lanes are computed using scalar approximation
+__attribute__((target("avx2,fma"), always_inline)) static inline void tanhFastAvx2Body(float *values, uint32_t count,
+                                                                                      float inScale, float outScale,
+                                                                                      float outOffset, const int fused)
+{
+    const __m256 vInScale = _mm256_set1_ps(inScale);
+    const __m256 vOutScale = _mm256_set1_ps(outScale);
+    const __m256 vOutOffset = _mm256_set1_ps(outOffset);
+    const __m256 vClampHi = _mm256_set1_ps(TANH_CLAMP);
+    const __m256 vClampLo = _mm256_set1_ps(-TANH_CLAMP);
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_mul_ps(_mm256_loadu_ps(values + i), vInScale);
+        x = _mm256_min_ps(_mm256_max_ps(x, vClampLo), vClampHi);
+        __m256 x2 = _mm256_mul_ps(x, x);
+
+        __m256 p = TANH_MADD256(fused, x2, _mm256_set1_ps(TANH_ALPHA_13), _mm256_set1_ps(TANH_ALPHA_11));
+        p = TANH_MADD256(fused, x2, p, _mm256_set1_ps(TANH_ALPHA_9));
+        p = TANH_MADD256(fused, x2, p, _mm256_set1_ps(TANH_ALPHA_7));
+        p = TANH_MADD256(fused, x2, p, _mm256_set1_ps(TANH_ALPHA_5));
+        p = TANH_MADD256(fused, x2, p, _mm256_set1_ps(TANH_ALPHA_3));
+        p = TANH_MADD256(fused, x2, p, _mm256_set1_ps(TANH_ALPHA_1));
+        p = _mm256_mul_ps(x, p);
+
+        __m256 q = TANH_MADD256(fused, x2, _mm256_set1_ps(TANH_BETA_6), _mm256_set1_ps(TANH_BETA_4));
+        q = TANH_MADD256(fused, x2, q, _mm256_set1_ps(TANH_BETA_2));
+        q = TANH_MADD256(fused, x2, q, _mm256_set1_ps(TANH_BETA_0));
+
+        _mm256_storeu_ps(values + i, TANH_MADD256(fused, _mm256_div_ps(p, q), vOutScale, vOutOffset));
+    }
+    tanhFastScalar(values + i, count - i, inScale, outScale, outOffset);
+}
+
+__attribute__((target("avx2,fma"))) static void tanhFastAvx2(float *values, uint32_t count, float inScale, float outScale,
+                                                              float outOffset, int fused)
+{
+    if (fused) {
+        tanhFastAvx2Body(values, count, inScale, outScale, outOffset, 1);
+    } else {
+        tanhFastAvx2Body(values, count, inScale, outScale, outOffset, 0);
+    }
+}
+
+// 16 lanes at a time, tail is handled with masked loads and stores
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"), always_inline)) static inline void tanhFastAvx512Body(
+    float *values, uint32_t count, float inScale, float outScale, float outOffset, const int fused)
+{
+    const __m512 vInScale = _mm512_set1_ps(inScale);
+    const __m512 vOutScale = _mm512_set1_ps(outScale);
+    const __m512 vOutOffset = _mm512_set1_ps(outOffset);
+    const __m512 vClampHi = _mm512_set1_ps(TANH_CLAMP);
+    const __m512 vClampLo = _mm512_set1_ps(-TANH_CLAMP);
+
+    for (uint32_t i = 0; i < count; i += 16) {
+        __mmask16 mask = (count - i >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << (count - i)) - 1u);
+        __m512 x = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, values + i), vInScale);
+        x = _mm512_min_ps(_mm512_max_ps(x, vClampLo), vClampHi);
+        __m512 x2 = _mm512_mul_ps(x, x);
+
+        __m512 p = TANH_MADD512(fused, x2, _mm512_set1_ps(TANH_ALPHA_13), _mm512_set1_ps(TANH_ALPHA_11));
+        p = TANH_MADD512(fused, x2, p, _mm512_set1_ps(TANH_ALPHA_9));
+        p = TANH_MADD512(fused, x2, p, _mm512_set1_ps(TANH_ALPHA_7));
+        p = TANH_MADD512(fused, x2, p, _mm512_set1_ps(TANH_ALPHA_5));
+        p = TANH_MADD512(fused, x2, p, _mm512_set1_ps(TANH_ALPHA_3));
+        p = TANH_MADD512(fused, x2, p, _mm512_set1_ps(TANH_ALPHA_1));
+        p = _mm512_mul_ps(x, p);
+
+        __m512 q = TANH_MADD512(fused, x2, _mm512_set1_ps(TANH_BETA_6), _mm512_set1_ps(TANH_BETA_4));
+        q = TANH_MADD512(fused, x2, q, _mm512_set1_ps(TANH_BETA_2));
+        q = TANH_MADD512(fused, x2, q, _mm512_set1_ps(TANH_BETA_0));
+
+        _mm512_mask_storeu_ps(values + i, mask, TANH_MADD512(fused, _mm512_div_ps(p, q), vOutScale, vOutOffset));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static void tanhFastAvx512(float *values, uint32_t count,
+                                                                                          float inScale, float outScale,
+                                                                                          float outOffset, int fused)
+{
+    if (fused) {
+        tanhFastAvx512Body(values, count, inScale, outScale, outOffset, 1);
+    } else {
+        tanhFastAvx512Body(values, count, inScale, outScale, outOffset, 0);
+    }
+}
+#endif
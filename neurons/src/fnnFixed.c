@@ -0,0 +1,243 @@
+#include "fnnFixed.h"
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // fprintf (for error messages)
+#include <stdlib.h>         // aligned_alloc, free
+#include <string.h>         // memcpy
+#include "fnnActivation.h"  // activation functions
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xLinear.h"        // xMatrix objects of loaded model
+#include "xList.h"          // lists of loaded layer matrices
+#include "xSimd.h"          // SIMD level of forward function
+
+#define FIXED_MAX_LAYERS 3  // maximal number of layers (without input layer) of specialized architecture
+
+// full unrolling of loops over inputs (loops over outputs are left to vectorizer, early full unrolling would keep them scalar)
+#if defined(__clang__)
+#define FIXED_UNROLL _Pragma("clang loop unroll(full)")
+#elif defined(__GNUC__)
+#define FIXED_UNROLL _Pragma("GCC unroll 64")
+#else
+#define FIXED_UNROLL
+#endif
+
+typedef void (*fixedForwardFn)(const float *parameters, const float *input, float *output, FnnPrecision_e precision);
+
+/**
+ * @brief Specialized architecture descriptor
+ *
+ */
+typedef struct {
+    const char *name;
+    uint32_t layerCount;                            // number of layers (without input layer)
+    uint32_t neuronCounts[FIXED_MAX_LAYERS + 1];    // neuron counts including input layer
+    FnnActivation_e activations[FIXED_MAX_LAYERS];  // activation function of each layer
+    fixedForwardFn forward[3];                      // forward function for each SIMD level (xSimdLevel_e)
+} fixedArchitecture;
+
+// ----------------------------------------------------------------------------------------------
+// generic layer (specialized by inlining with constant arguments)
+
+static inline __attribute__((always_inline)) void fixedLayer(const float *restrict input, const float *restrict weights,
+                                                             const float *restrict biases, float *restrict output,
+                                                             const uint32_t inputs, const uint32_t outputs,
+                                                             const FnnActivation_e activation, FnnPrecision_e precision)
+{
+    // product (summation order of generic path: inputs in order, bias added last)
+    for (uint32_t j = 0; j < outputs; j++) {
+        output[j] = 0.0f;
+    }
+    FIXED_UNROLL
+    for (uint32_t k = 0; k < inputs; k++) {
+        const float value = input[k];
+        for (uint32_t j = 0; j < outputs; j++) {
+            output[j] += value * weights[k * outputs + j];
+        }
+    }
+    for (uint32_t j = 0; j < outputs; j++) {
+        output[j] += biases[j];
+    }
+
+    // activation (ReLU and pass-through are inlined, others share vectorized implementation)
+    if (activation == FNN_ACTIVATION_RELU) {
+        for (uint32_t j = 0; j < outputs; j++) {
+            output[j] = (output[j] > 0.0f) ? output[j] : 0.0f;
+        }
+    } else if (activation != FNN_ACTIVATION_NONE) {
+        fnn_activate(output, outputs, activation, precision);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+// generated forward functions (one variant per SIMD level, selected when model is bound)
+
+#define FIXED_NAME_1(IN, H, OUT, ACT_H, ACT_O, LEVEL) fixedForward_##IN##_##H##_##OUT##_##ACT_H##_##ACT_O##_##LEVEL
+#define FIXED_NAME_2(IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O, LEVEL) \
+    fixedForward_##IN##_##H1##_##H2##_##OUT##_##ACT_H1##_##ACT_H2##_##ACT_O##_##LEVEL
+
+#define FIXED_DEFINE_1(LEVEL, TARGET, IN, H, OUT, ACT_H, ACT_O)                                                                  \
+    TARGET static void FIXED_NAME_1(IN, H, OUT, ACT_H, ACT_O, LEVEL)(const float *parameters, const float *input, float *output, \
+                                                                     FnnPrecision_e precision)                                   \
+    {                                                                                                                            \
+        float hidden[H];                                                                                                         \
+        const float *w1 = parameters, *b1 = w1 + (IN) * (H);                                                                     \
+        const float *w2 = b1 + (H), *b2 = w2 + (H) * (OUT);                                                                      \
+        fixedLayer(input, w1, b1, hidden, IN, H, FNN_ACTIVATION_##ACT_H, precision);                                            \
+        fixedLayer(hidden, w2, b2, output, H, OUT, FNN_ACTIVATION_##ACT_O, precision);                                          \
+    }
+
+#define FIXED_DEFINE_2(LEVEL, TARGET, IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O)                                                    \
+    TARGET static void FIXED_NAME_2(IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O, LEVEL)(const float *parameters, const float *input,  \
+                                                                                   float *output, FnnPrecision_e precision)      \
+    {                                                                                                                            \
+        float hidden1[H1], hidden2[H2];                                                                                          \
+        const float *w1 = parameters, *b1 = w1 + (IN) * (H1);                                                                    \
+        const float *w2 = b1 + (H1), *b2 = w2 + (H1) * (H2);                                                                     \
+        const float *w3 = b2 + (H2), *b3 = w3 + (H2) * (OUT);                                                                    \
+        fixedLayer(input, w1, b1, hidden1, IN, H1, FNN_ACTIVATION_##ACT_H1, precision);                                         \
+        fixedLayer(hidden1, w2, b2, hidden2, H1, H2, FNN_ACTIVATION_##ACT_H2, precision);                                       \
+        fixedLayer(hidden2, w3, b3, output, H2, OUT, FNN_ACTIVATION_##ACT_O, precision);                                        \
+    }
+
+#if XSIMD_X86
+#define FIXED_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define FIXED_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+#define FIXED_FORWARD_1(...)                             \
+    FIXED_DEFINE_1(Scalar, , __VA_ARGS__)                \
+    FIXED_DEFINE_1(Avx2, FIXED_TARGET_AVX2, __VA_ARGS__) \
+    FIXED_DEFINE_1(Avx512, FIXED_TARGET_AVX512, __VA_ARGS__)
+#define FIXED_FORWARD_2(...)                             \
+    FIXED_DEFINE_2(Scalar, , __VA_ARGS__)                \
+    FIXED_DEFINE_2(Avx2, FIXED_TARGET_AVX2, __VA_ARGS__) \
+    FIXED_DEFINE_2(Avx512, FIXED_TARGET_AVX512, __VA_ARGS__)
+#define FIXED_LEVEL_AVX2 Avx2
+#define FIXED_LEVEL_AVX512 Avx512
+#else
+#define FIXED_FORWARD_1(...) FIXED_DEFINE_1(Scalar, , __VA_ARGS__)
+#define FIXED_FORWARD_2(...) FIXED_DEFINE_2(Scalar, , __VA_ARGS__)
+#define FIXED_LEVEL_AVX2 Scalar
+#define FIXED_LEVEL_AVX512 Scalar
+#endif
+
+FNN_FIXED_ARCHITECTURES_1(FIXED_FORWARD_1)
+FNN_FIXED_ARCHITECTURES_2(FIXED_FORWARD_2)
+
+// ----------------------------------------------------------------------------------------------
+// table of specialized architectures (forward functions indexed by SIMD level)
+
+#define FIXED_EXPAND(MACRO, ...) MACRO(__VA_ARGS__)
+
+#define FIXED_ENTRY_1(IN, H, OUT, ACT_H, ACT_O)                                                                        \
+    {#IN "-" #H "-" #OUT " " #ACT_H "/" #ACT_O,                                                                       \
+     2,                                                                                                               \
+     {IN, H, OUT, 0},                                                                                                 \
+     {FNN_ACTIVATION_##ACT_H, FNN_ACTIVATION_##ACT_O, FNN_ACTIVATION_NONE},                                           \
+     {FIXED_NAME_1(IN, H, OUT, ACT_H, ACT_O, Scalar), FIXED_EXPAND(FIXED_NAME_1, IN, H, OUT, ACT_H, ACT_O, FIXED_LEVEL_AVX2), \
+      FIXED_EXPAND(FIXED_NAME_1, IN, H, OUT, ACT_H, ACT_O, FIXED_LEVEL_AVX512)}},
+
+#define FIXED_ENTRY_2(IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O)                                                          \
+    {#IN "-" #H1 "-" #H2 "-" #OUT " " #ACT_H1 "/" #ACT_H2 "/" #ACT_O,                                                 \
+     3,                                                                                                               \
+     {IN, H1, H2, OUT},                                                                                               \
+     {FNN_ACTIVATION_##ACT_H1, FNN_ACTIVATION_##ACT_H2, FNN_ACTIVATION_##ACT_O},                                      \
+     {FIXED_NAME_2(IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O, Scalar),                                                   \
+      FIXED_EXPAND(FIXED_NAME_2, IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O, FIXED_LEVEL_AVX2),                           \
+      FIXED_EXPAND(FIXED_NAME_2, IN, H1, H2, OUT, ACT_H1, ACT_H2, ACT_O, FIXED_LEVEL_AVX512)}},
+
+static const fixedArchitecture architectures[] = {FNN_FIXED_ARCHITECTURES_1(FIXED_ENTRY_1)
+                                                      FNN_FIXED_ARCHITECTURES_2(FIXED_ENTRY_2)};
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+FnnFixedModel *fnn_fixedSelect(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions)
+{
+    // parameter checking
+    if (weightMatrices == NULL || biasMatrices == NULL || activationFunctions == NULL || weightMatrices->size == 0 ||
+        weightMatrices->size > FIXED_MAX_LAYERS || weightMatrices->size != biasMatrices->size ||
+        weightMatrices->size != activationFunctions->size) {
+        return NULL;
+    }
+
+    // architecture of loaded model
+    uint32_t layerCount = (uint32_t)weightMatrices->size;
+    uint32_t neuronCounts[FIXED_MAX_LAYERS + 1] = {0};
+    FnnActivation_e activations[FIXED_MAX_LAYERS] = {FNN_ACTIVATION_NONE};
+    uint32_t parameterCount = 0;
+    neuronCounts[0] = ((xMatrix *)weightMatrices->head->data)->rows;
+    for (uint32_t i = 0; i < layerCount; i++) {
+        xMatrix *weights = xList_get(weightMatrices, (int)i);
+        xMatrix *biases = xList_get(biasMatrices, (int)i);
+        if (weights->rows != neuronCounts[i] || biases->cols != weights->cols) {
+            return NULL;
+        }
+        neuronCounts[i + 1] = weights->cols;
+        activations[i] = *(FnnActivation_e *)xList_get(activationFunctions, (int)i);
+        parameterCount += weights->rows * weights->cols + biases->cols;
+    }
+
+    // find matching specialized architecture
+    const fixedArchitecture *match = NULL;
+    for (uint32_t a = 0; a < sizeof(architectures) / sizeof(architectures[0]) && match == NULL; a++) {
+        if (architectures[a].layerCount != layerCount || architectures[a].neuronCounts[0] != neuronCounts[0]) {
+            continue;
+        }
+        match = &architectures[a];
+        for (uint32_t i = 0; i < layerCount; i++) {
+            if (architectures[a].neuronCounts[i + 1] != neuronCounts[i + 1] || architectures[a].activations[i] != activations[i]) {
+                match = NULL;
+                break;
+            }
+        }
+    }
+    if (match == NULL) {
+        return NULL;
+    }
+
+    // model allocation
+    FnnFixedModel *model = (FnnFixedModel *)malloc(sizeof(FnnFixedModel));
+    size_t size = ((size_t)parameterCount * sizeof(float) + XLINEAR_ALIGNMENT - 1) / XLINEAR_ALIGNMENT * XLINEAR_ALIGNMENT;
+    float *parameters = (float *)aligned_alloc(XLINEAR_ALIGNMENT, size);
+    if (model == NULL || parameters == NULL) {
+        fprintf(stderr, "FNN Fixed: Failed to allocate model\n");
+        free(model);
+        free(parameters);
+        return NULL;
+    }
+    model->name = match->name;
+    model->forward = match->forward[xSimd_level()];
+    model->parameters = parameters;
+
+    // pack parameters in order of inference
+    for (uint32_t i = 0; i < layerCount; i++) {
+        xMatrix *weights = xList_get(weightMatrices, (int)i);
+        xMatrix *biases = xList_get(biasMatrices, (int)i);
+        for (uint32_t k = 0; k < weights->rows; k++) {
+            memcpy(parameters, weights->data + (uint64_t)k * weights->stride, weights->cols * sizeof(float));
+            parameters += weights->cols;
+        }
+        memcpy(parameters, biases->data, biases->cols * sizeof(float));
+        parameters += biases->cols;
+    }
+
+    return model;
+}
+
+void fnn_fixedFree(FnnFixedModel *model)
+{
+    if (model == NULL) {
+        return;
+    }
+
+    free(model->parameters);
+    free(model);
+}
+
+void fnn_fixedForward(const FnnFixedModel *model, const float *input, float *output, FnnPrecision_e precision)
+{
+    // pointer checking
+    if (model == NULL || input == NULL || output == NULL) {
+        return;
+    }
+
+    model->forward(model->parameters, input, output, precision);
+}
@@ -0,0 +1,178 @@
+#include "fnnForward.h"
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // fprintf (for error messages)
+#include <stdlib.h>         // malloc, free
+#include "fnnActivation.h"  // activation functions
+#include "xLinear.h"        // matrix operations
+#include "xList.h"          // lists of loaded layer matrices
+#include "xThreadPool.h"    // process-wide thread pool
+
+/**
+ * @brief Batched inference split into bands of rows for thread pool.
+ *
+ */
+typedef struct {
+    xList *weightMatrices;
+    xList *biasMatrices;
+    xList *activationFunctions;
+    xMatrix *inputs;
+    xMatrix *outputs;
+    FnnPrecision_e precision;
+    uint32_t chunks;  // number of bands
+    int32_t failed;   // set if any band failed (accessed atomically)
+} forwardJob;
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static int32_t validateModel(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, xMatrix *inputs,
+                             xMatrix *outputs);
+static int32_t forwardRows(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, float *inputs,
+                           uint32_t inputStride, float *outputs, uint32_t outputStride, uint32_t rows, FnnPrecision_e precision);
+static void forwardTask(void *context, uint32_t index);
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+int32_t fnn_forwardBatch(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, xMatrix *inputs, xMatrix *outputs,
+                         FnnPrecision_e precision)
+{
+    if (validateModel(weightMatrices, biasMatrices, activationFunctions, inputs, outputs) != 0) {
+        return -1;
+    }
+
+    return forwardRows(weightMatrices, biasMatrices, activationFunctions, inputs->data, inputs->stride, outputs->data,
+                       outputs->stride, inputs->rows, precision);
+}
+
+int32_t fnn_forwardBatchParallel(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, xMatrix *inputs,
+                                 xMatrix *outputs, FnnPrecision_e precision)
+{
+    if (validateModel(weightMatrices, biasMatrices, activationFunctions, inputs, outputs) != 0) {
+        return -1;
+    }
+
+    // small batches stay on calling thread
+    uint32_t chunks = inputs->rows / FNN_PARALLEL_BATCH_ROWS;
+    uint32_t threads = xThreadPool_threadCount();
+    chunks = (chunks < threads) ? chunks : threads;
+    if (chunks <= 1) {
+        return forwardRows(weightMatrices, biasMatrices, activationFunctions, inputs->data, inputs->stride, outputs->data,
+                           outputs->stride, inputs->rows, precision);
+    }
+
+    forwardJob job = {weightMatrices, biasMatrices, activationFunctions, inputs, outputs, precision, chunks, 0};
+    xThreadPool_parallelFor(chunks, forwardTask, &job);
+
+    return job.failed ? -1 : 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// check that layers are chained correctly and batch matrices match first and last layer
+static int32_t validateModel(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, xMatrix *inputs,
+                             xMatrix *outputs)
+{
+    if (weightMatrices == NULL || biasMatrices == NULL || activationFunctions == NULL || inputs == NULL || outputs == NULL ||
+        weightMatrices->size == 0 || weightMatrices->size != biasMatrices->size ||
+        weightMatrices->size != activationFunctions->size) {
+        fprintf(stderr, "FNN Forward: Invalid arguments\n");
+        return -1;
+    }
+
+    uint32_t width = inputs->cols;
+    for (xListNode *weightNode = weightMatrices->head, *biasNode = biasMatrices->head; weightNode != NULL;
+         weightNode = weightNode->next, biasNode = biasNode->next) {
+        xMatrix *weights = (xMatrix *)weightNode->data;
+        xMatrix *biases = (xMatrix *)biasNode->data;
+        if (weights->rows != width || biases->cols != weights->cols) {
+            fprintf(stderr, "FNN Forward: Layer dimensions do not match\n");
+            return -1;
+        }
+        width = weights->cols;
+    }
+
+    if (outputs->rows != inputs->rows || outputs->cols != width) {
+        fprintf(stderr, "FNN Forward: Batch dimensions do not match\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+// run inference on block of batch rows (layer outputs alternate between two scratch buffers)
+static int32_t forwardRows(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, float *inputs,
+                           uint32_t inputStride, float *outputs, uint32_t outputStride, uint32_t rows, FnnPrecision_e precision)
+{
+    // scratch buffers sized for widest hidden layer
+    uint32_t maxWidth = 1;
+    for (xListNode *node = weightMatrices->head; node != NULL && node->next != NULL; node = node->next) {
+        uint32_t width = ((xMatrix *)node->data)->cols;
+        maxWidth = (width > maxWidth) ? width : maxWidth;
+    }
+    float *buffers[2] = {NULL, NULL};
+    if (weightMatrices->size > 1) {
+        buffers[0] = (float *)malloc((size_t)rows * maxWidth * sizeof(float));
+        buffers[1] = (float *)malloc((size_t)rows * maxWidth * sizeof(float));
+        if (buffers[0] == NULL || buffers[1] == NULL) {
+            fprintf(stderr, "FNN Forward: Failed to allocate scratch buffers\n");
+            free(buffers[0]);
+            free(buffers[1]);
+            return -1;
+        }
+    }
+
+    xMatrixView current = xMatrix_view(inputs, rows, ((xMatrix *)weightMatrices->head->data)->rows, inputStride);
+    xListNode *biasNode = biasMatrices->head;
+    xListNode *activationNode = activationFunctions->head;
+    int layer = 0;
+    for (xListNode *weightNode = weightMatrices->head; weightNode != NULL; weightNode = weightNode->next, layer++) {
+        xMatrix *weights = (xMatrix *)weightNode->data;
+        xMatrix *biases = (xMatrix *)biasNode->data;
+        FnnActivation_e activation = *(FnnActivation_e *)activationNode->data;
+        xMatrixView next = (weightNode->next == NULL) ? xMatrix_view(outputs, rows, weights->cols, outputStride)
+                                                      : xMatrix_view(buffers[layer % 2], rows, weights->cols, weights->cols);
+
+        // product, bias and activation over whole block
+        xMatrix_dot(&next, &current, weights);
+        for (uint32_t i = 0; i < rows; i++) {
+            float *row = next.data + (uint64_t)i * next.stride;
+            for (uint32_t j = 0; j < next.cols; j++) {
+                row[j] += biases->data[j];
+            }
+            if (next.stride != next.cols) {
+                fnn_activate(row, next.cols, activation, precision);
+            }
+        }
+        if (next.stride == next.cols) {
+            fnn_activate(next.data, rows * next.cols, activation, precision);
+        }
+
+        current = next;
+        biasNode = biasNode->next;
+        activationNode = activationNode->next;
+    }
+
+    free(buffers[0]);
+    free(buffers[1]);
+    return 0;
+}
+
+// run inference on one band of batch rows
+static void forwardTask(void *context, uint32_t index)
+{
+    forwardJob *job = (forwardJob *)context;
+    uint32_t start = (uint32_t)((uint64_t)job->inputs->rows * index / job->chunks);
+    uint32_t end = (uint32_t)((uint64_t)job->inputs->rows * (index + 1) / job->chunks);
+    if (end == start) {
+        return;
+    }
+
+    if (forwardRows(job->weightMatrices, job->biasMatrices, job->activationFunctions,
+                    job->inputs->data + (uint64_t)start * job->inputs->stride, job->inputs->stride,
+                    job->outputs->data + (uint64_t)start * job->outputs->stride, job->outputs->stride, end - start,
+                    job->precision) != 0) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,393 @@
+#include "fnnHalf.h"
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // fprintf (for error messages)
+#include <stdlib.h>         // aligned_alloc, calloc, free
+#include <string.h>         // memcpy, memset
+#include "fnnActivation.h"  // activation functions
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xLinear.h"        // xMatrix objects of loaded model
+#include "xList.h"          // lists of loaded layer matrices
+#include "xSimd.h"          // SIMD level detection and dispatch
+#if XSIMD_X86
+#include <immintrin.h>  // x86 SIMD intrinsics
+#endif
+
+#define HALF_OUTPUT_ALIGN 16  // outputs are padded to width of widest kernel
+#define HALF_BUFFER_ALIGN 64  // alignment of weight and scratch buffers (cache line)
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static void *alignedAlloc(uint64_t size);
+static uint16_t floatToHalf(float value);
+static float halfToFloat(uint16_t value);
+static uint16_t floatToBfloat(float value);
+static float bfloatToFloat(uint16_t value);
+static int32_t convertLayer(FnnHalfLayer *layer, xMatrix *weights, xMatrix *biases, FnnActivation_e activation,
+                            FnnHalfFormat_e format);
+static void gemvScalar(const FnnHalfLayer *layer, FnnHalfFormat_e format, const float *input, float *acc);
+#if XSIMD_X86
+static void gemvAvx2(const FnnHalfLayer *layer, FnnHalfFormat_e format, const float *input, float *acc, int fused);
+static void gemvAvx512(const FnnHalfLayer *layer, FnnHalfFormat_e format, const float *input, float *acc, int fused);
+#endif
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+FnnHalfModel *fnn_halfConvert(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, FnnHalfFormat_e format)
+{
+    // parameter checking
+    if (weightMatrices == NULL || biasMatrices == NULL || activationFunctions == NULL || weightMatrices->size == 0 ||
+        weightMatrices->size != biasMatrices->size || weightMatrices->size != activationFunctions->size) {
+        fprintf(stderr, "FNN Half: Invalid arguments\n");
+        return NULL;
+    }
+
+    // model allocation
+    FnnHalfModel *model = (FnnHalfModel *)calloc(1, sizeof(FnnHalfModel));
+    if (model == NULL) {
+        fprintf(stderr, "FNN Half: Failed to allocate model\n");
+        return NULL;
+    }
+    model->format = format;
+    model->layers = (FnnHalfLayer *)calloc((size_t)weightMatrices->size, sizeof(FnnHalfLayer));
+    if (model->layers == NULL) {
+        fprintf(stderr, "FNN Half: Failed to allocate layers\n");
+        free(model);
+        return NULL;
+    }
+
+    // convert layers
+    uint32_t maxOutputs = 0;
+    for (int i = 0; i < weightMatrices->size; i++) {
+        FnnHalfLayer *layer = &model->layers[i];
+        if (convertLayer(layer, xList_get(weightMatrices, i), xList_get(biasMatrices, i),
+                         *(FnnActivation_e *)xList_get(activationFunctions, i), format) != 0) {
+            fnn_halfFree(model);
+            return NULL;
+        }
+        model->layerCount++;
+        maxOutputs = (layer->outputsPadded > maxOutputs) ? layer->outputsPadded : maxOutputs;
+    }
+
+    // scratch buffers
+    model->accBuffer = (float *)alignedAlloc(maxOutputs * sizeof(float));
+    model->valueBuffer = (float *)alignedAlloc(maxOutputs * sizeof(float));
+    if (model->accBuffer == NULL || model->valueBuffer == NULL) {
+        fprintf(stderr, "FNN Half: Failed to allocate scratch buffers\n");
+        fnn_halfFree(model);
+        return NULL;
+    }
+
+    return model;
+}
+
+void fnn_halfFree(FnnHalfModel *model)
+{
+    if (model == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        free(model->layers[i].weights);
+        free(model->layers[i].biases);
+    }
+    free(model->layers);
+    free(model->accBuffer);
+    free(model->valueBuffer);
+    free(model);
+}
+
+void fnn_halfForward(FnnHalfModel *model, const float *input, float *output, FnnPrecision_e precision)
+{
+    // pointer checking
+    if (model == NULL || input == NULL || output == NULL) {
+        return;
+    }
+
+    const float *current = input;
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        FnnHalfLayer *layer = &model->layers[i];
+        float *next = (i == model->layerCount - 1) ? output : model->valueBuffer;
+
+        // matrix-vector product with on-the-fly widening of weights
+#if XSIMD_X86
+        if (xSimd_level() >= XSIMD_AVX512) {
+            gemvAvx512(layer, model->format, current, model->accBuffer, !xSimd_deterministic());
+        } else if (model->format == FNN_HALF_BF16 ? xSimd_level() >= XSIMD_AVX2 : xSimd_supports(XSIMD_FEATURE_F16C)) {
+            gemvAvx2(layer, model->format, current, model->accBuffer, !xSimd_deterministic());
+        } else {
+            gemvScalar(layer, model->format, current, model->accBuffer);
+        }
+#else
+        gemvScalar(layer, model->format, current, model->accBuffer);
+#endif
+
+        // bias and activation
+        for (uint32_t j = 0; j < layer->outputs; j++) {
+            next[j] = model->accBuffer[j] + layer->biases[j];
+        }
+        fnn_activate(next, layer->outputs, layer->activation, precision);
+
+        current = next;
+    }
+}
+
+uint64_t fnn_halfWeightBytes(const FnnHalfModel *model)
+{
+    if (model == NULL) {
+        return 0;
+    }
+
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        bytes += (uint64_t)model->layers[i].inputs * model->layers[i].outputsPadded * sizeof(uint16_t);
+    }
+    return bytes;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// allocate zeroed block aligned to cache line (size is rounded up as required by aligned_alloc)
+static void *alignedAlloc(uint64_t size)
+{
+    size = (size + HALF_BUFFER_ALIGN - 1) / HALF_BUFFER_ALIGN * HALF_BUFFER_ALIGN;
+    if (size == 0) {
+        size = HALF_BUFFER_ALIGN;
+    }
+
+    void *block = aligned_alloc(HALF_BUFFER_ALIGN, size);
+    if (block != NULL) {
+        memset(block, 0, size);
+    }
+    return block;
+}
+
+// float to IEEE binary16 conversion (round to nearest, ties to even)
+static uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    // infinity and NaN (NaN stays quiet NaN)
+    if (exponent == 0xFFu) {
+        return (uint16_t)(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u));
+    }
+
+    int32_t halfExponent = (int32_t)exponent - 127 + 15;
+    if (halfExponent >= 0x1F) {
+        return (uint16_t)(sign | 0x7C00u);  // overflow to infinity
+    }
+
+    // subnormal half (or underflow to zero)
+    if (halfExponent <= 0) {
+        if (halfExponent < -10) {
+            return (uint16_t)sign;
+        }
+        mantissa |= 0x800000u;
+        uint32_t shift = (uint32_t)(14 - halfExponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t middle = 1u << (shift - 1u);
+        if (remainder > middle || (remainder == middle && (half & 1u))) {
+            half++;
+        }
+        return (uint16_t)(sign | half);
+    }
+
+    // normal half (rounding carry may propagate into exponent, which is correct)
+    uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        half++;
+    }
+    return (uint16_t)(sign | half);
+}
+
+// IEEE binary16 to float conversion (exact)
+static float halfToFloat(uint16_t value)
+{
+    uint32_t sign = (uint32_t)(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    uint32_t bits;
+
+    if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // normalize subnormal half
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// float to bfloat16 conversion (round to nearest, ties to even)
+static uint16_t floatToBfloat(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    if ((bits & 0x7F800000u) == 0x7F800000u && (bits & 0x7FFFFFu) != 0) {
+        return (uint16_t)((bits >> 16) | 0x40u);  // keep NaN quiet
+    }
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return (uint16_t)(bits >> 16);
+}
+
+// bfloat16 to float conversion (exact)
+static float bfloatToFloat(uint16_t value)
+{
+    uint32_t bits = (uint32_t)value << 16;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// convert weights of one layer to 16-bit format
+static int32_t convertLayer(FnnHalfLayer *layer, xMatrix *weights, xMatrix *biases, FnnActivation_e activation,
+                            FnnHalfFormat_e format)
+{
+    if (weights == NULL || biases == NULL || biases->cols != weights->cols) {
+        fprintf(stderr, "FNN Half: Layer dimensions do not match\n");
+        return -1;
+    }
+
+    layer->inputs = weights->rows;
+    layer->outputs = weights->cols;
+    layer->outputsPadded = (weights->cols + HALF_OUTPUT_ALIGN - 1) / HALF_OUTPUT_ALIGN * HALF_OUTPUT_ALIGN;
+    layer->activation = activation;
+
+    layer->weights = (uint16_t *)alignedAlloc((uint64_t)layer->inputs * layer->outputsPadded * sizeof(uint16_t));
+    layer->biases = (float *)alignedAlloc(layer->outputsPadded * sizeof(float));
+    if (layer->weights == NULL || layer->biases == NULL) {
+        fprintf(stderr, "FNN Half: Failed to allocate layer\n");
+        return -1;
+    }
+    memcpy(layer->biases, biases->data, layer->outputs * sizeof(float));
+
+    for (uint32_t k = 0; k < layer->inputs; k++) {
+        for (uint32_t j = 0; j < layer->outputs; j++) {
+            float value = weights->data[(uint64_t)k * weights->stride + j];
+            layer->weights[(uint64_t)k * layer->outputsPadded + j] =
+                (format == FNN_HALF_BF16) ? floatToBfloat(value) : floatToHalf(value);
+        }
+    }
+
+    return 0;
+}
+
+// portable kernel with software widening
+static void gemvScalar(const FnnHalfLayer *layer, FnnHalfFormat_e format, const float *input, float *acc)
+{
+    for (uint32_t j = 0; j < layer->outputs; j++) {
+        acc[j] = 0.0f;
+    }
+
+    for (uint32_t k = 0; k < layer->inputs; k++) {
+        const uint16_t *row = layer->weights + (uint64_t)k * layer->outputsPadded;
+        if (format == FNN_HALF_BF16) {
+            for (uint32_t j = 0; j < layer->outputs; j++) {
+                acc[j] += input[k] * bfloatToFloat(row[j]);
+            }
+        } else {
+            for (uint32_t j = 0; j < layer->outputs; j++) {
+                acc[j] += input[k] * halfToFloat(row[j]);
+            }
+        }
+    }
+}
+
+#if XSIMD_X86
+// multiply-add of vector kernels (fused, or rounded after multiplication and after addition like portable kernel)
+#define HALF_MADD256(FUSED, A, B, C) ((FUSED) ? _mm256_fmadd_ps(A, B, C) : _mm256_add_ps(_mm256_mul_ps(A, B), C))
+#define HALF_MADD512(FUSED, A, B, C) ((FUSED) ? _mm512_fmadd_ps(A, B, C) : _mm512_add_ps(_mm512_mul_ps(A, B), C))
+
+// AVX2 kernel (F16C or shift widening, 16 outputs per iteration)
+__attribute__((target("avx2,fma,f16c"), always_inline)) static inline void gemvAvx2Body(const FnnHalfLayer *layer,
+                                                                                       FnnHalfFormat_e format,
+                                                                                       const float *input, float *acc,
+                                                                                       const int fused)
+{
+    for (uint32_t j = 0; j < layer->outputsPadded; j += 16) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for (uint32_t k = 0; k < layer->inputs; k++) {
+            const uint16_t *row = layer->weights + (uint64_t)k * layer->outputsPadded + j;
+            __m128i h0 = _mm_loadu_si128((const __m128i *)row);
+            __m128i h1 = _mm_loadu_si128((const __m128i *)(row + 8));
+
+            __m256 w0, w1;
+            if (format == FNN_HALF_BF16) {
+                w0 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h0), 16));
+                w1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h1), 16));
+            } else {
+                w0 = _mm256_cvtph_ps(h0);
+                w1 = _mm256_cvtph_ps(h1);
+            }
+
+            __m256 x = _mm256_set1_ps(input[k]);
+            acc0 = HALF_MADD256(fused, x, w0, acc0);
+            acc1 = HALF_MADD256(fused, x, w1, acc1);
+        }
+        _mm256_storeu_ps(acc + j, acc0);
+        _mm256_storeu_ps(acc + j + 8, acc1);
+    }
+}
+
+__attribute__((target("avx2,fma,f16c"))) static void gemvAvx2(const FnnHalfLayer *layer, FnnHalfFormat_e format,
+                                                               const float *input, float *acc, int fused)
+{
+    if (fused) {
+        gemvAvx2Body(layer, format, input, acc, 1);
+    } else {
+        gemvAvx2Body(layer, format, input, acc, 0);
+    }
+}
+
+// AVX-512 kernel (16 outputs per iteration)
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"), always_inline)) static inline void gemvAvx512Body(
+    const FnnHalfLayer *layer, FnnHalfFormat_e format, const float *input, float *acc, const int fused)
+{
+    for (uint32_t j = 0; j < layer->outputsPadded; j += 16) {
+        __m512 sum = _mm512_setzero_ps();
+        for (uint32_t k = 0; k < layer->inputs; k++) {
+            __m256i h = _mm256_loadu_si256((const __m256i *)(layer->weights + (uint64_t)k * layer->outputsPadded + j));
+            __m512 w = (format == FNN_HALF_BF16) ? _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16))
+                                                 : _mm512_cvtph_ps(h);
+            sum = HALF_MADD512(fused, _mm512_set1_ps(input[k]), w, sum);
+        }
+        _mm512_storeu_ps(acc + j, sum);
+    }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static void gemvAvx512(const FnnHalfLayer *layer,
+                                                                                      FnnHalfFormat_e format,
+                                                                                      const float *input, float *acc,
+                                                                                      int fused)
+{
+    if (fused) {
+        gemvAvx512Body(layer, format, input, acc, 1);
+    } else {
+        gemvAvx512Body(layer, format, input, acc, 0);
+    }
+}
+#endif
@@ -1,11 +1,30 @@
 #include "fnnLoader.h"
+#include <fcntl.h>          // open
 #include <stdint.h>         // universal integer types
 #include <stdio.h>          // fprintf (for error messages)
 #include <stdlib.h>         // malloc (for memory allocation)
+#include <string.h>         // memcpy (for reading unaligned header fields)
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/stat.h>       // fstat (for file size)
+#include <unistd.h>         // close, pread and page size
 #include "fnnSerializer.h"  // FNN model descriptor
 #include "xLinear.h"        // xMatrix objects for layer information
 #include "xList.h"          // xList object for storing xMatrix objects in one package for return
 
+#define FNN_LOADER_HEADER_SIZE 26  // size of fixed part of file header (magic, version, totals and layer count)
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static FnnMappedModel *mapLayers(uint8_t *address, uint64_t size, const uint8_t *model, uint64_t modelSize, xList *weightMatrices,
+                                 xList *biasMatrices, xList *activationFunctions);
+static int32_t validateMapping(const uint8_t *address, uint64_t size, uint16_t *version, uint32_t *layerCount);
+static xMatrix *mapMatrix(const uint8_t *values, uint32_t rows, uint32_t cols, uint16_t version);
+static void clearLists(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions);
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
 int32_t fnn_loadModel(const char *filename, xList *weightMatrices, xList *biasMatrices, xList *activationFunctions)
 {
     // checking validity of arguments (only bias matrices can be ignored if
@@ -67,3 +86,249 @@ int32_t fnn_loadModel(const char *filename, xList *weightMatrices, xList *biasMa
 
     return 0;
 }
+
+FnnMappedModel *fnn_mapModel(const char *filename, xList *weightMatrices, xList *biasMatrices, xList *activationFunctions)
+{
+    // checking validity of arguments (only bias matrices can be ignored if unused)
+    if (filename == NULL || weightMatrices == NULL || activationFunctions == NULL) {
+        fprintf(stderr, "FNN Loader: Invalid arguments\n");
+        return NULL;
+    }
+
+    // map whole file read-only
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "FNN Loader: Failed to open model file\n");
+        return NULL;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < FNN_LOADER_HEADER_SIZE) {
+        fprintf(stderr, "FNN Loader: Model file is too small\n");
+        close(fd);
+        return NULL;
+    }
+    uint64_t size = (uint64_t)fileStat.st_size;
+    uint8_t *address = (uint8_t *)mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        fprintf(stderr, "FNN Loader: Failed to map model file\n");
+        return NULL;
+    }
+
+    return mapLayers(address, size, address, size, weightMatrices, biasMatrices, activationFunctions);
+}
+
+FnnMappedModel *fnn_mapPopulationModel(const char *filename, uint32_t index, xList *weightMatrices, xList *biasMatrices,
+                                       xList *activationFunctions)
+{
+    // checking validity of arguments (only bias matrices can be ignored if unused)
+    if (filename == NULL || weightMatrices == NULL || activationFunctions == NULL) {
+        fprintf(stderr, "FNN Loader: Invalid arguments\n");
+        return NULL;
+    }
+
+    // read and validate population header
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "FNN Loader: Failed to open population file\n");
+        return NULL;
+    }
+    struct stat fileStat;
+    FnnPopulationHeader header;
+    if (fstat(fd, &fileStat) != 0 || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        fnn_populationValidate(&header, (uint64_t)fileStat.st_size) != 0) {
+        fprintf(stderr, "FNN Loader: Invalid population file\n");
+        close(fd);
+        return NULL;
+    }
+    if (index >= header.count) {
+        fprintf(stderr, "FNN Loader: Genome index %u out of population of %u\n", index, header.count);
+        close(fd);
+        return NULL;
+    }
+
+    // map only pages of record (mapping starts at page boundary before record)
+    uint64_t recordOffset = header.recordsOffset + (uint64_t)index * header.recordStride;
+    uint64_t pageOffset = recordOffset / (uint64_t)sysconf(_SC_PAGESIZE) * (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t size = recordOffset - pageOffset + header.recordSize;
+    uint8_t *address = (uint8_t *)mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, (off_t)pageOffset);
+    close(fd);
+    if (address == MAP_FAILED) {
+        fprintf(stderr, "FNN Loader: Failed to map genome record\n");
+        return NULL;
+    }
+
+    return mapLayers(address, size, address + (recordOffset - pageOffset), header.recordSize, weightMatrices, biasMatrices,
+                     activationFunctions);
+}
+
+void fnn_unmapModel(FnnMappedModel *mapping)
+{
+    if (mapping == NULL) {
+        return;
+    }
+
+    if (mapping->address != NULL) {
+        munmap(mapping->address, mapping->size);
+    }
+    free(mapping);
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// create matrices over model within mapping (mapping is unmapped on failure)
+static FnnMappedModel *mapLayers(uint8_t *address, uint64_t size, const uint8_t *model, uint64_t modelSize, xList *weightMatrices,
+                                 xList *biasMatrices, xList *activationFunctions)
+{
+    // validate header and layer descriptors against size of model
+    uint16_t version = 0;
+    uint32_t layerCount = 0;
+    if (validateMapping(model, modelSize, &version, &layerCount) != 0) {
+        munmap(address, size);
+        return NULL;
+    }
+
+    // create matrices over weight and bias regions
+    const uint8_t *neuronCounts = model + FNN_LOADER_HEADER_SIZE;
+    const uint8_t *activations = neuronCounts + (uint64_t)layerCount * sizeof(uint32_t);
+    const uint8_t *weightValues = model + fnn_valuesOffset(version, layerCount);
+    uint64_t totalWeights = 0;
+    memcpy(&totalWeights, model + 6, sizeof(uint64_t));
+    const uint8_t *biasValues = weightValues + totalWeights * sizeof(float);
+    for (uint32_t i = 0; i < layerCount - 1; i++) {
+        uint32_t rows = 0, cols = 0;
+        memcpy(&rows, neuronCounts + (uint64_t)i * sizeof(uint32_t), sizeof(uint32_t));
+        memcpy(&cols, neuronCounts + (uint64_t)(i + 1) * sizeof(uint32_t), sizeof(uint32_t));
+
+        xMatrix *weightMatrix = mapMatrix(weightValues, rows, cols, version);
+        xMatrix *biasMatrix = (biasMatrices != NULL) ? mapMatrix(biasValues, 1, cols, version) : NULL;
+        FnnActivation_e *activationFunction = malloc(sizeof(FnnActivation_e));
+        if (weightMatrix == NULL || (biasMatrices != NULL && biasMatrix == NULL) || activationFunction == NULL) {
+            fprintf(stderr, "FNN Loader: Failed to allocate memory for layer %u\n", i + 1);
+            xMatrix_free(weightMatrix);
+            xMatrix_free(biasMatrix);
+            free(activationFunction);
+            clearLists(weightMatrices, biasMatrices, activationFunctions);
+            munmap(address, size);
+            return NULL;
+        }
+        memcpy(activationFunction, activations + (uint64_t)i * sizeof(FnnActivation_e), sizeof(FnnActivation_e));
+
+        xList_pushBack(weightMatrices, weightMatrix);
+        if (biasMatrices != NULL) {
+            xList_pushBack(biasMatrices, biasMatrix);
+        }
+        xList_pushBack(activationFunctions, activationFunction);
+        weightValues += (uint64_t)rows * cols * sizeof(float);
+        biasValues += (uint64_t)cols * sizeof(float);
+    }
+
+    // mapping descriptor
+    FnnMappedModel *mapping = (FnnMappedModel *)malloc(sizeof(FnnMappedModel));
+    if (mapping == NULL) {
+        fprintf(stderr, "FNN Loader: Failed to allocate mapping descriptor\n");
+        clearLists(weightMatrices, biasMatrices, activationFunctions);
+        munmap(address, size);
+        return NULL;
+    }
+    mapping->address = address;
+    mapping->size = size;
+
+    // values of unaligned files were copied, mapping is no longer needed
+    if (version == FNN_SERIALIZER_VERSION_UNALIGNED) {
+        munmap(address, size);
+        mapping->address = NULL;
+        mapping->size = 0;
+    }
+
+    return mapping;
+}
+
+
+// check that header, layer descriptors and all values fit in mapped file and match each other
+static int32_t validateMapping(const uint8_t *address, uint64_t size, uint16_t *version, uint32_t *layerCount)
+{
+    uint32_t magic = 0;
+    uint64_t totalWeights = 0, totalBiases = 0;
+    memcpy(&magic, address, sizeof(uint32_t));
+    memcpy(version, address + 4, sizeof(uint16_t));
+    memcpy(&totalWeights, address + 6, sizeof(uint64_t));
+    memcpy(&totalBiases, address + 14, sizeof(uint64_t));
+    memcpy(layerCount, address + 22, sizeof(uint32_t));
+
+    if (magic != FNN_SERIALIZER_MAGIC || (*version != FNN_SERIALIZER_VERSION && *version != FNN_SERIALIZER_VERSION_UNALIGNED)) {
+        fprintf(stderr, "FNN Loader: Invalid model header\n");
+        return -1;
+    }
+    if (*layerCount <= 1 || fnn_valuesOffset(*version, *layerCount) > size) {
+        fprintf(stderr, "FNN Loader: Invalid layer count\n");
+        return -1;
+    }
+
+    // layer descriptors must add up to totals in header
+    const uint8_t *neuronCounts = address + FNN_LOADER_HEADER_SIZE;
+    const uint8_t *activations = neuronCounts + (uint64_t)*layerCount * sizeof(uint32_t);
+    uint64_t valueLimit = size / sizeof(float);
+    uint64_t weights = 0, biases = 0;
+    uint32_t previous = 0;
+    memcpy(&previous, neuronCounts, sizeof(uint32_t));
+    for (uint32_t i = 1; i < *layerCount; i++) {
+        uint32_t current = 0;
+        uint32_t activation = 0;
+        memcpy(&current, neuronCounts + (uint64_t)i * sizeof(uint32_t), sizeof(uint32_t));
+        memcpy(&activation, activations + (uint64_t)(i - 1) * sizeof(FnnActivation_e), sizeof(FnnActivation_e));
+        if (previous == 0 || current == 0 || activation > FNN_ACTIVATION_TANH) {
+            fprintf(stderr, "FNN Loader: Invalid layer descriptor\n");
+            return -1;
+        }
+        weights += (uint64_t)previous * current;
+        biases += current;
+        if (weights > valueLimit || biases > valueLimit) {
+            fprintf(stderr, "FNN Loader: Layer descriptors exceed file size\n");
+            return -1;
+        }
+        previous = current;
+    }
+    if (weights != totalWeights || biases != totalBiases) {
+        fprintf(stderr, "FNN Loader: Layer descriptors do not match value counts\n");
+        return -1;
+    }
+    if (fnn_valuesOffset(*version, *layerCount) + (weights + biases) * sizeof(float) > size) {
+        fprintf(stderr, "FNN Loader: Model file is truncated\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+// create matrix over mapped values (copy of values if they are not aligned in file)
+static xMatrix *mapMatrix(const uint8_t *values, uint32_t rows, uint32_t cols, uint16_t version)
+{
+    if (version == FNN_SERIALIZER_VERSION_UNALIGNED) {
+        xMatrix *matrix = xMatrix_new(rows, cols);
+        if (matrix != NULL) {
+            memcpy(matrix->data, values, (size_t)rows * cols * sizeof(float));
+        }
+        return matrix;
+    }
+
+    xMatrix *matrix = (xMatrix *)malloc(sizeof(xMatrix));
+    if (matrix != NULL) {
+        *matrix = xMatrix_view((float *)values, rows, cols, cols);
+    }
+    return matrix;
+}
+
+// free all elements of partially loaded lists
+static void clearLists(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions)
+{
+    xList_forEach(weightMatrices, (void (*)(void *))xMatrix_free);
+    xList_clear(weightMatrices);
+    if (biasMatrices != NULL) {
+        xList_forEach(biasMatrices, (void (*)(void *))xMatrix_free);
+        xList_clear(biasMatrices);
+    }
+    xList_forEach(activationFunctions, free);
+    xList_clear(activationFunctions);
+}
@@ -0,0 +1,316 @@
+#include "fnnQuantize.h"
+#include <math.h>           // fabsf, lrintf (for quantization)
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // fprintf (for error messages)
+#include <stdlib.h>         // malloc, aligned_alloc, free
+#include <string.h>         // memcpy, memset
+#include "fnnActivation.h"  // activation functions
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xLinear.h"        // xMatrix objects of loaded model
+#include "xList.h"          // lists of loaded layer matrices
+#include "xSimd.h"          // SIMD level detection and dispatch
+#if XSIMD_X86
+#include <immintrin.h>  // x86 SIMD intrinsics
+#endif
+
+#define QUANT_MAX 127            // largest magnitude of quantized value (symmetric range, -128 is never used)
+#define QUANT_INPUT_ALIGN 4      // inputs are grouped by four into one 32-bit lane
+#define QUANT_OUTPUT_ALIGN 16    // outputs are padded to width of widest kernel
+#define QUANT_BUFFER_ALIGN 64    // alignment of packed weights (cache line)
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static void *alignedAlloc(uint64_t size);
+static int32_t quantizeLayer(FnnQuantLayer *layer, xMatrix *weights, xMatrix *biases, FnnActivation_e activation);
+static float quantizeInput(const float *values, uint32_t count, int8_t *quantized);
+static void gemvScalar(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc);
+#if XSIMD_X86
+static void gemvAvx2(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc);
+static void gemvVnni(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc);
+#endif
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+FnnQuantModel *fnn_quantize(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions)
+{
+    // parameter checking
+    if (weightMatrices == NULL || biasMatrices == NULL || activationFunctions == NULL || weightMatrices->size == 0 ||
+        weightMatrices->size != biasMatrices->size || weightMatrices->size != activationFunctions->size) {
+        fprintf(stderr, "FNN Quantize: Invalid arguments\n");
+        return NULL;
+    }
+
+    // model allocation
+    FnnQuantModel *model = (FnnQuantModel *)calloc(1, sizeof(FnnQuantModel));
+    if (model == NULL) {
+        fprintf(stderr, "FNN Quantize: Failed to allocate model\n");
+        return NULL;
+    }
+    model->layers = (FnnQuantLayer *)calloc((size_t)weightMatrices->size, sizeof(FnnQuantLayer));
+    if (model->layers == NULL) {
+        fprintf(stderr, "FNN Quantize: Failed to allocate layers\n");
+        free(model);
+        return NULL;
+    }
+
+    // quantize layers
+    uint32_t maxInputs = 0;
+    uint32_t maxOutputs = 0;
+    for (int i = 0; i < weightMatrices->size; i++) {
+        FnnQuantLayer *layer = &model->layers[i];
+        if (quantizeLayer(layer, xList_get(weightMatrices, i), xList_get(biasMatrices, i),
+                          *(FnnActivation_e *)xList_get(activationFunctions, i)) != 0) {
+            fnn_quantFree(model);
+            return NULL;
+        }
+        model->layerCount++;
+
+        maxInputs = (layer->inputsPadded > maxInputs) ? layer->inputsPadded : maxInputs;
+        maxOutputs = (layer->outputsPadded > maxOutputs) ? layer->outputsPadded : maxOutputs;
+    }
+
+    // scratch buffers
+    model->inputBuffer = (int8_t *)alignedAlloc(maxInputs * sizeof(int8_t));
+    model->accBuffer = (int32_t *)alignedAlloc(maxOutputs * sizeof(int32_t));
+    model->valueBuffer = (float *)alignedAlloc(maxOutputs * sizeof(float));
+    if (model->inputBuffer == NULL || model->accBuffer == NULL || model->valueBuffer == NULL) {
+        fprintf(stderr, "FNN Quantize: Failed to allocate scratch buffers\n");
+        fnn_quantFree(model);
+        return NULL;
+    }
+
+    return model;
+}
+
+void fnn_quantFree(FnnQuantModel *model)
+{
+    if (model == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        free(model->layers[i].weights);
+        free(model->layers[i].weightSums);
+        free(model->layers[i].scales);
+        free(model->layers[i].biases);
+    }
+    free(model->layers);
+    free(model->inputBuffer);
+    free(model->accBuffer);
+    free(model->valueBuffer);
+    free(model);
+}
+
+void fnn_quantForward(FnnQuantModel *model, const float *input, float *output, FnnPrecision_e precision)
+{
+    // pointer checking
+    if (model == NULL || input == NULL || output == NULL) {
+        return;
+    }
+
+    const float *current = input;
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        FnnQuantLayer *layer = &model->layers[i];
+        float *next = (i == model->layerCount - 1) ? output : model->valueBuffer;
+
+        // quantize layer input (padding stays zero)
+        memset(model->inputBuffer, 0, layer->inputsPadded);
+        float inputScale = quantizeInput(current, layer->inputs, model->inputBuffer);
+
+        // integer matrix-vector product
+        if (xSimd_supports(XSIMD_FEATURE_VNNI)) {
+            gemvVnni(layer, model->inputBuffer, model->accBuffer);
+        } else if (xSimd_level() >= XSIMD_AVX2) {
+            gemvAvx2(layer, model->inputBuffer, model->accBuffer);
+        } else {
+            gemvScalar(layer, model->inputBuffer, model->accBuffer);
+        }
+
+        // dequantization into activation step
+        for (uint32_t j = 0; j < layer->outputs; j++) {
+            next[j] = (float)model->accBuffer[j] * (inputScale * layer->scales[j]) + layer->biases[j];
+        }
+        fnn_activate(next, layer->outputs, layer->activation, precision);
+
+        current = next;
+    }
+}
+
+uint64_t fnn_quantWeightBytes(const FnnQuantModel *model)
+{
+    if (model == NULL) {
+        return 0;
+    }
+
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        bytes += (uint64_t)model->layers[i].inputsPadded * model->layers[i].outputsPadded * sizeof(int8_t);
+    }
+    return bytes;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// allocate zeroed block aligned to cache line (size is rounded up as required by aligned_alloc)
+static void *alignedAlloc(uint64_t size)
+{
+    size = (size + QUANT_BUFFER_ALIGN - 1) / QUANT_BUFFER_ALIGN * QUANT_BUFFER_ALIGN;
+    if (size == 0) {
+        size = QUANT_BUFFER_ALIGN;
+    }
+
+    void *block = aligned_alloc(QUANT_BUFFER_ALIGN, size);
+    if (block != NULL) {
+        memset(block, 0, size);
+    }
+    return block;
+}
+
+// quantize weights of one layer with per output channel scales
+static int32_t quantizeLayer(FnnQuantLayer *layer, xMatrix *weights, xMatrix *biases, FnnActivation_e activation)
+{
+    if (weights == NULL || biases == NULL || biases->cols != weights->cols) {
+        fprintf(stderr, "FNN Quantize: Layer dimensions do not match\n");
+        return -1;
+    }
+
+    layer->inputs = weights->rows;
+    layer->outputs = weights->cols;
+    layer->inputsPadded = (weights->rows + QUANT_INPUT_ALIGN - 1) / QUANT_INPUT_ALIGN * QUANT_INPUT_ALIGN;
+    layer->outputsPadded = (weights->cols + QUANT_OUTPUT_ALIGN - 1) / QUANT_OUTPUT_ALIGN * QUANT_OUTPUT_ALIGN;
+    layer->activation = activation;
+
+    layer->weights = (int8_t *)alignedAlloc((uint64_t)layer->inputsPadded * layer->outputsPadded * sizeof(int8_t));
+    layer->weightSums = (int32_t *)alignedAlloc(layer->outputsPadded * sizeof(int32_t));
+    layer->scales = (float *)alignedAlloc(layer->outputsPadded * sizeof(float));
+    layer->biases = (float *)alignedAlloc(layer->outputsPadded * sizeof(float));
+    if (layer->weights == NULL || layer->weightSums == NULL || layer->scales == NULL || layer->biases == NULL) {
+        fprintf(stderr, "FNN Quantize: Failed to allocate layer\n");
+        return -1;
+    }
+    memcpy(layer->biases, biases->data, layer->outputs * sizeof(float));
+
+    for (uint32_t j = 0; j < layer->outputs; j++) {
+        // channel scale from largest weight magnitude
+        float maxAbs = 0.0f;
+        for (uint32_t k = 0; k < layer->inputs; k++) {
+            float value = fabsf(weights->data[(uint64_t)k * weights->stride + j]);
+            maxAbs = (value > maxAbs) ? value : maxAbs;
+        }
+        float scale = (maxAbs > 0.0f) ? maxAbs / QUANT_MAX : 1.0f;
+        layer->scales[j] = scale;
+
+        // quantize and pack channel weights
+        int32_t sum = 0;
+        for (uint32_t k = 0; k < layer->inputs; k++) {
+            long quantized = lrintf(weights->data[(uint64_t)k * weights->stride + j] / scale);
+            quantized = (quantized > QUANT_MAX) ? QUANT_MAX : (quantized < -QUANT_MAX) ? -QUANT_MAX : quantized;
+
+            uint64_t offset = ((uint64_t)(k / QUANT_INPUT_ALIGN) * layer->outputsPadded + j) * QUANT_INPUT_ALIGN + k % QUANT_INPUT_ALIGN;
+            layer->weights[offset] = (int8_t)quantized;
+            sum += (int32_t)quantized;
+        }
+        layer->weightSums[j] = sum;
+    }
+
+    return 0;
+}
+
+// quantize layer input with single symmetric scale, returns dequantization scale
+static float quantizeInput(const float *values, uint32_t count, int8_t *quantized)
+{
+    float maxAbs = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        float value = fabsf(values[i]);
+        maxAbs = (value > maxAbs) ? value : maxAbs;
+    }
+    if (maxAbs == 0.0f) {
+        return 0.0f;
+    }
+
+    float scale = maxAbs / QUANT_MAX;
+    float invScale = QUANT_MAX / maxAbs;
+    for (uint32_t i = 0; i < count; i++) {
+        long value = lrintf(values[i] * invScale);
+        quantized[i] = (int8_t)((value > QUANT_MAX) ? QUANT_MAX : (value < -QUANT_MAX) ? -QUANT_MAX : value);
+    }
+    return scale;
+}
+
+// portable integer kernel
+static void gemvScalar(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc)
+{
+    for (uint32_t j = 0; j < layer->outputsPadded; j++) {
+        acc[j] = 0;
+    }
+
+    for (uint32_t g = 0; g < layer->inputsPadded / QUANT_INPUT_ALIGN; g++) {
+        const int8_t *group = input + g * QUANT_INPUT_ALIGN;
+        const int8_t *row = layer->weights + (uint64_t)g * layer->outputsPadded * QUANT_INPUT_ALIGN;
+        for (uint32_t j = 0; j < layer->outputsPadded; j++) {
+            acc[j] += group[0] * row[j * 4 + 0] + group[1] * row[j * 4 + 1] + group[2] * row[j * 4 + 2] + group[3] * row[j * 4 + 3];
+        }
+    }
+}
+
+#if XSIMD_X86
+// AVX2 kernel (vpmaddubsw on |input| and sign-adjusted weights, 8 output channels per register)
+__attribute__((target("avx2"))) static void gemvAvx2(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    const uint32_t groups = layer->inputsPadded / QUANT_INPUT_ALIGN;
+
+    for (uint32_t j = 0; j < layer->outputsPadded; j += 16) {
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        for (uint32_t g = 0; g < groups; g++) {
+            int32_t packed;
+            memcpy(&packed, input + g * QUANT_INPUT_ALIGN, sizeof(packed));
+            const __m256i in = _mm256_set1_epi32(packed);
+            const __m256i inAbs = _mm256_sign_epi8(in, in);
+
+            const int8_t *row = layer->weights + ((uint64_t)g * layer->outputsPadded + j) * QUANT_INPUT_ALIGN;
+            __m256i w0 = _mm256_loadu_si256((const __m256i *)row);
+            __m256i w1 = _mm256_loadu_si256((const __m256i *)(row + 32));
+
+            // |a| * (w * sign(a)) == a * w, pair sums stay within int16 since |a|, |w| <= 127
+            __m256i p0 = _mm256_maddubs_epi16(inAbs, _mm256_sign_epi8(w0, in));
+            __m256i p1 = _mm256_maddubs_epi16(inAbs, _mm256_sign_epi8(w1, in));
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(p0, ones));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(p1, ones));
+        }
+        _mm256_storeu_si256((__m256i *)(acc + j), acc0);
+        _mm256_storeu_si256((__m256i *)(acc + j + 8), acc1);
+    }
+}
+
+// AVX-512 VNNI kernel (vpdpbusd on input offset to unsigned range, 16 output channels per register)
+__attribute__((target("avx512f,avx512vnni"))) static void gemvVnni(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc)
+{
+    const __m512i offset = _mm512_set1_epi32((int32_t)0x80808080u);
+    const uint32_t groups = layer->inputsPadded / QUANT_INPUT_ALIGN;
+
+    for (uint32_t j = 0; j < layer->outputsPadded; j += 16) {
+        __m512i sum = _mm512_setzero_si512();
+        for (uint32_t g = 0; g < groups; g++) {
+            int32_t packed;
+            memcpy(&packed, input + g * QUANT_INPUT_ALIGN, sizeof(packed));
+
+            // (a + 128) as unsigned byte is a ^ 0x80
+            const __m512i in = _mm512_xor_si512(_mm512_set1_epi32(packed), offset);
+            const int8_t *row = layer->weights + ((uint64_t)g * layer->outputsPadded + j) * QUANT_INPUT_ALIGN;
+            sum = _mm512_dpbusd_epi32(sum, in, _mm512_loadu_si512((const void *)row));
+        }
+
+        // remove contribution of input offset: sum((a + 128) * w) - 128 * sum(w)
+        __m512i correction = _mm512_slli_epi32(_mm512_loadu_si512((const void *)(layer->weightSums + j)), 7);
+        _mm512_storeu_si512((void *)(acc + j), _mm512_sub_epi32(sum, correction));
+    }
+}
+#else
+static void gemvAvx2(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc) { gemvScalar(layer, input, acc); }
+static void gemvVnni(const FnnQuantLayer *layer, const int8_t *input, int32_t *acc) { gemvScalar(layer, input, acc); }
+#endif
@@ -0,0 +1,302 @@
+#include "fnnSparse.h"
+#include <math.h>           // fabsf (for magnitude pruning)
+#include <stdbool.h>        // boolean type
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // fprintf (for error messages)
+#include <stdlib.h>         // malloc, calloc, free
+#include <string.h>         // memset
+#include "fnnActivation.h"  // activation functions
+#include "fnnSerializer.h"  // activation function identifiers
+#include "xLinear.h"        // xMatrix objects of loaded model
+#include "xList.h"          // lists of loaded layer matrices
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static int32_t sparsifyLayer(FnnSparseLayer *layer, xMatrix *weights, xMatrix *biases, FnnActivation_e activation,
+                             float threshold);
+static inline bool keepWeight(const xMatrix *weights, uint32_t k, uint32_t j, float threshold);
+static void gemvDense(const FnnSparseLayer *layer, const float *input, float *acc);
+static void gemvCsr(const FnnSparseLayer *layer, const float *input, float *acc);
+static void gemvBlocked(const FnnSparseLayer *layer, const float *input, float *acc);
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+FnnSparseModel *fnn_sparsify(xList *weightMatrices, xList *biasMatrices, xList *activationFunctions, float threshold)
+{
+    // parameter checking
+    if (weightMatrices == NULL || biasMatrices == NULL || activationFunctions == NULL || weightMatrices->size == 0 ||
+        weightMatrices->size != biasMatrices->size || weightMatrices->size != activationFunctions->size || !(threshold >= 0.0f)) {
+        fprintf(stderr, "FNN Sparse: Invalid arguments\n");
+        return NULL;
+    }
+
+    // model allocation
+    FnnSparseModel *model = (FnnSparseModel *)calloc(1, sizeof(FnnSparseModel));
+    if (model == NULL) {
+        fprintf(stderr, "FNN Sparse: Failed to allocate model\n");
+        return NULL;
+    }
+    model->layers = (FnnSparseLayer *)calloc((size_t)weightMatrices->size, sizeof(FnnSparseLayer));
+    if (model->layers == NULL) {
+        fprintf(stderr, "FNN Sparse: Failed to allocate layers\n");
+        free(model);
+        return NULL;
+    }
+
+    // prune and convert layers
+    uint32_t maxOutputs = 0;
+    for (int i = 0; i < weightMatrices->size; i++) {
+        FnnSparseLayer *layer = &model->layers[i];
+        if (sparsifyLayer(layer, xList_get(weightMatrices, i), xList_get(biasMatrices, i),
+                          *(FnnActivation_e *)xList_get(activationFunctions, i), threshold) != 0) {
+            fnn_sparseFree(model);
+            return NULL;
+        }
+        model->layerCount++;
+        model->totalWeights += (uint64_t)layer->inputs * layer->outputs;
+        model->nonzeros += layer->nonzeros;
+
+        maxOutputs = (layer->outputs > maxOutputs) ? layer->outputs : maxOutputs;
+    }
+
+    // scratch buffers (products of blocked layers are written in whole blocks)
+    uint32_t paddedOutputs = (maxOutputs + FNN_SPARSE_BLOCK - 1) / FNN_SPARSE_BLOCK * FNN_SPARSE_BLOCK;
+    model->accBuffer = (float *)malloc(paddedOutputs * sizeof(float));
+    model->valueBuffer = (float *)malloc(maxOutputs * sizeof(float));
+    if (model->accBuffer == NULL || model->valueBuffer == NULL) {
+        fprintf(stderr, "FNN Sparse: Failed to allocate scratch buffers\n");
+        fnn_sparseFree(model);
+        return NULL;
+    }
+
+    return model;
+}
+
+void fnn_sparseFree(FnnSparseModel *model)
+{
+    if (model == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        free(model->layers[i].rowStarts);
+        free(model->layers[i].indices);
+        free(model->layers[i].values);
+        free(model->layers[i].biases);
+    }
+    free(model->layers);
+    free(model->accBuffer);
+    free(model->valueBuffer);
+    free(model);
+}
+
+void fnn_sparseForward(FnnSparseModel *model, const float *input, float *output, FnnPrecision_e precision)
+{
+    // pointer checking
+    if (model == NULL || input == NULL || output == NULL) {
+        return;
+    }
+
+    const float *current = input;
+    for (uint32_t i = 0; i < model->layerCount; i++) {
+        FnnSparseLayer *layer = &model->layers[i];
+        float *next = (i == model->layerCount - 1) ? output : model->valueBuffer;
+
+        // matrix-vector product in storage format of layer
+        switch (layer->format) {
+        case FNN_SPARSE_CSR:
+            gemvCsr(layer, current, model->accBuffer);
+            break;
+        case FNN_SPARSE_BLOCKED:
+            gemvBlocked(layer, current, model->accBuffer);
+            break;
+        default:
+            gemvDense(layer, current, model->accBuffer);
+            break;
+        }
+
+        // bias and activation (layer input is no longer needed, so hidden layers reuse single buffer)
+        for (uint32_t j = 0; j < layer->outputs; j++) {
+            next[j] = model->accBuffer[j] + layer->biases[j];
+        }
+        fnn_activate(next, layer->outputs, layer->activation, precision);
+
+        current = next;
+    }
+}
+
+const char *fnn_sparseFormatName(FnnSparseFormat_e format)
+{
+    switch (format) {
+    case FNN_SPARSE_CSR:
+        return "csr";
+    case FNN_SPARSE_BLOCKED:
+        return "blocked";
+    default:
+        return "dense";
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// prune weights of single layer and store them in format with least work per inference
+static int32_t sparsifyLayer(FnnSparseLayer *layer, xMatrix *weights, xMatrix *biases, FnnActivation_e activation,
+                             float threshold)
+{
+    layer->inputs = weights->rows;
+    layer->outputs = weights->cols;
+    layer->activation = activation;
+    if (biases->cols != weights->cols) {
+        fprintf(stderr, "FNN Sparse: Layer dimensions do not match\n");
+        return -1;
+    }
+
+    // density of pruned weights and of blocks containing them
+    uint32_t blocksPerInput = (layer->outputs + FNN_SPARSE_BLOCK - 1) / FNN_SPARSE_BLOCK;
+    uint32_t blockCount = 0;
+    for (uint32_t k = 0; k < layer->inputs; k++) {
+        for (uint32_t b = 0; b < blocksPerInput; b++) {
+            uint32_t blockNonzeros = 0;
+            for (uint32_t j = b * FNN_SPARSE_BLOCK; j < layer->outputs && j < (b + 1) * FNN_SPARSE_BLOCK; j++) {
+                blockNonzeros += keepWeight(weights, k, j, threshold) ? 1 : 0;
+            }
+            layer->nonzeros += blockNonzeros;
+            blockCount += (blockNonzeros > 0) ? 1 : 0;
+        }
+    }
+    float total = (float)layer->inputs * (float)layer->outputs;
+    float density = (float)layer->nonzeros / total;
+    float blockDensity = (float)blockCount * FNN_SPARSE_BLOCK / total;
+    if (blockDensity < FNN_SPARSE_DENSITY_THRESHOLD) {
+        layer->format = FNN_SPARSE_BLOCKED;
+    } else if (density < FNN_SPARSE_DENSITY_THRESHOLD) {
+        layer->format = FNN_SPARSE_CSR;
+    } else {
+        layer->format = FNN_SPARSE_DENSE;
+    }
+
+    // storage allocation
+    uint64_t valueCount = 0, indexCount = 0, rowCount = 0;
+    switch (layer->format) {
+    case FNN_SPARSE_CSR:
+        valueCount = indexCount = layer->nonzeros;
+        rowCount = (uint64_t)layer->outputs + 1;
+        break;
+    case FNN_SPARSE_BLOCKED:
+        valueCount = (uint64_t)blockCount * FNN_SPARSE_BLOCK;
+        indexCount = blockCount;
+        rowCount = (uint64_t)layer->inputs + 1;
+        break;
+    default:
+        valueCount = (uint64_t)layer->inputs * layer->outputs;
+        break;
+    }
+    // (blocked conversion writes one block past last nonzero block, other arrays are never empty)
+    layer->values = (float *)malloc((valueCount + FNN_SPARSE_BLOCK) * sizeof(float));
+    layer->indices = (uint32_t *)malloc((indexCount + 1) * sizeof(uint32_t));
+    layer->rowStarts = (uint32_t *)malloc((rowCount + 1) * sizeof(uint32_t));
+    layer->biases = (float *)malloc(layer->outputs * sizeof(float));
+    if (layer->values == NULL || layer->indices == NULL || layer->rowStarts == NULL || layer->biases == NULL) {
+        fprintf(stderr, "FNN Sparse: Failed to allocate layer\n");
+        return -1;
+    }
+    memcpy(layer->biases, biases->data, layer->outputs * sizeof(float));
+
+    // conversion
+    uint32_t position = 0;
+    switch (layer->format) {
+    case FNN_SPARSE_CSR:
+        for (uint32_t j = 0; j < layer->outputs; j++) {
+            layer->rowStarts[j] = position;
+            for (uint32_t k = 0; k < layer->inputs; k++) {
+                if (keepWeight(weights, k, j, threshold)) {
+                    layer->indices[position] = k;
+                    layer->values[position] = weights->data[(uint64_t)k * weights->stride + j];
+                    position++;
+                }
+            }
+        }
+        layer->rowStarts[layer->outputs] = position;
+        break;
+    case FNN_SPARSE_BLOCKED:
+        for (uint32_t k = 0; k < layer->inputs; k++) {
+            layer->rowStarts[k] = position;
+            for (uint32_t b = 0; b < blocksPerInput; b++) {
+                float *block = layer->values + (uint64_t)position * FNN_SPARSE_BLOCK;
+                uint32_t blockNonzeros = 0;
+                for (uint32_t t = 0; t < FNN_SPARSE_BLOCK; t++) {
+                    uint32_t j = b * FNN_SPARSE_BLOCK + t;
+                    bool keep = j < layer->outputs && keepWeight(weights, k, j, threshold);
+                    block[t] = keep ? weights->data[(uint64_t)k * weights->stride + j] : 0.0f;
+                    blockNonzeros += (block[t] != 0.0f) ? 1 : 0;
+                }
+                if (blockNonzeros > 0) {
+                    layer->indices[position++] = b * FNN_SPARSE_BLOCK;
+                }
+            }
+        }
+        layer->rowStarts[layer->inputs] = position;
+        break;
+    default:
+        for (uint32_t k = 0; k < layer->inputs; k++) {
+            for (uint32_t j = 0; j < layer->outputs; j++) {
+                layer->values[(uint64_t)k * layer->outputs + j] =
+                    keepWeight(weights, k, j, threshold) ? weights->data[(uint64_t)k * weights->stride + j] : 0.0f;
+            }
+        }
+        break;
+    }
+
+    return 0;
+}
+
+// weight survives pruning if it is nonzero and its magnitude reaches threshold
+static inline bool keepWeight(const xMatrix *weights, uint32_t k, uint32_t j, float threshold)
+{
+    float weight = weights->data[(uint64_t)k * weights->stride + j];
+    return weight != 0.0f && fabsf(weight) >= threshold;
+}
+
+// dense product of pruned weights
+static void gemvDense(const FnnSparseLayer *layer, const float *input, float *acc)
+{
+    memset(acc, 0, layer->outputs * sizeof(float));
+    for (uint32_t k = 0; k < layer->inputs; k++) {
+        const float value = input[k];
+        const float *row = layer->values + (uint64_t)k * layer->outputs;
+        for (uint32_t j = 0; j < layer->outputs; j++) {
+            acc[j] += value * row[j];
+        }
+    }
+}
+
+// one dot product of nonzero weights per output (inputs in increasing order)
+static void gemvCsr(const FnnSparseLayer *layer, const float *input, float *acc)
+{
+    for (uint32_t j = 0; j < layer->outputs; j++) {
+        float sum = 0.0f;
+        for (uint32_t p = layer->rowStarts[j]; p < layer->rowStarts[j + 1]; p++) {
+            sum += input[layer->indices[p]] * layer->values[p];
+        }
+        acc[j] = sum;
+    }
+}
+
+// scaled blocks of outputs added for each input (padding of last block writes past outputs into padded buffer)
+static void gemvBlocked(const FnnSparseLayer *layer, const float *input, float *acc)
+{
+    memset(acc, 0, (layer->outputs + FNN_SPARSE_BLOCK - 1) / FNN_SPARSE_BLOCK * FNN_SPARSE_BLOCK * sizeof(float));
+    for (uint32_t k = 0; k < layer->inputs; k++) {
+        const float value = input[k];
+        for (uint32_t p = layer->rowStarts[k]; p < layer->rowStarts[k + 1]; p++) {
+            const float *block = layer->values + (uint64_t)p * FNN_SPARSE_BLOCK;
+            float *target = acc + layer->indices[p];
+            for (uint32_t t = 0; t < FNN_SPARSE_BLOCK; t++) {
+                target[t] += value * block[t];
+            }
+        }
+    }
+}
@@ -0,0 +1,377 @@
+#include "fnnTrain.h"
+#include <math.h>           // sqrtf, logf (for Adam updates and cross-entropy loss)
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // fprintf (for error messages)
+#include <stdlib.h>         // calloc, free
+#include "commonUtility.h"  // C string utilities (for name lookup)
+#include "fnnActivation.h"  // activation functions
+#include "fnnSerializer.h"  // FNN model descriptor
+#include "xLinear.h"        // matrix operations
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static int32_t layerInit(FnnTrainLayer *layer, uint32_t inputs, uint32_t outputs, uint32_t batchCapacity,
+                         FnnOptimizer_e optimizer);
+static void layerFree(FnnTrainLayer *layer);
+static inline float activationDerivative(float output, FnnActivation_e activation);
+static void updateSgd(xMatrix *values, xMatrix *gradients, float learningRate);
+static void updateAdam(xMatrix *values, xMatrix *gradients, xMatrix *moments[2], float learningRate, float correction1,
+                       float correction2);
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+FnnTrainer *fnn_trainerNew(FnnModel *model, uint32_t batchCapacity, FnnOptimizer_e optimizer, FnnLoss_e loss, float learningRate)
+{
+    if (model == NULL || model->layerCount < 2 || model->neuronCounts == NULL || model->activationFunctions == NULL ||
+        model->weightValues == NULL || model->biasValues == NULL || batchCapacity == 0 || learningRate < 0.0f ||
+        (optimizer != FNN_OPTIMIZER_SGD && optimizer != FNN_OPTIMIZER_ADAM) || (loss != FNN_LOSS_MSE && loss != FNN_LOSS_BCE)) {
+        fprintf(stderr, "FNN Train: Invalid arguments\n");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < model->layerCount - 1; i++) {
+        if ((uint32_t)model->activationFunctions[i] > (uint32_t)FNN_ACTIVATION_TANH) {
+            fprintf(stderr, "FNN Train: Unknown activation function\n");
+            return NULL;
+        }
+    }
+    if (loss == FNN_LOSS_BCE && model->activationFunctions[model->layerCount - 2] != FNN_ACTIVATION_SIGMOID) {
+        fprintf(stderr, "FNN Train: Cross-entropy loss requires sigmoid output layer\n");
+        return NULL;
+    }
+
+    FnnTrainer *trainer = (FnnTrainer *)calloc(1, sizeof(FnnTrainer));
+    if (trainer == NULL) {
+        fprintf(stderr, "FNN Train: Failed to allocate memory for trainer\n");
+        return NULL;
+    }
+    trainer->layerCount = model->layerCount - 1;
+    trainer->batchCapacity = batchCapacity;
+    trainer->optimizer = optimizer;
+    trainer->loss = loss;
+    trainer->learningRate = learningRate;
+    if (learningRate == 0.0f) {
+        trainer->learningRate = (optimizer == FNN_OPTIMIZER_ADAM) ? FNN_TRAIN_DEFAULT_RATE_ADAM : FNN_TRAIN_DEFAULT_RATE_SGD;
+    }
+    trainer->layers = (FnnTrainLayer *)calloc(trainer->layerCount, sizeof(FnnTrainLayer));
+    if (trainer->layers == NULL) {
+        fprintf(stderr, "FNN Train: Failed to allocate memory for layers\n");
+        free(trainer);
+        return NULL;
+    }
+
+    // copy weights and biases of each layer (stored consecutively, weights as inputs x outputs)
+    const float *weightValues = model->weightValues;
+    const float *biasValues = model->biasValues;
+    for (uint32_t i = 0; i < trainer->layerCount; i++) {
+        FnnTrainLayer *layer = &trainer->layers[i];
+        uint32_t inputs = model->neuronCounts[i];
+        uint32_t outputs = model->neuronCounts[i + 1];
+        if (layerInit(layer, inputs, outputs, batchCapacity, optimizer) != 0) {
+            fprintf(stderr, "FNN Train: Failed to allocate memory for layer\n");
+            fnn_trainerFree(trainer);
+            return NULL;
+        }
+        for (uint64_t k = 0; k < (uint64_t)inputs * outputs; k++) {
+            layer->weights->data[k] = *(weightValues++);
+        }
+        for (uint32_t j = 0; j < outputs; j++) {
+            layer->biases->data[j] = *(biasValues++);
+        }
+        layer->activation = model->activationFunctions[i];
+    }
+
+    return trainer;
+}
+
+void fnn_trainerFree(FnnTrainer *trainer)
+{
+    if (trainer == NULL) {
+        return;
+    }
+
+    if (trainer->layers != NULL) {
+        for (uint32_t i = 0; i < trainer->layerCount; i++) {
+            layerFree(&trainer->layers[i]);
+        }
+        free(trainer->layers);
+    }
+    free(trainer);
+}
+
+xMatrix *fnn_trainForward(FnnTrainer *trainer, xMatrix *inputs)
+{
+    if (trainer == NULL || inputs == NULL || inputs->data == NULL || inputs->rows == 0 || inputs->rows > trainer->batchCapacity ||
+        inputs->cols != trainer->layers[0].weights->rows) {
+        fprintf(stderr, "FNN Train: Invalid batch of observations\n");
+        return NULL;
+    }
+
+    uint32_t rows = inputs->rows;
+    xMatrixView current = *inputs;
+    for (uint32_t i = 0; i < trainer->layerCount; i++) {
+        FnnTrainLayer *layer = &trainer->layers[i];
+
+        // outputs of batch are first rows of contiguous cache, so they can be activated in single call
+        xMatrixView next = xMatrix_viewSlice(layer->outputs, 0, rows, 0, layer->outputs->cols);
+        xMatrix_gemmParallel(&next, &current, XMATRIX_NORMAL, layer->weights, XMATRIX_NORMAL, 1.0f, 0.0f);
+        for (uint32_t r = 0; r < rows; r++) {
+            float *row = next.data + (uint64_t)r * next.stride;
+            for (uint32_t j = 0; j < next.cols; j++) {
+                row[j] += layer->biases->data[j];
+            }
+        }
+        fnn_activate(next.data, rows * next.cols, layer->activation, FNN_PRECISION_EXACT);
+
+        current = next;
+    }
+    trainer->batchRows = rows;
+    trainer->predictions = current;
+
+    return &trainer->predictions;
+}
+
+int32_t fnn_trainBackward(FnnTrainer *trainer, xMatrix *inputs, xMatrix *targets, float *loss)
+{
+    if (trainer == NULL || inputs == NULL || targets == NULL || trainer->batchRows == 0 || inputs->rows != trainer->batchRows ||
+        inputs->cols != trainer->layers[0].weights->rows || targets->rows != trainer->batchRows ||
+        targets->cols != trainer->layers[trainer->layerCount - 1].weights->cols) {
+        fprintf(stderr, "FNN Train: Batch does not match last forward pass\n");
+        return -1;
+    }
+
+    // errors of output layer (loss is averaged over observations of batch)
+    uint32_t rows = trainer->batchRows;
+    float scale = 1.0f / (float)rows;
+    FnnTrainLayer *last = &trainer->layers[trainer->layerCount - 1];
+    double totalLoss = 0.0;
+    for (uint32_t r = 0; r < rows; r++) {
+        const float *output = last->outputs->data + (uint64_t)r * last->outputs->stride;
+        const float *target = targets->data + (uint64_t)r * targets->stride;
+        float *error = last->errors->data + (uint64_t)r * last->errors->stride;
+        for (uint32_t j = 0; j < last->outputs->cols; j++) {
+            float difference = output[j] - target[j];
+            if (trainer->loss == FNN_LOSS_BCE) {
+                // derivative of sigmoid cancels with derivative of cross-entropy
+                float clamped = fminf(fmaxf(output[j], FNN_TRAIN_BCE_CLAMP), 1.0f - FNN_TRAIN_BCE_CLAMP);
+                totalLoss -= target[j] * logf(clamped) + (1.0f - target[j]) * logf(1.0f - clamped);
+                error[j] = difference * scale;
+            } else {
+                totalLoss += 0.5 * difference * difference;
+                error[j] = difference * activationDerivative(output[j], last->activation) * scale;
+            }
+        }
+    }
+    if (loss != NULL) {
+        *loss = (float)(totalLoss / rows);
+    }
+
+    // gradients of each layer and errors propagated to previous layer
+    for (uint32_t i = trainer->layerCount; i-- > 0;) {
+        FnnTrainLayer *layer = &trainer->layers[i];
+        xMatrixView errors = xMatrix_viewSlice(layer->errors, 0, rows, 0, layer->errors->cols);
+        xMatrixView previous =
+            (i == 0) ? *inputs : xMatrix_viewSlice(trainer->layers[i - 1].outputs, 0, rows, 0, layer->weights->rows);
+
+        xMatrix_gemmParallel(layer->weightGradients, &previous, XMATRIX_TRANSPOSE, &errors, XMATRIX_NORMAL, 1.0f, 0.0f);
+        for (uint32_t j = 0; j < errors.cols; j++) {
+            layer->biasGradients->data[j] = 0.0f;
+        }
+        for (uint32_t r = 0; r < rows; r++) {
+            const float *error = errors.data + (uint64_t)r * errors.stride;
+            for (uint32_t j = 0; j < errors.cols; j++) {
+                layer->biasGradients->data[j] += error[j];
+            }
+        }
+
+        if (i > 0) {
+            FnnTrainLayer *below = &trainer->layers[i - 1];
+            xMatrixView belowErrors = xMatrix_viewSlice(below->errors, 0, rows, 0, below->errors->cols);
+            xMatrix_gemmParallel(&belowErrors, &errors, XMATRIX_NORMAL, layer->weights, XMATRIX_TRANSPOSE, 1.0f, 0.0f);
+            for (uint64_t k = 0; k < (uint64_t)rows * belowErrors.cols; k++) {
+                belowErrors.data[k] *= activationDerivative(previous.data[k], below->activation);
+            }
+        }
+    }
+
+    return 0;
+}
+
+void fnn_trainUpdate(FnnTrainer *trainer)
+{
+    if (trainer == NULL) {
+        return;
+    }
+
+    trainer->steps++;
+    float correction1 = 1.0f - powf(FNN_TRAIN_ADAM_BETA1, (float)trainer->steps);
+    float correction2 = 1.0f - powf(FNN_TRAIN_ADAM_BETA2, (float)trainer->steps);
+    for (uint32_t i = 0; i < trainer->layerCount; i++) {
+        FnnTrainLayer *layer = &trainer->layers[i];
+        if (trainer->optimizer == FNN_OPTIMIZER_ADAM) {
+            updateAdam(layer->weights, layer->weightGradients, layer->weightMoments, trainer->learningRate, correction1,
+                       correction2);
+            updateAdam(layer->biases, layer->biasGradients, layer->biasMoments, trainer->learningRate, correction1, correction2);
+        } else {
+            updateSgd(layer->weights, layer->weightGradients, trainer->learningRate);
+            updateSgd(layer->biases, layer->biasGradients, trainer->learningRate);
+        }
+    }
+}
+
+int32_t fnn_trainBatch(FnnTrainer *trainer, xMatrix *inputs, xMatrix *targets, float *loss)
+{
+    if (fnn_trainForward(trainer, inputs) == NULL || fnn_trainBackward(trainer, inputs, targets, loss) != 0) {
+        return -1;
+    }
+    fnn_trainUpdate(trainer);
+
+    return 0;
+}
+
+int32_t fnn_trainerExport(FnnTrainer *trainer, FnnModel *model)
+{
+    if (trainer == NULL || model == NULL || model->layerCount != trainer->layerCount + 1 || model->weightValues == NULL ||
+        model->biasValues == NULL) {
+        fprintf(stderr, "FNN Train: Model does not match trainer\n");
+        return -1;
+    }
+    for (uint32_t i = 0; i < trainer->layerCount; i++) {
+        if (model->neuronCounts[i] != trainer->layers[i].weights->rows ||
+            model->neuronCounts[i + 1] != trainer->layers[i].weights->cols) {
+            fprintf(stderr, "FNN Train: Model does not match trainer\n");
+            return -1;
+        }
+    }
+
+    float *weightValues = model->weightValues;
+    float *biasValues = model->biasValues;
+    for (uint32_t i = 0; i < trainer->layerCount; i++) {
+        FnnTrainLayer *layer = &trainer->layers[i];
+        for (uint64_t k = 0; k < (uint64_t)layer->weights->rows * layer->weights->cols; k++) {
+            *(weightValues++) = layer->weights->data[k];
+        }
+        for (uint32_t j = 0; j < layer->biases->cols; j++) {
+            *(biasValues++) = layer->biases->data[j];
+        }
+    }
+
+    return 0;
+}
+
+int32_t fnn_optimizerFromName(const char *name, FnnOptimizer_e *optimizer)
+{
+    if (name == NULL || optimizer == NULL) {
+        return -1;
+    }
+
+    if (cu_CStringCompare(name, "sgd") == 0) {
+        *optimizer = FNN_OPTIMIZER_SGD;
+    } else if (cu_CStringCompare(name, "adam") == 0) {
+        *optimizer = FNN_OPTIMIZER_ADAM;
+    } else {
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t fnn_lossFromName(const char *name, FnnLoss_e *loss)
+{
+    if (name == NULL || loss == NULL) {
+        return -1;
+    }
+
+    if (cu_CStringCompare(name, "mse") == 0) {
+        *loss = FNN_LOSS_MSE;
+    } else if (cu_CStringCompare(name, "bce") == 0) {
+        *loss = FNN_LOSS_BCE;
+    } else {
+        return -1;
+    }
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// allocate parameters, gradients, optimizer state and batch cache of layer (all matrices are contiguous)
+static int32_t layerInit(FnnTrainLayer *layer, uint32_t inputs, uint32_t outputs, uint32_t batchCapacity,
+                         FnnOptimizer_e optimizer)
+{
+    layer->weights = xMatrix_new(inputs, outputs);
+    layer->biases = xMatrix_new(1, outputs);
+    layer->weightGradients = xMatrix_new(inputs, outputs);
+    layer->biasGradients = xMatrix_new(1, outputs);
+    layer->outputs = xMatrix_new(batchCapacity, outputs);
+    layer->errors = xMatrix_new(batchCapacity, outputs);
+    if (layer->weights == NULL || layer->biases == NULL || layer->weightGradients == NULL || layer->biasGradients == NULL ||
+        layer->outputs == NULL || layer->errors == NULL) {
+        return -1;
+    }
+
+    if (optimizer == FNN_OPTIMIZER_ADAM) {
+        for (int m = 0; m < 2; m++) {
+            layer->weightMoments[m] = xMatrix_new(inputs, outputs);
+            layer->biasMoments[m] = xMatrix_new(1, outputs);
+            if (layer->weightMoments[m] == NULL || layer->biasMoments[m] == NULL) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static void layerFree(FnnTrainLayer *layer)
+{
+    xMatrix_free(layer->weights);
+    xMatrix_free(layer->biases);
+    xMatrix_free(layer->weightGradients);
+    xMatrix_free(layer->biasGradients);
+    for (int m = 0; m < 2; m++) {
+        xMatrix_free(layer->weightMoments[m]);
+        xMatrix_free(layer->biasMoments[m]);
+    }
+    xMatrix_free(layer->outputs);
+    xMatrix_free(layer->errors);
+}
+
+// derivative of activation function expressed through its output
+static inline float activationDerivative(float output, FnnActivation_e activation)
+{
+    switch (activation) {
+        case FNN_ACTIVATION_SIGMOID:
+            return output * (1.0f - output);
+        case FNN_ACTIVATION_RELU:
+            return (output > 0.0f) ? 1.0f : 0.0f;
+        case FNN_ACTIVATION_TANH:
+            return 1.0f - output * output;
+        default:
+            return 1.0f;
+    }
+}
+
+static void updateSgd(xMatrix *values, xMatrix *gradients, float learningRate)
+{
+    uint64_t count = (uint64_t)values->rows * values->cols;
+    for (uint64_t k = 0; k < count; k++) {
+        values->data[k] -= learningRate * gradients->data[k];
+    }
+}
+
+static void updateAdam(xMatrix *values, xMatrix *gradients, xMatrix *moments[2], float learningRate, float correction1,
+                       float correction2)
+{
+    uint64_t count = (uint64_t)values->rows * values->cols;
+    float *first = moments[0]->data;
+    float *second = moments[1]->data;
+    for (uint64_t k = 0; k < count; k++) {
+        float gradient = gradients->data[k];
+        first[k] = FNN_TRAIN_ADAM_BETA1 * first[k] + (1.0f - FNN_TRAIN_ADAM_BETA1) * gradient;
+        second[k] = FNN_TRAIN_ADAM_BETA2 * second[k] + (1.0f - FNN_TRAIN_ADAM_BETA2) * gradient * gradient;
+        values->data[k] -= learningRate * (first[k] / correction1) / (sqrtf(second[k] / correction2) + FNN_TRAIN_ADAM_EPSILON);
+    }
+}
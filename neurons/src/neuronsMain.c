@@ -1,15 +1,27 @@
 #include "neuronsMain.h"
+#include <inttypes.h>      // format macros of fixed size integers
 #include <math.h>          // math functions
 #include <signal.h>        // signal handling (will be used for graceful exit)
 #include <stdbool.h>       // boolean type
 #include <stdio.h>         // console input/output
 #include <stdlib.h>        // malloc, free, etc.
 #include <time.h>          // time functions (for random number generation)
+#include "commonUtility.h" // C string utilities (for parsing command line arguments)
+#include "fnnActivation.h" // vectorized activation functions
+#include "fnnFixed.h"      // forward kernels specialized for fixed architectures
+#include "fnnForward.h"    // batched float inference
+#include "fnnHalf.h"       // half precision (FP16/BF16) weight inference
 #include "fnnLoader.h"     // feedforward neural network loader (.fnnm file format)
+#include "fnnQuantize.h"   // int8 quantized inference
+#include "fnnSparse.h"     // pruned sparse inference
+#include "neuronsServe.h"  // serving many game instances from one process
 #include "sharedMemory.h"  // shared memory
+#include "xHistogram.h"    // latency histograms (inference statistics)
 #include "xLinear.h"       // matrix operations
 #include "xList.h"         // list structure and operations
+#include "xSimd.h"         // deterministic mode of float kernels
 #include "xString.h"       // string operations (for parsing command line arguments)
+#include "xThreadPool.h"   // process-wide thread pool (batched work)
 
 // ----------------------------------------------------------------------------------------------
 // global variables
@@ -17,6 +29,13 @@
 struct sigaction sigact;  // signal action for graceful exit
 
 static char *cmd_configFilename = NULL;  // path to pre-generated model file
+static char *cmd_precisionName = NULL;   // name of activation precision mode
+static char *cmd_weightsName = NULL;     // name of weight storage format
+static char *cmd_calibrateCount = NULL;  // number of calibration samples (as string)
+static char *cmd_threadCount = NULL;     // number of worker threads for batched work (as string)
+static char *cmd_pruneThreshold = NULL;  // magnitude below which weights are pruned (as string)
+static char *cmd_serveFilename = NULL;   // path to file listing served instances
+static char *cmd_genomeIndex = NULL;     // index of genome in packed population file (as string)
 static char *cmd_shInputName = NULL;     // shared input memory name
 static char *cmd_shOutputName = NULL;    // shared output memory name
 static char *cmd_shStateName = NULL;     // shared state memory name
@@ -26,6 +45,18 @@ static struct sharedState_s *shState = NULL;
 
 static unsigned short flags_cmd = CMD_FLAG_NONE;  // command line argument flags
 static unsigned short flags_runtime;              // program runtime flags (running, paused, exit, etc.)
+static FnnPrecision_e activationPrecision = FNN_PRECISION_EXACT;  // precision mode of sigmoid and tanh activations
+static enum weightFormat_e weightFormat = WEIGHTS_FP32;           // storage format of weights used for inference
+static float pruneThreshold = 0.0f;                               // magnitude below which weights are pruned
+
+static xHistogram statForwardTime;        // forward pass times (nanoseconds)
+static xHistogram statCycleTime;          // read, forward and write cycle times (nanoseconds)
+static uint64_t statInferences = 0;       // number of forward passes
+static uint64_t statDuplicates = 0;       // number of forward passes on observation which was already evaluated
+static uint64_t statStartTime = 0;        // time of first forward pass (nanoseconds)
+static uint64_t statPublishTime = 0;      // time of last publishing of statistics to shared state (nanoseconds)
+static uint32_t observationSequence = 0;  // sequence number of observation read from shared output
+static uint32_t evaluatedSequence = 0;    // sequence number of last evaluated observation
 
 xList *weightMatrices = NULL;        // list of weight matrices
 xList *biasMatrices = NULL;          // list of bias matrices
@@ -35,6 +66,12 @@ xList *activationFunctions = NULL;   // list of activation functions for each la
 xMatrix *input = NULL;   // input matrix (1x8)
 xMatrix *output = NULL;  // output matrix (1x4)
 
+FnnQuantModel *quantModel = NULL;    // int8 quantized model (if used)
+FnnHalfModel *halfModel = NULL;      // FP16/BF16 model (if used)
+FnnFixedModel *fixedModel = NULL;    // float model with specialized forward function (if architecture matches)
+FnnMappedModel *mappedModel = NULL;  // memory mapped model file (weight and bias matrices are views into it)
+FnnSparseModel *sparseModel = NULL;  // pruned model (if used)
+
 // ----------------------------------------------------------------------------------------------
 // local function declarations
 
@@ -46,19 +83,18 @@ static inline void UpdateSharedOutput(void);                  // update output t
 static void fillUniform(xMatrix *mat, float min, float max);  // fill matrix with random values in from uniform distribution
 static float normalRandom(float mean, float stddev);  // generate normally distributed random number (using Box-Muller transform)
 static void fillNormal(xMatrix *mat, float mean, float stddev);  // fill matrix with random values from normal distribution
-static inline float activation_none(float x);                    // neural network pass-through activation function
-static inline float activation_sigmoid(float x);                 // neural network sigmoid function
-static inline float activation_reLU(float x);                    // neural network reLU activation function
-static inline float activation_tanh(float x);                    // neural network tanh activation function
 static inline void InitNeurons(void);                            // initialize neural network
 static inline void UpdateNeurons(void);                          // update neural network (one frame)
+static inline void ForwardNeurons(void);                         // run inference from input to output matrix
+static inline void ForwardFloat(void);                           // run inference using float weight matrices
+static void CalibrateNeurons(uint32_t samples);  // compare reduced precision inference against float inference
 static inline void UnloadNeurons(void);                          // unload dynamic structures of neural network
+static inline uint64_t MonotonicTime(void);                      // monotonic clock in nanoseconds
+static inline void RecordStatistics(uint64_t start, uint64_t forwardStart, uint64_t forwardEnd, uint64_t end);
+static void PublishStatistics(uint64_t now);                     // write inference statistics to shared state
+static void PrintStatistics(void);                               // print inference statistics to console
 static void signalHandler(int signal);                           // signal handler for graceful exit
 
-// ----------------------------------------------------------------------------------------------
-// activation functions table
-float (*activationTable[])(float) = {activation_none, activation_sigmoid, activation_reLU, activation_tanh};
-
 // ----------------------------------------------------------------------------------------------
 // program entry point (main)
 
@@ -107,6 +143,64 @@ int main(int argc, char *argv[])
                 cmd_configFilename = argv[i + 1];
 
                 i += 1;
+            } else if (xString_isEqualCString(arg, "-p") || xString_isEqualCString(arg, "--precision")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_PRECISION;
+                cmd_precisionName = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-w") || xString_isEqualCString(arg, "--weights")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_WEIGHTS;
+                cmd_weightsName = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-c") || xString_isEqualCString(arg, "--calibrate")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_CALIBRATE;
+                cmd_calibrateCount = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-t") || xString_isEqualCString(arg, "--threads")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_THREADS;
+                cmd_threadCount = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-z") || xString_isEqualCString(arg, "--prune")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_PRUNE;
+                cmd_pruneThreshold = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-S") || xString_isEqualCString(arg, "--serve")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_SERVE;
+                cmd_serveFilename = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-g") || xString_isEqualCString(arg, "--genome")) {
+                if (i + 1 > argc)
+                    break;
+
+                flags_cmd |= CMD_FLAG_GENOME;
+                cmd_genomeIndex = argv[i + 1];
+
+                i += 1;
+            } else if (xString_isEqualCString(arg, "-D") || xString_isEqualCString(arg, "--deterministic")) {
+                flags_cmd |= CMD_FLAG_DETERMINISTIC;
             } else {
                 printf("ERROR: Unknown command line argument: %s\n", argv[i]);
                 printf("Use %s --help for more information.\n", argv[0]);
@@ -125,7 +219,9 @@ int main(int argc, char *argv[])
     // check flag conflicts
     if ((flags_cmd & CMD_FLAG_STANDALONE && flags_cmd & CMD_FLAG_MANAGED) ||  // managed mode extends standalone mode
         (flags_cmd & CMD_FLAG_HELP && flags_cmd & ~CMD_FLAG_HELP) ||          // help flag is exclusive
-        (flags_cmd & CMD_FLAG_VERSION && flags_cmd & ~CMD_FLAG_VERSION)) {    // version flag is exclusive
+        (flags_cmd & CMD_FLAG_VERSION && flags_cmd & ~CMD_FLAG_VERSION) ||    // version flag is exclusive
+        (flags_cmd & CMD_FLAG_SERVE &&                                        // serve mode takes models from instance file
+         flags_cmd & ~(CMD_FLAG_SERVE | CMD_FLAG_PRECISION | CMD_FLAG_THREADS | CMD_FLAG_DETERMINISTIC))) {
         printf("ERROR: Invalid command line arguments.\n");
         printf("Use %s --help for more information.\n", argv[0]);
         return 1;
@@ -143,6 +239,14 @@ int main(int argc, char *argv[])
         printf("  -m, --managed <input> <output> <state>\tRun in managed mode.\n");
         printf("  -l, --load <config>\t\t\t\tLoad configuration file.\n");
         printf("  -r, --random <seed>\t\t\t\tSet random seed for network initialization.\n");
+        printf("  -p, --precision <mode>\t\t\tSet precision of sigmoid and tanh activations.\n");
+        printf("  -w, --weights <format>\t\t\tSet storage format of weights used for inference.\n");
+        printf("  -c, --calibrate <samples>\t\t\tReport disagreement of reduced precision or pruned weights with float weights.\n");
+        printf("  -t, --threads <count>\t\t\t\tSet number of threads for batched work (0 for one per CPU, default).\n");
+        printf("  -z, --prune <threshold>\t\t\tPrune float weights with magnitude below threshold (sparse inference).\n");
+        printf("  -S, --serve <instances>\t\t\tServe all game instances listed in file from this process.\n");
+        printf("  -D, --deterministic\t\t\t\tUse float kernels giving same results on every CPU (no fused multiply-add).\n");
+        printf("  -g, --genome <index>\t\t\t\tLoad genome of given index from packed population file given to --load.\n");
         printf("\n");
         printf("Standalone mode:\n");
         printf("  <input>\tShared memory name for input.\n");
@@ -153,9 +257,26 @@ int main(int argc, char *argv[])
         printf("  <output>\tShared memory name for output.\n");
         printf("  <state>\tShared memory name for state.\n");
         printf("\n");
+        printf("Serve mode:\n");
+        printf("  <instances>\tFile with one instance per line: <input> <output> <state> <model> [<genome>].\n");
+        printf("  \t\tGenome index selects genome of packed population file given as model.\n");
+        printf("  \t\tServe mode is standalone tool (manager starts one process per game).\n");
+        printf("  \t\tOnly precision, thread count (number of serving threads) and deterministic options can be combined\n");
+        printf("  \t\twith it.\n");
+        printf("\n");
         printf("Configuration file:\n");
         printf("  <config>\tConfiguration file path.\n");
         printf("\n");
+        printf("Activation precision:\n");
+        printf("  exact\tEvaluate activations using libm (default).\n");
+        printf("  fast\tEvaluate activations using vectorized approximation (max error %.1e).\n", FNN_FAST_TANH_MAX_ERROR);
+        printf("\n");
+        printf("Weight format:\n");
+        printf("  fp32\tSingle precision float weights (default).\n");
+        printf("  int8\t8-bit integer weights with per neuron scales.\n");
+        printf("  fp16\tIEEE half precision weights.\n");
+        printf("  bf16\tBfloat16 weights.\n");
+        printf("\n");
         printf("Shared memory name:\n");
         printf("  Shared memory name must start with a slash and contain only alphanumeric characters.\n");
         printf("  Maximum length is 255 characters.\n");
@@ -183,6 +304,74 @@ int main(int argc, char *argv[])
         }
     }
 
+    // float kernels giving same results on every SIMD level
+    if (flags_cmd & CMD_FLAG_DETERMINISTIC) {
+        xSimd_setDeterministic(1);
+    }
+
+    // parse activation precision mode
+    if (flags_cmd & CMD_FLAG_PRECISION && fnn_precisionFromName(cmd_precisionName, &activationPrecision) != 0) {
+        printf("ERROR: Unknown activation precision mode: %s\n", cmd_precisionName);
+        return 1;
+    }
+
+    // parse weight storage format
+    if (flags_cmd & CMD_FLAG_WEIGHTS) {
+        if (cu_CStringCompare(cmd_weightsName, "fp32") == 0) {
+            weightFormat = WEIGHTS_FP32;
+        } else if (cu_CStringCompare(cmd_weightsName, "int8") == 0) {
+            weightFormat = WEIGHTS_INT8;
+        } else if (cu_CStringCompare(cmd_weightsName, "fp16") == 0) {
+            weightFormat = WEIGHTS_FP16;
+        } else if (cu_CStringCompare(cmd_weightsName, "bf16") == 0) {
+            weightFormat = WEIGHTS_BF16;
+        } else {
+            printf("ERROR: Unknown weight format: %s\n", cmd_weightsName);
+            return 1;
+        }
+    }
+    if (flags_cmd & CMD_FLAG_GENOME && (!(flags_cmd & CMD_FLAG_LOADCFG) || !cu_CStringIsNumeric(cmd_genomeIndex))) {
+        printf("ERROR: Invalid genome index: %s\n", cmd_genomeIndex);
+        return 1;
+    }
+    if (flags_cmd & CMD_FLAG_CALIBRATE && (!cu_CStringIsNumeric(cmd_calibrateCount) || cu_CStringToInteger(cmd_calibrateCount) <= 0)) {
+        printf("ERROR: Invalid calibration sample count: %s\n", cmd_calibrateCount);
+        return 1;
+    }
+    if (flags_cmd & CMD_FLAG_THREADS) {
+        if (!cu_CStringIsNumeric(cmd_threadCount) || cu_CStringToInteger(cmd_threadCount) < 0) {
+            printf("ERROR: Invalid thread count: %s\n", cmd_threadCount);
+            return 1;
+        }
+        if (!(flags_cmd & CMD_FLAG_SERVE)) {
+            xThreadPool_init((uint32_t)cu_CStringToInteger(cmd_threadCount));
+        }
+    }
+    if (flags_cmd & CMD_FLAG_PRUNE) {
+        char *end = NULL;
+        pruneThreshold = strtof(cmd_pruneThreshold, &end);
+        if (end == cmd_pruneThreshold || *end != '\0' || !(pruneThreshold >= 0.0f)) {
+            printf("ERROR: Invalid pruning threshold: %s\n", cmd_pruneThreshold);
+            return 1;
+        }
+        if (weightFormat != WEIGHTS_FP32) {
+            printf("ERROR: Pruning is only supported with fp32 weights.\n");
+            return 1;
+        }
+    }
+
+    // serve mode runs its own loop over all listed instances
+    if (flags_cmd & CMD_FLAG_SERVE) {
+        sigact.sa_handler = signalHandler;
+        sigact.sa_flags = SA_NODEFER;
+        sigemptyset(&sigact.sa_mask);
+        sigaction(SIGINT, &sigact, NULL);
+        sigaction(SIGTERM, &sigact, NULL);
+
+        uint32_t serveThreads = (flags_cmd & CMD_FLAG_THREADS) ? (uint32_t)cu_CStringToInteger(cmd_threadCount) : 0;
+        return (neuronsServe_run(cmd_serveFilename, serveThreads, activationPrecision) == 0) ? 0 : 1;
+    }
+
     // initialize neural network, connect to shared memory and register signal handler
     InitNeurons();
 
@@ -193,6 +382,7 @@ int main(int argc, char *argv[])
 
     // free dynamic structures
     UnloadNeurons();
+    xThreadPool_shutdown();
 
     return 0;
 }
@@ -304,6 +494,7 @@ inline void UpdateSharedOutput(void)
     // xMatrix_set(input, 0, 5, shOutput->gameOutput06);
     // xMatrix_set(input, 0, 6, shOutput->gameOutput07);
     // xMatrix_set(input, 0, 7, shOutput->gameOutput08);
+    observationSequence = shOutput->sequence;
     sm_unlockSharedOutput(shOutput);
 
     return;
@@ -356,18 +547,6 @@ float normalRandom(float mean, float stddev)
     }
 }
 
-// neural network pass-through activation function
-inline float activation_none(float x) { return x; }
-
-// sigmoid sigmoid function
-inline float activation_sigmoid(float x) { return 1.0f / (1.0f + expf(-x)); }
-
-// reLU activation function
-inline float activation_reLU(float x) { return (x > 0.0f) ? x : 0.0f; }
-
-// tanh activation function
-inline float activation_tanh(float x) { return tanhf(x); }
-
 // initialize neural network program
 inline void InitNeurons(void)
 {
@@ -379,8 +558,14 @@ inline void InitNeurons(void)
 
     // load matrices from file or generate random
     if (flags_cmd & CMD_FLAG_LOADCFG && cmd_configFilename != NULL) {
-        // try to load model from file
-        if (fnn_loadModel(cmd_configFilename, weightMatrices, biasMatrices, activationFunctions) != 0) {
+        // try to map model from file (weights and biases are used directly from mapping)
+        if (flags_cmd & CMD_FLAG_GENOME) {
+            mappedModel = fnn_mapPopulationModel(cmd_configFilename, (uint32_t)cu_CStringToInteger(cmd_genomeIndex), weightMatrices,
+                                                 biasMatrices, activationFunctions);
+        } else {
+            mappedModel = fnn_mapModel(cmd_configFilename, weightMatrices, biasMatrices, activationFunctions);
+        }
+        if (mappedModel == NULL) {
             printf("ERROR: Failed to load model from file.\n");
             exit(1);
         }
@@ -436,6 +621,45 @@ inline void InitNeurons(void)
         exit(1);
     }
 
+    // convert weights to reduced precision format
+    if (weightFormat == WEIGHTS_INT8) {
+        quantModel = fnn_quantize(weightMatrices, biasMatrices, activationFunctions);
+        if (quantModel == NULL) {
+            printf("ERROR: Failed to quantize model.\n");
+            exit(1);
+        }
+    } else if (weightFormat == WEIGHTS_FP16 || weightFormat == WEIGHTS_BF16) {
+        halfModel = fnn_halfConvert(weightMatrices, biasMatrices, activationFunctions,
+                                    (weightFormat == WEIGHTS_BF16) ? FNN_HALF_BF16 : FNN_HALF_FP16);
+        if (halfModel == NULL) {
+            printf("ERROR: Failed to convert model to half precision.\n");
+            exit(1);
+        }
+    } else if (flags_cmd & CMD_FLAG_PRUNE) {
+        // storage format of every layer is chosen by its density after pruning
+        sparseModel = fnn_sparsify(weightMatrices, biasMatrices, activationFunctions, pruneThreshold);
+        if (sparseModel == NULL) {
+            printf("ERROR: Failed to prune model.\n");
+            exit(1);
+        }
+    } else {
+        // generic float inference is used if architecture is not specialized
+        fixedModel = fnn_fixedSelect(weightMatrices, biasMatrices, activationFunctions);
+    }
+
+    // agreement with dense float model is always reported for pruned model
+    if (flags_cmd & CMD_FLAG_CALIBRATE) {
+        CalibrateNeurons((uint32_t)cu_CStringToInteger(cmd_calibrateCount));
+    } else if (flags_cmd & CMD_FLAG_PRUNE) {
+        CalibrateNeurons(PRUNE_CALIBRATION_SAMPLES);
+    }
+
+    // float weights are no longer needed once converted
+    if (weightFormat != WEIGHTS_FP32) {
+        xList_forEach(weightMatrices, (void (*)(void *))xMatrix_free);
+        xList_clear(weightMatrices);
+    }
+
     // connect to shared memory
     OpenSharedMemory();
 
@@ -449,6 +673,10 @@ inline void InitNeurons(void)
     // set runtime flags
     flags_runtime |= RUNTIME_RUNNING;
 
+    // clear inference statistics
+    xHistogram_reset(&statForwardTime);
+    xHistogram_reset(&statCycleTime);
+
     // report to shared state that program is running
     if (flags_cmd & CMD_FLAG_MANAGED) {
         sm_lockSharedState(shState);
@@ -466,8 +694,45 @@ inline void UpdateNeurons(void)
     UpdateSharedState();
 
     // update output from shared memory, game output (NN input)
+    uint64_t timeStart = MonotonicTime();
     UpdateSharedOutput();
 
+    // calculate output of network
+    uint64_t timeForwardStart = MonotonicTime();
+    ForwardNeurons();
+    uint64_t timeForwardEnd = MonotonicTime();
+
+    // update input to shared memory, game input (NN output)
+    UpdateSharedInput();
+    RecordStatistics(timeStart, timeForwardStart, timeForwardEnd, MonotonicTime());
+}
+
+// run inference from input to output matrix using selected weight format
+inline void ForwardNeurons(void)
+{
+    switch (weightFormat) {
+    case WEIGHTS_INT8:
+        fnn_quantForward(quantModel, input->data, output->data, activationPrecision);
+        break;
+    case WEIGHTS_FP16:
+    case WEIGHTS_BF16:
+        fnn_halfForward(halfModel, input->data, output->data, activationPrecision);
+        break;
+    default:
+        if (sparseModel != NULL) {
+            fnn_sparseForward(sparseModel, input->data, output->data, activationPrecision);
+        } else if (fixedModel != NULL) {
+            fnn_fixedForward(fixedModel, input->data, output->data, activationPrecision);
+        } else {
+            ForwardFloat();
+        }
+        break;
+    }
+}
+
+// run inference using float weight matrices
+inline void ForwardFloat(void)
+{
     // calculate intermediate matrices
     for (int i = 0; i < intermediateMatrices->size - 1; i++) {
         // get references to required matrices
@@ -475,28 +740,103 @@ inline void UpdateNeurons(void)
         xMatrix *intermediateNext = xList_get(intermediateMatrices, i + 1);
         xMatrix *weightCurrent = xList_get(weightMatrices, i);
         xMatrix *biasCurrent = xList_get(biasMatrices, i);
-        float (*activationFunction)(float) = activationTable[*(int *)xList_get(activationFunctions, i)];
+        FnnActivation_e activationFunction = *(FnnActivation_e *)xList_get(activationFunctions, i);
 
         // inference for current layer
         xMatrix_dot(intermediateNext, intermediateCurrent, weightCurrent);
         xMatrix_add(intermediateNext, intermediateNext, biasCurrent);
-        for (uint32_t j = 0; j < ((xMatrix *)xList_get(intermediateMatrices, i + 1))->cols; j++) {
-            xMatrix_set(intermediateNext, 0, j, activationFunction(xMatrix_get(intermediateNext, 0, j)));
+        fnn_activate(intermediateNext->data, intermediateNext->cols, activationFunction, activationPrecision);
+    }
+}
+
+// compare reduced precision inference against float inference on random observations (in ranges produced by the game)
+void CalibrateNeurons(uint32_t samples)
+{
+    float maxDifference = 0.0f;
+    uint32_t disagreements = 0;
+    uint32_t actionDisagreements[4] = {0};
+
+    // random observations and float reference outputs (computed as one batch)
+    xMatrix *observations = xMatrix_new(samples, 5);
+    xMatrix *references = xMatrix_new(samples, 4);
+    if (observations == NULL || references == NULL) {
+        printf("ERROR: Failed to allocate calibration samples.\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < samples; i++) {
+        for (uint32_t j = 0; j < 5; j++) {
+            float minValue = (j == 3) ? 0.0f : -1.0f;  // closest asteroid distance is in [0, 1], everything else in [-1, 1]
+            observations->data[i * 5 + j] = minValue + (1.0f - minValue) * rand() / (float)RAND_MAX;
         }
     }
+    if (fnn_forwardBatchParallel(weightMatrices, biasMatrices, activationFunctions, observations, references,
+                                 activationPrecision) != 0) {
+        printf("ERROR: Failed to run calibration inference.\n");
+        exit(1);
+    }
 
-    // update input to shared memory, game input (NN output)
-    UpdateSharedInput();
+    for (uint32_t i = 0; i < samples; i++) {
+        const float *reference = references->data + i * 4;
+        for (uint32_t j = 0; j < 5; j++) {
+            input->data[j] = observations->data[i * 5 + j];
+        }
+        ForwardNeurons();
+
+        bool disagree = false;
+        for (uint32_t j = 0; j < 4; j++) {
+            float difference = fabsf(output->data[j] - reference[j]);
+            maxDifference = (difference > maxDifference) ? difference : maxDifference;
+            if ((output->data[j] > ACTIVATION_THRESHOLD) != (reference[j] > ACTIVATION_THRESHOLD)) {
+                actionDisagreements[j]++;
+                disagree = true;
+            }
+        }
+        disagreements += disagree ? 1 : 0;
+    }
+    xMatrix_free(observations);
+    xMatrix_free(references);
+
+    uint32_t maxActionDisagreements = 0;
+    for (uint32_t j = 0; j < 4; j++) {
+        maxActionDisagreements = (actionDisagreements[j] > maxActionDisagreements) ? actionDisagreements[j] : maxActionDisagreements;
+    }
+
+    printf("Calibration on %u samples (weights: %s):\n", samples,
+           (sparseModel != NULL) ? "fp32 pruned" : (cmd_weightsName != NULL ? cmd_weightsName : "fp32"));
+    printf("  Max output difference:\t%e\n", maxDifference);
+    printf("  Samples with any action flipped:\t%u (%.3f%%)\n", disagreements, 100.0f * disagreements / samples);
+    printf("  Max flips of single action:\t%u (%.3f%%) [W %u, A %u, D %u, Space %u]\n", maxActionDisagreements,
+           100.0f * maxActionDisagreements / samples, actionDisagreements[0], actionDisagreements[1], actionDisagreements[2],
+           actionDisagreements[3]);
+    if (quantModel != NULL) {
+        printf("  Weight memory:\t%llu bytes (int8)\n", (unsigned long long)fnn_quantWeightBytes(quantModel));
+    } else if (halfModel != NULL) {
+        printf("  Weight memory:\t%llu bytes (%s)\n", (unsigned long long)fnn_halfWeightBytes(halfModel), cmd_weightsName);
+    } else if (sparseModel != NULL) {
+        printf("  Pruning threshold:\t%g (%llu of %llu weights kept, density %.3f)\n", pruneThreshold,
+               (unsigned long long)sparseModel->nonzeros, (unsigned long long)sparseModel->totalWeights,
+               (double)sparseModel->nonzeros / (double)sparseModel->totalWeights);
+        for (uint32_t i = 0; i < sparseModel->layerCount; i++) {
+            const FnnSparseLayer *layer = &sparseModel->layers[i];
+            printf("  Layer %u (%ux%u):\t%s, density %.3f\n", i + 1, layer->inputs, layer->outputs,
+                   fnn_sparseFormatName(layer->format), (double)layer->nonzeros / ((double)layer->inputs * layer->outputs));
+        }
+    } else if (fixedModel != NULL) {
+        printf("  Specialized kernel:\t%s\n", fixedModel->name);
+    }
 }
 
 // unload dynamic structures of neural network
 inline void UnloadNeurons(void)
 {
-    // report to shared state that program is not running
+    // report final statistics and that program is not running
     if (flags_cmd & CMD_FLAG_MANAGED) {
+        PublishStatistics(MonotonicTime());
         sm_lockSharedState(shState);
         shState->state_neuronsAlive = false;
         sm_unlockSharedState(shState);
+    } else if (flags_cmd & CMD_FLAG_STANDALONE) {
+        PrintStatistics();
     }
 
     // disconnect from shared memory
@@ -511,15 +851,90 @@ inline void UnloadNeurons(void)
     xList_free(intermediateMatrices);
     xList_forEach(activationFunctions, free);
     xList_free(activationFunctions);
+    fnn_quantFree(quantModel);
+    fnn_halfFree(halfModel);
+    fnn_fixedFree(fixedModel);
+    fnn_sparseFree(sparseModel);
+    fnn_unmapModel(mappedModel);  // after matrices viewing it are freed
 
     return;
 }
 
+// monotonic clock in nanoseconds
+inline uint64_t MonotonicTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// record timings of one read, forward and write cycle (publishing them periodically in managed mode)
+inline void RecordStatistics(uint64_t start, uint64_t forwardStart, uint64_t forwardEnd, uint64_t end)
+{
+    // game increments sequence number with every published observation, so unchanged number means stale observation
+    if (statInferences == 0) {
+        statStartTime = start;
+        statPublishTime = start;
+    } else if (observationSequence == evaluatedSequence) {
+        statDuplicates++;
+    }
+    evaluatedSequence = observationSequence;
+    statInferences++;
+
+    xHistogram_record(&statForwardTime, forwardEnd - forwardStart);
+    xHistogram_record(&statCycleTime, end - start);
+
+    if ((flags_cmd & CMD_FLAG_MANAGED) && end - statPublishTime >= STATS_PUBLISH_PERIOD_NS) {
+        PublishStatistics(end);
+    }
+}
+
+// write inference statistics to shared state
+void PublishStatistics(uint64_t now)
+{
+    double elapsed = (double)(now - statStartTime) / 1e9;
+    float rate = (statInferences > 0 && elapsed > 0.0) ? (float)((double)statInferences / elapsed) : 0.0f;
+    uint32_t forwardP50 = (uint32_t)xHistogram_percentile(&statForwardTime, 50.0);
+    uint32_t forwardP99 = (uint32_t)xHistogram_percentile(&statForwardTime, 99.0);
+    uint32_t cycleP99 = (uint32_t)xHistogram_percentile(&statCycleTime, 99.0);
+
+    sm_lockSharedState(shState);
+    shState->neurons_inferenceCount = statInferences;
+    shState->neurons_duplicateCount = statDuplicates;
+    shState->neurons_inferenceRate = rate;
+    shState->neurons_forwardP50 = forwardP50;
+    shState->neurons_forwardP99 = forwardP99;
+    shState->neurons_cycleP99 = cycleP99;
+    sm_unlockSharedState(shState);
+
+    statPublishTime = now;
+}
+
+// print inference statistics to console
+void PrintStatistics(void)
+{
+    if (statInferences == 0) {
+        return;
+    }
+
+    double elapsed = (double)(MonotonicTime() - statStartTime) / 1e9;
+    printf("Inference statistics:\n");
+    printf("  Inferences:\t\t%" PRIu64 " (%.0f per second)\n", statInferences,
+           (elapsed > 0.0) ? (double)statInferences / elapsed : 0.0);
+    printf("  Duplicate inferences:\t%" PRIu64 " (%.1f%%)\n", statDuplicates,
+           100.0 * (double)statDuplicates / (double)statInferences);
+    printf("  Forward pass:\t\tp50 %" PRIu64 " ns, p99 %" PRIu64 " ns, max %" PRIu64 " ns\n",
+           xHistogram_percentile(&statForwardTime, 50.0), xHistogram_percentile(&statForwardTime, 99.0), statForwardTime.max);
+    printf("  Whole cycle:\t\tp50 %" PRIu64 " ns, p99 %" PRIu64 " ns, max %" PRIu64 " ns\n",
+           xHistogram_percentile(&statCycleTime, 50.0), xHistogram_percentile(&statCycleTime, 99.0), statCycleTime.max);
+}
+
 // signal handler for graceful exit (when SIGINT or SIGTERM is received)
 void signalHandler(int signal)
 {
     if (signal == SIGINT || signal == SIGTERM) {
         flags_runtime |= RUNTIME_EXIT;
+        neuronsServe_stop();
 
         // return back to where program was interrupted
         return;
@@ -0,0 +1,571 @@
+#include "neuronsServe.h"
+#include <pthread.h>        // serving threads
+#include <stdbool.h>        // boolean type
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // console output, reading instance file
+#include <stdlib.h>         // malloc, calloc, free
+#include <string.h>         // strtok_r, strdup, memset
+#include <time.h>           // monotonic clock (inference statistics)
+#include <unistd.h>         // sysconf (online CPU count)
+#include "commonUtility.h"  // C string utilities (for comparing model paths and parsing genome indices)
+#include "fnnActivation.h"  // activation precision modes
+#include "fnnFixed.h"       // forward kernels specialized for fixed architectures
+#include "fnnForward.h"     // batched float inference
+#include "fnnLoader.h"      // memory mapped model files and genomes of packed population files
+#include "neuronsMain.h"    // activation threshold of outputs, statistics publishing period
+#include "sharedMemory.h"   // shared memory of game instances
+#include "xHistogram.h"     // latency histograms (inference statistics)
+#include "xLinear.h"        // batch matrices
+#include "xList.h"          // layer lists of loaded models
+
+/**
+ * @brief Model loaded once for all instances listing the same model file
+ *
+ */
+typedef struct {
+    char *filename;
+    uint32_t genomeIndex;  // index of genome in packed population file (SERVE_NO_GENOME for model file)
+    xList *weightMatrices;
+    xList *biasMatrices;
+    xList *activationFunctions;
+    FnnMappedModel *mapping;
+    FnnFixedModel *fixedModel;  // used for single observations (NULL if architecture is not specialized)
+} serveModel;
+
+/**
+ * @brief Game instance served by agent
+ *
+ */
+typedef struct {
+    struct sharedInput_s *shInput;
+    struct sharedOutput_s *shOutput;
+    struct sharedState_s *shState;
+    serveModel *model;
+    uint32_t lastSequence;  // sequence number of last served observation
+    bool active;            // instance was not told to exit yet
+    xHistogram *forwardTime;  // statistics: forward pass times of instance (nanoseconds, shared by batch members)
+    xHistogram *cycleTime;    // statistics: read, forward and write cycle times (nanoseconds)
+    uint64_t inferenceCount;  // statistics: served observations
+    uint64_t startTime;       // statistics: time of first served observation (nanoseconds)
+    uint64_t publishTime;     // statistics: time of last publishing to shared state (nanoseconds)
+} serveInstance;
+
+/**
+ * @brief Serving thread with its instances and batch buffers
+ *
+ */
+typedef struct {
+    pthread_t thread;
+    serveInstance **instances;
+    uint32_t instanceCount;
+    struct sharedOutput_s **waitOutputs;  // shared outputs of active instances (for futex wait)
+    uint32_t *waitSequences;              // last sequence numbers of active instances
+    uint32_t *ready;                      // indices of instances with pending observation
+    bool *served;                         // instance was already served in current pass
+    xMatrix *observations;                // pending observations in order of `ready`
+    xMatrix *groupInputs;                 // observations of instances sharing one model
+    xMatrix *groupOutputs;                // outputs of instances sharing one model
+    uint32_t *groupMembers;               // indices of instances in current group
+    uint64_t observationCount;            // statistics: served observations
+    uint64_t batchCount;                  // statistics: forward passes
+    uint64_t collectTime;                 // time of reading pending observations (start of their cycle)
+    FnnPrecision_e precision;
+} serveWorker;
+
+// ----------------------------------------------------------------------------------------------
+// global variables
+
+static int stopRequested = 0;  // set by `neuronsServe_stop` (accessed atomically)
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static int32_t loadInstances(const char *instanceFilename, serveInstance **instances, uint32_t *instanceCount, xList *models);
+static serveModel *findModel(xList *models, const char *filename, uint32_t genomeIndex);  // load model or reuse loaded one
+static void freeModel(void *model);
+static int32_t workerInit(serveWorker *worker, uint32_t instanceCount, FnnPrecision_e precision);
+static void workerFree(serveWorker *worker);
+static void *workerThread(void *context);                     // serving loop of one thread
+static uint32_t collectObservations(serveWorker *worker);     // read pending observations, returns number of them
+static void serveGroups(serveWorker *worker, uint32_t ready);  // batched inference for each model of pending observations
+static void writeActions(serveInstance *instance, const float *output);
+static void recordStatistics(serveInstance *instance, uint64_t forwardTime, uint64_t cycleTime, uint64_t now);
+static void publishStatistics(serveInstance *instance, uint64_t now);
+static void disconnectInstance(serveInstance *instance);
+static uint64_t monotonicTime(void);
+
+// ----------------------------------------------------------------------------------------------
+// public function definitions
+
+int32_t neuronsServe_run(const char *instanceFilename, uint32_t threadCount, FnnPrecision_e precision)
+{
+    serveInstance *instances = NULL;
+    uint32_t instanceCount = 0;
+    xList *models = xList_new();
+    if (models == NULL || loadInstances(instanceFilename, &instances, &instanceCount, models) != 0) {
+        if (models != NULL) {
+            xList_forEach(models, freeModel);
+            xList_free(models);
+        }
+        free(instances);
+        return -1;
+    }
+
+    // default is one thread per group of instances (but not more than CPUs), each thread waits on limited number of futexes
+    if (threadCount == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = (instanceCount + SERVE_INSTANCES_PER_THREAD - 1) / SERVE_INSTANCES_PER_THREAD;
+        threadCount = (cpus > 0 && threadCount > (uint32_t)cpus) ? (uint32_t)cpus : threadCount;
+    }
+    uint32_t minThreads = (instanceCount + SM_MAX_WAIT_OUTPUTS - 1) / SM_MAX_WAIT_OUTPUTS;
+    threadCount = (threadCount < minThreads) ? minThreads : threadCount;
+    threadCount = (threadCount > instanceCount) ? instanceCount : threadCount;
+
+    // instances are dealt to threads round robin
+    serveWorker *workers = (serveWorker *)calloc(threadCount, sizeof(serveWorker));
+    int32_t status = (workers == NULL) ? -1 : 0;
+    for (uint32_t t = 0; t < threadCount && status == 0; t++) {
+        uint32_t count = instanceCount / threadCount + ((t < instanceCount % threadCount) ? 1 : 0);
+        status = workerInit(&workers[t], count, precision);
+        for (uint32_t i = 0; i < count && status == 0; i++) {
+            workers[t].instances[i] = &instances[t + i * threadCount];
+        }
+    }
+    if (status != 0) {
+        fprintf(stderr, "Neurons Serve: Failed to allocate serving threads\n");
+    }
+
+    // report to shared state of every instance that agent is running
+    for (uint32_t i = 0; i < instanceCount && status == 0; i++) {
+        sm_lockSharedState(instances[i].shState);
+        instances[i].shState->state_neuronsAlive = true;
+        sm_unlockSharedState(instances[i].shState);
+    }
+
+    uint32_t started = 0;
+    for (; started < threadCount && status == 0; started++) {
+        if (pthread_create(&workers[started].thread, NULL, workerThread, &workers[started]) != 0) {
+            fprintf(stderr, "Neurons Serve: Failed to start serving thread\n");
+            neuronsServe_stop();
+            status = -1;
+            break;
+        }
+    }
+    uint64_t observations = 0;
+    uint64_t batches = 0;
+    for (uint32_t t = 0; t < started; t++) {
+        pthread_join(workers[t].thread, NULL);
+        observations += workers[t].observationCount;
+        batches += workers[t].batchCount;
+    }
+    if (status == 0) {
+        printf("Served %u instances (%u models) on %u threads: %llu observations in %llu forward passes (%.2f per pass)\n",
+               instanceCount, (unsigned)models->size, threadCount, (unsigned long long)observations,
+               (unsigned long long)batches, (batches > 0) ? (double)observations / (double)batches : 0.0);
+    }
+
+    // publish final statistics of instances still served when server was stopped and disconnect from all instances
+    uint64_t now = monotonicTime();
+    for (uint32_t i = 0; i < instanceCount; i++) {
+        if (instances[i].active && instances[i].inferenceCount > 0) {
+            publishStatistics(&instances[i], now);
+        }
+        sm_lockSharedState(instances[i].shState);
+        instances[i].shState->state_neuronsAlive = false;
+        sm_unlockSharedState(instances[i].shState);
+        disconnectInstance(&instances[i]);
+    }
+    if (workers != NULL) {
+        for (uint32_t t = 0; t < threadCount; t++) {
+            workerFree(&workers[t]);
+        }
+        free(workers);
+    }
+    free(instances);
+    xList_forEach(models, freeModel);
+    xList_free(models);
+
+    return status;
+}
+
+void neuronsServe_stop(void) { __atomic_store_n(&stopRequested, 1, __ATOMIC_RELAXED); }
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+// parse instance file, connect to shared memory of every instance and load its model
+static int32_t loadInstances(const char *instanceFilename, serveInstance **instances, uint32_t *instanceCount, xList *models)
+{
+    FILE *file = fopen(instanceFilename, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Neurons Serve: Failed to open instance file\n");
+        return -1;
+    }
+
+    char line[SERVE_MAX_LINE];
+    uint32_t capacity = 0;
+    int32_t status = 0;
+    while (status == 0 && fgets(line, sizeof(line), file) != NULL) {
+        char *context = NULL;
+        char *fields[5] = {NULL, NULL, NULL, NULL, NULL};
+        int fieldCount = 0;
+        for (char *token = strtok_r(line, " \t\r\n", &context); token != NULL; token = strtok_r(NULL, " \t\r\n", &context)) {
+            if (fieldCount == 0 && token[0] == '#') {
+                break;
+            }
+            if (fieldCount < 5) {
+                fields[fieldCount] = token;
+            }
+            fieldCount++;
+        }
+        if (fieldCount == 0) {
+            continue;
+        }
+        if ((fieldCount != 4 && fieldCount != 5) || !sm_validateSharedMemoryName(fields[0]) ||
+            !sm_validateSharedMemoryName(fields[1]) || !sm_validateSharedMemoryName(fields[2]) ||
+            (fieldCount == 5 && !cu_CStringIsNumeric(fields[4]))) {
+            fprintf(stderr, "Neurons Serve: Invalid instance (expected <input> <output> <state> <model> [<genome>])\n");
+            status = -1;
+            break;
+        }
+
+        if (*instanceCount == capacity) {
+            capacity = (capacity == 0) ? 16 : 2 * capacity;
+            serveInstance *expanded = (serveInstance *)realloc(*instances, capacity * sizeof(serveInstance));
+            if (expanded == NULL) {
+                fprintf(stderr, "Neurons Serve: Failed to allocate memory for instances\n");
+                status = -1;
+                break;
+            }
+            *instances = expanded;
+        }
+
+        serveInstance *instance = &(*instances)[*instanceCount];
+        memset(instance, 0, sizeof(serveInstance));
+        uint32_t genomeIndex = (fieldCount == 5) ? (uint32_t)cu_CStringToInteger(fields[4]) : SERVE_NO_GENOME;
+        instance->model = findModel(models, fields[3], genomeIndex);
+        if (instance->model == NULL) {
+            status = -1;
+            break;
+        }
+        instance->forwardTime = (xHistogram *)malloc(sizeof(xHistogram));
+        instance->cycleTime = (xHistogram *)malloc(sizeof(xHistogram));
+        if (instance->forwardTime == NULL || instance->cycleTime == NULL) {
+            fprintf(stderr, "Neurons Serve: Failed to allocate memory for instance statistics\n");
+            free(instance->forwardTime);
+            free(instance->cycleTime);
+            status = -1;
+            break;
+        }
+        xHistogram_reset(instance->forwardTime);
+        xHistogram_reset(instance->cycleTime);
+        instance->shInput = sm_connectSharedInput(fields[0]);
+        instance->shOutput = sm_connectSharedOutput(fields[1]);
+        instance->shState = sm_connectSharedState(fields[2]);
+        instance->lastSequence = sm_sequenceSharedOutput(instance->shOutput) - 1;  // first observation is always served
+        instance->active = true;
+        (*instanceCount)++;
+    }
+    fclose(file);
+
+    if (status == 0 && *instanceCount == 0) {
+        fprintf(stderr, "Neurons Serve: Instance file lists no instances\n");
+        status = -1;
+    }
+    if (status != 0) {
+        for (uint32_t i = 0; i < *instanceCount; i++) {
+            disconnectInstance(&(*instances)[i]);
+        }
+    }
+    return status;
+}
+
+static serveModel *findModel(xList *models, const char *filename, uint32_t genomeIndex)
+{
+    for (xListNode *node = models->head; node != NULL; node = node->next) {
+        serveModel *loaded = (serveModel *)node->data;
+        if (loaded->genomeIndex == genomeIndex && cu_CStringCompare(loaded->filename, filename) == 0) {
+            return loaded;
+        }
+    }
+
+    serveModel *model = (serveModel *)calloc(1, sizeof(serveModel));
+    if (model == NULL) {
+        fprintf(stderr, "Neurons Serve: Failed to allocate memory for model\n");
+        return NULL;
+    }
+    model->filename = strdup(filename);
+    model->genomeIndex = genomeIndex;
+    model->weightMatrices = xList_new();
+    model->biasMatrices = xList_new();
+    model->activationFunctions = xList_new();
+    if (model->filename == NULL || model->weightMatrices == NULL || model->biasMatrices == NULL ||
+        model->activationFunctions == NULL) {
+        fprintf(stderr, "Neurons Serve: Failed to allocate memory for model\n");
+        freeModel(model);
+        return NULL;
+    }
+    // genome of packed population file is mapped through population loader
+    if (genomeIndex != SERVE_NO_GENOME) {
+        model->mapping = fnn_mapPopulationModel(filename, genomeIndex, model->weightMatrices, model->biasMatrices,
+                                                model->activationFunctions);
+    } else {
+        model->mapping = fnn_mapModel(filename, model->weightMatrices, model->biasMatrices, model->activationFunctions);
+    }
+    if (model->mapping == NULL) {
+        fprintf(stderr, "Neurons Serve: Failed to load model %s\n", filename);
+        freeModel(model);
+        return NULL;
+    }
+
+    // 5 inputs and 4 outputs are mandatory for agent
+    if (((xMatrix *)model->weightMatrices->head->data)->rows != 5 || ((xMatrix *)model->weightMatrices->tail->data)->cols != 4) {
+        fprintf(stderr, "Neurons Serve: Invalid input/output layer dimension of model %s\n", filename);
+        freeModel(model);
+        return NULL;
+    }
+    model->fixedModel = fnn_fixedSelect(model->weightMatrices, model->biasMatrices, model->activationFunctions);
+
+    xList_pushBack(models, model);
+    return model;
+}
+
+static void freeModel(void *data)
+{
+    serveModel *model = (serveModel *)data;
+    if (model == NULL) {
+        return;
+    }
+
+    if (model->weightMatrices != NULL) {
+        xList_forEach(model->weightMatrices, (void (*)(void *))xMatrix_free);
+        xList_free(model->weightMatrices);
+    }
+    if (model->biasMatrices != NULL) {
+        xList_forEach(model->biasMatrices, (void (*)(void *))xMatrix_free);
+        xList_free(model->biasMatrices);
+    }
+    if (model->activationFunctions != NULL) {
+        xList_forEach(model->activationFunctions, free);
+        xList_free(model->activationFunctions);
+    }
+    fnn_fixedFree(model->fixedModel);
+    fnn_unmapModel(model->mapping);  // after matrices viewing it are freed
+    free(model->filename);
+    free(model);
+}
+
+static int32_t workerInit(serveWorker *worker, uint32_t instanceCount, FnnPrecision_e precision)
+{
+    worker->instanceCount = instanceCount;
+    worker->precision = precision;
+    worker->instances = (serveInstance **)calloc(instanceCount, sizeof(serveInstance *));
+    worker->waitOutputs = (struct sharedOutput_s **)calloc(instanceCount, sizeof(struct sharedOutput_s *));
+    worker->waitSequences = (uint32_t *)calloc(instanceCount, sizeof(uint32_t));
+    worker->ready = (uint32_t *)calloc(instanceCount, sizeof(uint32_t));
+    worker->served = (bool *)calloc(instanceCount, sizeof(bool));
+    worker->groupMembers = (uint32_t *)calloc(instanceCount, sizeof(uint32_t));
+    worker->observations = xMatrix_new(instanceCount, 5);
+    worker->groupInputs = xMatrix_new(instanceCount, 5);
+    worker->groupOutputs = xMatrix_new(instanceCount, 4);
+    if (worker->instances == NULL || worker->waitOutputs == NULL || worker->waitSequences == NULL || worker->ready == NULL ||
+        worker->served == NULL || worker->groupMembers == NULL || worker->observations == NULL || worker->groupInputs == NULL ||
+        worker->groupOutputs == NULL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static void workerFree(serveWorker *worker)
+{
+    free(worker->instances);
+    free(worker->waitOutputs);
+    free(worker->waitSequences);
+    free(worker->ready);
+    free(worker->served);
+    free(worker->groupMembers);
+    xMatrix_free(worker->observations);
+    xMatrix_free(worker->groupInputs);
+    xMatrix_free(worker->groupOutputs);
+}
+
+static void *workerThread(void *context)
+{
+    serveWorker *worker = (serveWorker *)context;
+    while (!__atomic_load_n(&stopRequested, __ATOMIC_RELAXED)) {
+        // exit requests of manager (instance stays connected until server exits)
+        uint32_t waitCount = 0;
+        for (uint32_t i = 0; i < worker->instanceCount; i++) {
+            serveInstance *instance = worker->instances[i];
+            if (!instance->active) {
+                continue;
+            }
+            sm_lockSharedState(instance->shState);
+            bool exitRequested = instance->shState->control_neuronsExit;
+            sm_unlockSharedState(instance->shState);
+            if (exitRequested) {
+                // final statistics are published before agent reports exit of instance
+                if (instance->inferenceCount > 0) {
+                    publishStatistics(instance, monotonicTime());
+                }
+                sm_lockSharedState(instance->shState);
+                instance->shState->state_neuronsAlive = false;
+                sm_unlockSharedState(instance->shState);
+                instance->active = false;
+            } else {
+                worker->waitOutputs[waitCount] = instance->shOutput;
+                worker->waitSequences[waitCount] = instance->lastSequence;
+                waitCount++;
+            }
+        }
+        if (waitCount == 0) {
+            break;
+        }
+
+        uint32_t ready = collectObservations(worker);
+        if (ready == 0) {
+            // sleep until any game publishes observation (timeout bounds latency of exit requests)
+            sm_waitSharedOutputs(worker->waitOutputs, worker->waitSequences, waitCount, SERVE_WAIT_TIMEOUT_NS);
+            continue;
+        }
+        serveGroups(worker, ready);
+    }
+
+    return NULL;
+}
+
+static uint32_t collectObservations(serveWorker *worker)
+{
+    uint32_t ready = 0;
+    worker->collectTime = monotonicTime();
+    for (uint32_t i = 0; i < worker->instanceCount; i++) {
+        serveInstance *instance = worker->instances[i];
+        uint32_t sequence = sm_sequenceSharedOutput(instance->shOutput);
+        if (!instance->active || sequence == instance->lastSequence) {
+            continue;
+        }
+
+        float *observation = worker->observations->data + (uint64_t)ready * 5;
+        sm_lockSharedOutput(instance->shOutput);
+        observation[0] = instance->shOutput->gameOutput01;
+        observation[1] = instance->shOutput->gameOutput02;
+        observation[2] = instance->shOutput->gameOutput03;
+        observation[3] = instance->shOutput->gameOutput04;
+        observation[4] = instance->shOutput->gameOutput05;
+        sm_unlockSharedOutput(instance->shOutput);
+
+        instance->lastSequence = sequence;
+        worker->served[ready] = false;
+        worker->ready[ready++] = i;
+    }
+
+    return ready;
+}
+
+static void serveGroups(serveWorker *worker, uint32_t ready)
+{
+    for (uint32_t r = 0; r < ready; r++) {
+        if (worker->served[r]) {
+            continue;
+        }
+
+        // pending observations of instances playing the same model form one batch
+        serveModel *model = worker->instances[worker->ready[r]]->model;
+        uint32_t groupSize = 0;
+        for (uint32_t s = r; s < ready; s++) {
+            if (worker->served[s] || worker->instances[worker->ready[s]]->model != model) {
+                continue;
+            }
+            for (uint32_t j = 0; j < 5; j++) {
+                worker->groupInputs->data[(uint64_t)groupSize * 5 + j] = worker->observations->data[(uint64_t)s * 5 + j];
+            }
+            worker->groupMembers[groupSize++] = worker->ready[s];
+            worker->served[s] = true;
+        }
+
+        uint64_t forwardStart = monotonicTime();
+        if (groupSize == 1 && model->fixedModel != NULL) {
+            fnn_fixedForward(model->fixedModel, worker->groupInputs->data, worker->groupOutputs->data, worker->precision);
+        } else {
+            xMatrixView inputs = xMatrix_viewSlice(worker->groupInputs, 0, groupSize, 0, 5);
+            xMatrixView outputs = xMatrix_viewSlice(worker->groupOutputs, 0, groupSize, 0, 4);
+            fnn_forwardBatch(model->weightMatrices, model->biasMatrices, model->activationFunctions, &inputs, &outputs,
+                             worker->precision);
+        }
+        uint64_t forwardEnd = monotonicTime();
+        for (uint32_t g = 0; g < groupSize; g++) {
+            writeActions(worker->instances[worker->groupMembers[g]], worker->groupOutputs->data + (uint64_t)g * 4);
+        }
+        uint64_t end = monotonicTime();
+        for (uint32_t g = 0; g < groupSize; g++) {
+            serveInstance *instance = worker->instances[worker->groupMembers[g]];
+            if (instance->inferenceCount == 0) {
+                instance->startTime = worker->collectTime;
+                instance->publishTime = worker->collectTime;
+            }
+            recordStatistics(instance, forwardEnd - forwardStart, end - worker->collectTime, end);
+        }
+
+        worker->observationCount += groupSize;
+        worker->batchCount++;
+    }
+}
+
+static void writeActions(serveInstance *instance, const float *output)
+{
+    sm_lockSharedInput(instance->shInput);
+    instance->shInput->isKeyDownW = (output[0] > ACTIVATION_THRESHOLD) ? true : false;
+    instance->shInput->isKeyDownA = (output[1] > ACTIVATION_THRESHOLD) ? true : false;
+    instance->shInput->isKeyDownD = (output[2] > ACTIVATION_THRESHOLD) ? true : false;
+    instance->shInput->isKeyDownSpace = (output[3] > ACTIVATION_THRESHOLD) ? true : false;
+    sm_unlockSharedInput(instance->shInput);
+}
+
+// record one served observation of instance (publishing statistics periodically like agent in managed mode)
+static void recordStatistics(serveInstance *instance, uint64_t forwardTime, uint64_t cycleTime, uint64_t now)
+{
+    instance->inferenceCount++;
+    xHistogram_record(instance->forwardTime, forwardTime);
+    xHistogram_record(instance->cycleTime, cycleTime);
+    if (now - instance->publishTime >= STATS_PUBLISH_PERIOD_NS) {
+        publishStatistics(instance, now);
+    }
+}
+
+// write inference statistics of instance to its shared state (server never evaluates observation twice, so it has no duplicates)
+static void publishStatistics(serveInstance *instance, uint64_t now)
+{
+    double elapsed = (double)(now - instance->startTime) / 1e9;
+    float rate = (elapsed > 0.0) ? (float)((double)instance->inferenceCount / elapsed) : 0.0f;
+    uint32_t forwardP50 = (uint32_t)xHistogram_percentile(instance->forwardTime, 50.0);
+    uint32_t forwardP99 = (uint32_t)xHistogram_percentile(instance->forwardTime, 99.0);
+    uint32_t cycleP99 = (uint32_t)xHistogram_percentile(instance->cycleTime, 99.0);
+
+    sm_lockSharedState(instance->shState);
+    instance->shState->neurons_inferenceCount = instance->inferenceCount;
+    instance->shState->neurons_duplicateCount = 0;
+    instance->shState->neurons_inferenceRate = rate;
+    instance->shState->neurons_forwardP50 = forwardP50;
+    instance->shState->neurons_forwardP99 = forwardP99;
+    instance->shState->neurons_cycleP99 = cycleP99;
+    sm_unlockSharedState(instance->shState);
+
+    instance->publishTime = now;
+}
+
+static void disconnectInstance(serveInstance *instance)
+{
+    sm_disconnectSharedInput(instance->shInput);
+    sm_disconnectSharedOutput(instance->shOutput);
+    sm_disconnectSharedState(instance->shState);
+    free(instance->forwardTime);
+    free(instance->cycleTime);
+}
+
+static uint64_t monotonicTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
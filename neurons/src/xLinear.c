@@ -1,6 +1,96 @@
 #include "xLinear.h"
 #include <stdint.h>  // universal integer types
 #include <stdlib.h>  // standard library (for malloc, free)
+#include <string.h>  // memset, memcpy
+#include "xSimd.h"        // SIMD level detection and dispatch
+#include "xThreadPool.h"  // process-wide thread pool (parallel variants)
+#if XSIMD_X86
+#include <immintrin.h>  // x86 SIMD intrinsics
+#endif
+
+// blocking parameters of matrix multiplication (MC and NC must be multiples of MR and NR)
+#define GEMM_MR 6     // rows of register tile
+#define GEMM_NR 16    // columns of register tile
+#define GEMM_KC 256   // inner dimension of block (KC x NR panel of second operand stays in L1)
+#define GEMM_MC 120   // rows of first operand block (MC x KC block stays in L2)
+#define GEMM_NC 3072  // columns of second operand block (KC x NC block stays in L3)
+#define GEMM_ALIGN 64  // alignment of packing buffers (cache line)
+#define GEMM_SMALL_NC 256  // result columns summed at once by deterministic row-streaming product
+
+/**
+ * @brief Strided view of matrix operand used by multiplication kernels (element (i, j) is at data[i * rowStride + j * colStride]).
+ *
+ */
+typedef struct {
+    const float *data;
+    uint32_t rowStride;
+    uint32_t colStride;
+} gemmOperand;
+
+typedef void (*gemmKernel)(uint32_t kc, const float *packA, const float *packB, float *c, uint32_t ldc, uint32_t mr,
+                           uint32_t nr, float alpha);
+
+/**
+ * @brief Matrix product prepared for execution (result block of rows x cols at c with row stride ldc).
+ *
+ */
+typedef struct {
+    float *c;
+    uint32_t ldc;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t inner;
+    gemmOperand a;
+    gemmOperand b;
+    float alpha;
+} gemmProblem;
+
+/**
+ * @brief Matrix product split into bands of register tiles for thread pool.
+ *
+ */
+typedef struct {
+    gemmProblem problem;
+    uint32_t chunks;    // number of bands
+    uint8_t splitRows;  // bands are made of result rows (otherwise columns)
+} gemmJob;
+
+/**
+ * @brief Element-wise operation split into contiguous chunks for thread pool.
+ *
+ */
+typedef struct {
+    xMatrix *res;
+    xMatrix *mat1;
+    xMatrix *mat2;  // NULL for scaling
+    float scale;
+    uint32_t chunks;     // number of chunks
+    uint8_t contiguous;  // all matrices are contiguous (chunks are ranges of elements, otherwise ranges of rows)
+} elementwiseJob;
+
+static int32_t gemmPrepare(gemmProblem *problem, xMatrix *res, xMatrix *mat1, xMatrixOp_e op1, xMatrix *mat2, xMatrixOp_e op2,
+                           float alpha, float beta);
+static void gemmRun(const gemmProblem *problem);
+static void gemmTask(void *context, uint32_t index);
+static void elementwiseTask(void *context, uint32_t index);
+static uint32_t parallelChunks(uint64_t work, uint64_t threshold);
+static void gemmSmall(const gemmProblem *problem);
+static void gemmSmallExact(const gemmProblem *problem);
+static void gemmBlocked(const gemmProblem *problem);
+static void packA(float *dst, gemmOperand a, uint32_t row, uint32_t col, uint32_t mc, uint32_t kc);
+static void packB(float *dst, gemmOperand b, uint32_t row, uint32_t col, uint32_t kc, uint32_t nc);
+static void kernelScalar(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr,
+                         float alpha);
+#if XSIMD_X86
+static void kernelAvx2(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr,
+                       float alpha);
+static void kernelAvx512(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr,
+                         float alpha);
+static void kernelAvx2Exact(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr,
+                            float alpha);
+static void kernelAvx512Exact(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr,
+                              float alpha);
+#endif
 
 xMatrix *xMatrix_new(uint32_t rows, uint32_t cols)
 {
@@ -15,23 +105,34 @@ xMatrix *xMatrix_new(uint32_t rows, uint32_t cols)
         return NULL;
     }
 
-    // data allocation
-    mat->data = (float *)calloc(rows * cols, sizeof(float));
+    // data allocation (aligned to cache line, size rounded up as required by aligned_alloc)
+    size_t size = ((size_t)rows * cols * sizeof(float) + XLINEAR_ALIGNMENT - 1) / XLINEAR_ALIGNMENT * XLINEAR_ALIGNMENT;
+    mat->data = (float *)aligned_alloc(XLINEAR_ALIGNMENT, size);
     if (mat->data == NULL) {
         free(mat);
         return NULL;
     }
+    memset(mat->data, 0, size);
 
     // matrix initialization
     mat->rows = rows;
     mat->cols = cols;
+    mat->stride = cols;
+    mat->owner = 1;
 
     return mat;
 }
 
 void xMatrix_free(xMatrix *mat)
 {
-    free(mat->data);
+    // pointer checking
+    if (mat == NULL) {
+        return;
+    }
+
+    if (mat->owner) {
+        free(mat->data);
+    }
     free(mat);
 }
 
@@ -106,6 +207,53 @@ xMatrix *xMatrix_col(xMatrix *mat, uint32_t colIndex)
     return res;
 }
 
+xMatrixView xMatrix_view(float *data, uint32_t rows, uint32_t cols, uint32_t stride)
+{
+    xMatrixView view = {0, 0, 0, 0, NULL};
+
+    // argument checking
+    if (data == NULL || rows == 0 || cols == 0 || stride < cols) {
+        return view;
+    }
+
+    view.rows = rows;
+    view.cols = cols;
+    view.stride = stride;
+    view.data = data;
+    return view;
+}
+
+xMatrixView xMatrix_viewSlice(xMatrix *mat, uint32_t row_start, uint32_t row_end, uint32_t col_start, uint32_t col_end)
+{
+    // bound checking
+    if (mat == NULL || row_start >= row_end || col_start >= col_end || row_end > mat->rows || col_end > mat->cols) {
+        return xMatrix_view(NULL, 0, 0, 0);
+    }
+
+    return xMatrix_view(mat->data + (uint64_t)row_start * mat->stride + col_start, row_end - row_start, col_end - col_start,
+                        mat->stride);
+}
+
+xMatrixView xMatrix_viewRow(xMatrix *mat, uint32_t rowIndex)
+{
+    // bound checking
+    if (mat == NULL || rowIndex >= mat->rows) {
+        return xMatrix_view(NULL, 0, 0, 0);
+    }
+
+    return xMatrix_view(mat->data + (uint64_t)rowIndex * mat->stride, 1, mat->cols, mat->stride);
+}
+
+xMatrixView xMatrix_viewCol(xMatrix *mat, uint32_t colIndex)
+{
+    // bound checking
+    if (mat == NULL || colIndex >= mat->cols) {
+        return xMatrix_view(NULL, 0, 0, 0);
+    }
+
+    return xMatrix_view(mat->data + colIndex, mat->rows, 1, mat->stride);
+}
+
 void xMatrix_add(xMatrix *res, xMatrix *mat1, xMatrix *mat2)
 {
     // pointer checking
@@ -151,38 +299,92 @@ void xMatrix_sub(xMatrix *res, xMatrix *mat1, xMatrix *mat2)
 }
 
 void xMatrix_dot(xMatrix *res, xMatrix *mat1, xMatrix *mat2)
+{
+    xMatrix_gemm(res, mat1, XMATRIX_NORMAL, mat2, XMATRIX_NORMAL, 1.0f, 0.0f);
+    return;
+}
+
+void xMatrix_gemm(xMatrix *res, xMatrix *mat1, xMatrixOp_e op1, xMatrix *mat2, xMatrixOp_e op2, float alpha, float beta)
+{
+    gemmProblem problem;
+    if (gemmPrepare(&problem, res, mat1, op1, mat2, op2, alpha, beta) != 0) {
+        return;
+    }
+    gemmRun(&problem);
+
+    return;
+}
+
+void xMatrix_dotParallel(xMatrix *res, xMatrix *mat1, xMatrix *mat2)
+{
+    xMatrix_gemmParallel(res, mat1, XMATRIX_NORMAL, mat2, XMATRIX_NORMAL, 1.0f, 0.0f);
+    return;
+}
+
+void xMatrix_gemmParallel(xMatrix *res, xMatrix *mat1, xMatrixOp_e op1, xMatrix *mat2, xMatrixOp_e op2, float alpha, float beta)
+{
+    gemmProblem problem;
+    if (gemmPrepare(&problem, res, mat1, op1, mat2, op2, alpha, beta) != 0) {
+        return;
+    }
+
+    // result is split along its longer dimension into bands of whole register tiles
+    gemmJob job = {problem, 0, problem.rows >= problem.cols};
+    uint32_t tiles = job.splitRows ? (problem.rows + GEMM_MR - 1) / GEMM_MR : (problem.cols + GEMM_NR - 1) / GEMM_NR;
+    job.chunks = parallelChunks((uint64_t)problem.rows * problem.cols * problem.inner, XLINEAR_PARALLEL_GEMM_THRESHOLD);
+    job.chunks = (job.chunks < tiles) ? job.chunks : tiles;
+    if (job.chunks <= 1) {
+        gemmRun(&problem);
+        return;
+    }
+
+    xThreadPool_parallelFor(job.chunks, gemmTask, &job);
+    return;
+}
+
+void xMatrix_addParallel(xMatrix *res, xMatrix *mat1, xMatrix *mat2)
 {
     // pointer checking
-    if (res == NULL || mat1 == NULL || mat2 == NULL || res == mat1 || res == mat2) {
+    if (res == NULL || mat1 == NULL || mat2 == NULL) {
         return;
     }
 
     // dimension checking
-    if (res->rows != mat1->rows || res->cols != mat2->cols || mat1->cols != mat2->rows) {
+    if (res->rows != mat1->rows || res->rows != mat2->rows || res->cols != mat1->cols || res->cols != mat2->cols) {
         return;
     }
 
-    // matrix multiplication
-    for (uint32_t i = 0; i < res->rows; i++) {
-        for (uint32_t j = 0; j < res->cols; j++) {
-            float sum = 0.0f;
-            for (uint32_t k = 0; k < mat1->cols; k++) {
-                sum += xMatrix_get(mat1, i, k) * xMatrix_get(mat2, k, j);
-            }
-            xMatrix_set(res, i, j, sum);
-        }
-    }
+    elementwiseJob job = {res, mat1, mat2, 1.0f, 0, 0};
+    job.contiguous = res->stride == res->cols && mat1->stride == mat1->cols && mat2->stride == mat2->cols;
+    job.chunks = parallelChunks((uint64_t)res->rows * res->cols, XLINEAR_PARALLEL_THRESHOLD);
+    job.chunks = (job.contiguous || job.chunks < res->rows) ? job.chunks : res->rows;
+    xThreadPool_parallelFor(job.chunks, elementwiseTask, &job);
 
     return;
 }
 
-void xMatrix_transpose(xMatrix *mat)
+void xMatrix_scaleParallel(xMatrix *mat, float scale)
 {
     // pointer checking
     if (mat == NULL) {
         return;
     }
 
+    elementwiseJob job = {mat, mat, NULL, scale, 0, mat->stride == mat->cols};
+    job.chunks = parallelChunks((uint64_t)mat->rows * mat->cols, XLINEAR_PARALLEL_THRESHOLD);
+    job.chunks = (job.contiguous || job.chunks < mat->rows) ? job.chunks : mat->rows;
+    xThreadPool_parallelFor(job.chunks, elementwiseTask, &job);
+
+    return;
+}
+
+void xMatrix_transpose(xMatrix *mat)
+{
+    // pointer checking (views can not change shape of storage they alias)
+    if (mat == NULL || !mat->owner) {
+        return;
+    }
+
     // temporary matrix allocation
     xMatrix *temp = xMatrix_new(mat->cols, mat->rows);
     if (temp == NULL) {
@@ -201,6 +403,7 @@ void xMatrix_transpose(xMatrix *mat)
     mat->data = temp->data;
     mat->rows = temp->rows;
     mat->cols = temp->cols;
+    mat->stride = temp->stride;
     free(temp);
 
     return;
@@ -314,7 +517,7 @@ float xMatrix_get(xMatrix *mat, uint32_t rowIndex, uint32_t colIndex)
     }
 
     // value retrieval
-    return mat->data[rowIndex * mat->cols + colIndex];
+    return mat->data[(uint64_t)rowIndex * mat->stride + colIndex];
 }
 
 void xMatrix_set(xMatrix *mat, uint32_t rowIndex, uint32_t colIndex, float value)
@@ -330,7 +533,418 @@ void xMatrix_set(xMatrix *mat, uint32_t rowIndex, uint32_t colIndex, float value
     }
 
     // value setting
-    mat->data[rowIndex * mat->cols + colIndex] = value;
+    mat->data[(uint64_t)rowIndex * mat->stride + colIndex] = value;
 
     return;
 }
+
+// ----------------------------------------------------------------------------------------------
+// matrix multiplication kernels
+
+// validate operands, build strided views and apply beta to result
+static int32_t gemmPrepare(gemmProblem *problem, xMatrix *res, xMatrix *mat1, xMatrixOp_e op1, xMatrix *mat2, xMatrixOp_e op2,
+                           float alpha, float beta)
+{
+    // pointer checking
+    if (res == NULL || mat1 == NULL || mat2 == NULL || res == mat1 || res == mat2) {
+        return -1;
+    }
+
+    // operand views (transposition only swaps strides)
+    gemmOperand a = {mat1->data, mat1->stride, 1};
+    gemmOperand b = {mat2->data, mat2->stride, 1};
+    uint32_t rows = mat1->rows, inner = mat1->cols;
+    uint32_t innerB = mat2->rows, cols = mat2->cols;
+    if (op1 == XMATRIX_TRANSPOSE) {
+        a.rowStride = 1;
+        a.colStride = mat1->stride;
+        rows = mat1->cols;
+        inner = mat1->rows;
+    }
+    if (op2 == XMATRIX_TRANSPOSE) {
+        b.rowStride = 1;
+        b.colStride = mat2->stride;
+        innerB = mat2->cols;
+        cols = mat2->rows;
+    }
+
+    // dimension checking
+    if (res->rows != rows || res->cols != cols || inner != innerB) {
+        return -1;
+    }
+
+    // result scaling (beta of 0 overwrites result so that uninitialized values are not propagated)
+    for (uint32_t i = 0; i < res->rows && beta != 1.0f; i++) {
+        float *row = res->data + (uint64_t)i * res->stride;
+        if (beta == 0.0f) {
+            memset(row, 0, res->cols * sizeof(float));
+        } else {
+            for (uint32_t j = 0; j < res->cols; j++) {
+                row[j] *= beta;
+            }
+        }
+    }
+
+    problem->c = res->data;
+    problem->ldc = res->stride;
+    problem->rows = rows;
+    problem->cols = cols;
+    problem->inner = inner;
+    problem->a = a;
+    problem->b = b;
+    problem->alpha = alpha;
+    return 0;
+}
+
+// run product on calling thread with kernel chosen by problem size
+static void gemmRun(const gemmProblem *problem)
+{
+    if ((uint64_t)problem->rows * problem->cols * problem->inner >= XLINEAR_GEMM_THRESHOLD && problem->rows >= GEMM_MR) {
+        gemmBlocked(problem);
+    } else if (xSimd_deterministic()) {
+        gemmSmallExact(problem);
+    } else {
+        gemmSmall(problem);
+    }
+}
+
+// compute one band of result rows or columns (bands are aligned to register tiles)
+static void gemmTask(void *context, uint32_t index)
+{
+    const gemmJob *job = (const gemmJob *)context;
+    const gemmProblem *problem = &job->problem;
+    gemmProblem band = *problem;
+
+    if (job->splitRows) {
+        uint32_t tiles = (problem->rows + GEMM_MR - 1) / GEMM_MR;
+        uint32_t start = (uint32_t)((uint64_t)tiles * index / job->chunks) * GEMM_MR;
+        uint32_t end = (uint32_t)((uint64_t)tiles * (index + 1) / job->chunks) * GEMM_MR;
+        end = (end < problem->rows) ? end : problem->rows;
+        band.rows = end - start;
+        band.c += (uint64_t)start * problem->ldc;
+        band.a.data += (uint64_t)start * problem->a.rowStride;
+    } else {
+        uint32_t tiles = (problem->cols + GEMM_NR - 1) / GEMM_NR;
+        uint32_t start = (uint32_t)((uint64_t)tiles * index / job->chunks) * GEMM_NR;
+        uint32_t end = (uint32_t)((uint64_t)tiles * (index + 1) / job->chunks) * GEMM_NR;
+        end = (end < problem->cols) ? end : problem->cols;
+        band.cols = end - start;
+        band.c += start;
+        band.b.data += (uint64_t)start * problem->b.colStride;
+    }
+
+    if (band.rows > 0 && band.cols > 0) {
+        gemmRun(&band);
+    }
+}
+
+// apply element-wise addition or scaling to one chunk (contiguous matrices are treated as one long row)
+static void elementwiseTask(void *context, uint32_t index)
+{
+    const elementwiseJob *job = (const elementwiseJob *)context;
+    uint64_t rows = job->contiguous ? 1 : job->res->rows;
+    uint64_t cols = job->contiguous ? (uint64_t)job->res->rows * job->res->cols : job->res->cols;
+    uint64_t range = job->contiguous ? cols : rows;
+    uint64_t start = range * index / job->chunks;
+    uint64_t end = range * (index + 1) / job->chunks;
+    uint64_t rowStart = job->contiguous ? 0 : start, rowEnd = job->contiguous ? 1 : end;
+    uint64_t colStart = job->contiguous ? start : 0, colEnd = job->contiguous ? end : cols;
+
+    for (uint64_t i = rowStart; i < rowEnd; i++) {
+        float *res = job->res->data + i * job->res->stride;
+        const float *mat1 = job->mat1->data + i * job->mat1->stride;
+        if (job->mat2 != NULL) {
+            const float *mat2 = job->mat2->data + i * job->mat2->stride;
+            for (uint64_t j = colStart; j < colEnd; j++) {
+                res[j] = mat1[j] + mat2[j];
+            }
+        } else {
+            for (uint64_t j = colStart; j < colEnd; j++) {
+                res[j] = mat1[j] * job->scale;
+            }
+        }
+    }
+}
+
+// number of chunks to split work into (one per pool thread, or single chunk below threshold)
+static uint32_t parallelChunks(uint64_t work, uint64_t threshold)
+{
+    if (work < threshold) {
+        return 1;
+    }
+    uint32_t threads = xThreadPool_threadCount();
+    return (work < threads) ? (uint32_t)work : threads;
+}
+
+// row-streaming product for small matrices (second operand and result are traversed along rows)
+static void gemmSmall(const gemmProblem *problem)
+{
+    gemmOperand a = problem->a, b = problem->b;
+    for (uint32_t i = 0; i < problem->rows; i++) {
+        float *c = problem->c + (uint64_t)i * problem->ldc;
+        for (uint32_t p = 0; p < problem->inner; p++) {
+            float value = problem->alpha * a.data[(uint64_t)i * a.rowStride + (uint64_t)p * a.colStride];
+            const float *row = b.data + (uint64_t)p * b.rowStride;
+            if (b.colStride == 1) {
+                for (uint32_t j = 0; j < problem->cols; j++) {
+                    c[j] += value * row[j];
+                }
+            } else {
+                for (uint32_t j = 0; j < problem->cols; j++) {
+                    c[j] += value * row[(uint64_t)j * b.colStride];
+                }
+            }
+        }
+    }
+}
+
+// row-streaming product with summation order of blocked product (thread bands and problem size do not change rounding): products
+// of every KC block of inner dimension are summed in order starting from zero and block sum is scaled and added to result
+static void gemmSmallExact(const gemmProblem *problem)
+{
+    gemmOperand a = problem->a, b = problem->b;
+    float partial[GEMM_SMALL_NC];
+    const uint32_t width = GEMM_SMALL_NC;
+    for (uint32_t i = 0; i < problem->rows; i++) {
+        float *c = problem->c + (uint64_t)i * problem->ldc;
+        for (uint32_t jc = 0; jc < problem->cols; jc += width) {
+            uint32_t nc = (problem->cols - jc < width) ? problem->cols - jc : width;
+            for (uint32_t pc = 0; pc < problem->inner; pc += GEMM_KC) {
+                uint32_t kc = (problem->inner - pc < GEMM_KC) ? problem->inner - pc : GEMM_KC;
+                memset(partial, 0, nc * sizeof(float));
+                for (uint32_t p = pc; p < pc + kc; p++) {
+                    float value = a.data[(uint64_t)i * a.rowStride + (uint64_t)p * a.colStride];
+                    const float *row = b.data + (uint64_t)p * b.rowStride + (uint64_t)jc * b.colStride;
+                    for (uint32_t j = 0; j < nc; j++) {
+                        partial[j] += value * row[(uint64_t)j * b.colStride];
+                    }
+                }
+                for (uint32_t j = 0; j < nc; j++) {
+                    c[jc + j] += problem->alpha * partial[j];
+                }
+            }
+        }
+    }
+}
+
+// cache-blocked product (loop order NC -> KC -> MC -> NR -> MR around register-tiled micro-kernel)
+static void gemmBlocked(const gemmProblem *problem)
+{
+    gemmKernel kernel = kernelScalar;
+#if XSIMD_X86
+    int exact = xSimd_deterministic();
+    if (xSimd_level() >= XSIMD_AVX512) {
+        kernel = exact ? kernelAvx512Exact : kernelAvx512;
+    } else if (xSimd_level() >= XSIMD_AVX2) {
+        kernel = exact ? kernelAvx2Exact : kernelAvx2;
+    }
+#endif
+
+    uint32_t rows = problem->rows, cols = problem->cols, inner = problem->inner;
+
+    // packing buffers (sized for largest block actually used)
+    uint32_t ncMax = (cols < GEMM_NC) ? (cols + GEMM_NR - 1) / GEMM_NR * GEMM_NR : GEMM_NC;
+    uint32_t mcMax = (rows < GEMM_MC) ? (rows + GEMM_MR - 1) / GEMM_MR * GEMM_MR : GEMM_MC;
+    float *bufferA = (float *)aligned_alloc(GEMM_ALIGN, (size_t)mcMax * GEMM_KC * sizeof(float));
+    float *bufferB = (float *)aligned_alloc(GEMM_ALIGN, (size_t)ncMax * GEMM_KC * sizeof(float));
+    if (bufferA == NULL || bufferB == NULL) {
+        free(bufferA);
+        free(bufferB);
+        gemmSmall(problem);
+        return;
+    }
+
+    for (uint32_t jc = 0; jc < cols; jc += GEMM_NC) {
+        uint32_t nc = (cols - jc < GEMM_NC) ? cols - jc : GEMM_NC;
+        for (uint32_t pc = 0; pc < inner; pc += GEMM_KC) {
+            uint32_t kc = (inner - pc < GEMM_KC) ? inner - pc : GEMM_KC;
+            packB(bufferB, problem->b, pc, jc, kc, nc);
+            for (uint32_t ic = 0; ic < rows; ic += GEMM_MC) {
+                uint32_t mc = (rows - ic < GEMM_MC) ? rows - ic : GEMM_MC;
+                packA(bufferA, problem->a, ic, pc, mc, kc);
+                for (uint32_t jr = 0; jr < nc; jr += GEMM_NR) {
+                    uint32_t nr = (nc - jr < GEMM_NR) ? nc - jr : GEMM_NR;
+                    for (uint32_t ir = 0; ir < mc; ir += GEMM_MR) {
+                        uint32_t mr = (mc - ir < GEMM_MR) ? mc - ir : GEMM_MR;
+                        kernel(kc, bufferA + (uint64_t)ir * kc, bufferB + (uint64_t)jr * kc,
+                               problem->c + (uint64_t)(ic + ir) * problem->ldc + jc + jr, problem->ldc, mr, nr,
+                               problem->alpha);
+                    }
+                }
+            }
+        }
+    }
+
+    free(bufferA);
+    free(bufferB);
+}
+
+// pack mc x kc block of first operand into MR-row panels stored as [panel][kc][MR] (zero padded)
+static void packA(float *dst, gemmOperand a, uint32_t row, uint32_t col, uint32_t mc, uint32_t kc)
+{
+    for (uint32_t ir = 0; ir < mc; ir += GEMM_MR) {
+        uint32_t mr = (mc - ir < GEMM_MR) ? mc - ir : GEMM_MR;
+        for (uint32_t p = 0; p < kc; p++) {
+            const float *src = a.data + (uint64_t)(col + p) * a.colStride + (uint64_t)(row + ir) * a.rowStride;
+            uint32_t r = 0;
+            for (; r < mr; r++) {
+                *dst++ = src[(uint64_t)r * a.rowStride];
+            }
+            for (; r < GEMM_MR; r++) {
+                *dst++ = 0.0f;
+            }
+        }
+    }
+}
+
+// pack kc x nc block of second operand into NR-column panels stored as [panel][kc][NR] (zero padded)
+static void packB(float *dst, gemmOperand b, uint32_t row, uint32_t col, uint32_t kc, uint32_t nc)
+{
+    for (uint32_t jr = 0; jr < nc; jr += GEMM_NR) {
+        uint32_t nr = (nc - jr < GEMM_NR) ? nc - jr : GEMM_NR;
+        for (uint32_t p = 0; p < kc; p++) {
+            const float *src = b.data + (uint64_t)(row + p) * b.rowStride + (uint64_t)(col + jr) * b.colStride;
+            uint32_t j = 0;
+            if (b.colStride == 1) {
+                memcpy(dst, src, nr * sizeof(float));
+                j = nr;
+            } else {
+                for (; j < nr; j++) {
+                    dst[j] = src[(uint64_t)j * b.colStride];
+                }
+            }
+            for (; j < GEMM_NR; j++) {
+                dst[j] = 0.0f;
+            }
+            dst += GEMM_NR;
+        }
+    }
+}
+
+// portable micro-kernel (c += alpha * a * b on mr x nr tile)
+static void kernelScalar(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr,
+                         float alpha)
+{
+    float acc[GEMM_MR][GEMM_NR] = {{0.0f}};
+    for (uint32_t p = 0; p < kc; p++) {
+        for (uint32_t r = 0; r < GEMM_MR; r++) {
+            for (uint32_t j = 0; j < GEMM_NR; j++) {
+                acc[r][j] += a[r] * b[j];
+            }
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    for (uint32_t r = 0; r < mr; r++) {
+        for (uint32_t j = 0; j < nr; j++) {
+            c[(uint64_t)r * ldc + j] += alpha * acc[r][j];
+        }
+    }
+}
+
+#if XSIMD_X86
+// multiply-add of vector kernels (fused, or rounded after multiplication and after addition like portable kernel)
+#define KERNEL_MADD256(FUSED, A, B, C) ((FUSED) ? _mm256_fmadd_ps(A, B, C) : _mm256_add_ps(_mm256_mul_ps(A, B), C))
+#define KERNEL_MADD512(FUSED, A, B, C) ((FUSED) ? _mm512_fmadd_ps(A, B, C) : _mm512_add_ps(_mm512_mul_ps(A, B), C))
+
+// AVX2 micro-kernel (12 accumulator registers of 8 lanes)
+__attribute__((target("avx2,fma"), always_inline)) static inline void kernelAvx2Body(uint32_t kc, const float *a, const float *b,
+                                                                                    float *c, uint32_t ldc, uint32_t mr,
+                                                                                    uint32_t nr, float alpha, const int fused)
+{
+    __m256 acc[GEMM_MR][2];
+    for (uint32_t r = 0; r < GEMM_MR; r++) {
+        acc[r][0] = _mm256_setzero_ps();
+        acc[r][1] = _mm256_setzero_ps();
+    }
+
+    for (uint32_t p = 0; p < kc; p++) {
+        __m256 b0 = _mm256_load_ps(b);
+        __m256 b1 = _mm256_load_ps(b + 8);
+        for (uint32_t r = 0; r < GEMM_MR; r++) {
+            __m256 value = _mm256_broadcast_ss(a + r);
+            acc[r][0] = KERNEL_MADD256(fused, value, b0, acc[r][0]);
+            acc[r][1] = KERNEL_MADD256(fused, value, b1, acc[r][1]);
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    __m256 scale = _mm256_set1_ps(alpha);
+    if (mr == GEMM_MR && nr == GEMM_NR) {
+        for (uint32_t r = 0; r < GEMM_MR; r++) {
+            float *row = c + (uint64_t)r * ldc;
+            _mm256_storeu_ps(row, KERNEL_MADD256(fused, scale, acc[r][0], _mm256_loadu_ps(row)));
+            _mm256_storeu_ps(row + 8, KERNEL_MADD256(fused, scale, acc[r][1], _mm256_loadu_ps(row + 8)));
+        }
+        return;
+    }
+
+    // edge tile
+    float tile[GEMM_MR][GEMM_NR];
+    for (uint32_t r = 0; r < GEMM_MR; r++) {
+        _mm256_storeu_ps(tile[r], _mm256_mul_ps(scale, acc[r][0]));
+        _mm256_storeu_ps(tile[r] + 8, _mm256_mul_ps(scale, acc[r][1]));
+    }
+    for (uint32_t r = 0; r < mr; r++) {
+        for (uint32_t j = 0; j < nr; j++) {
+            c[(uint64_t)r * ldc + j] += tile[r][j];
+        }
+    }
+}
+
+__attribute__((target("avx2,fma"))) static void kernelAvx2(uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc,
+                                                           uint32_t mr, uint32_t nr, float alpha)
+{
+    kernelAvx2Body(kc, a, b, c, ldc, mr, nr, alpha, 1);
+}
+
+__attribute__((target("avx2,fma"))) static void kernelAvx2Exact(uint32_t kc, const float *a, const float *b, float *c,
+                                                                uint32_t ldc, uint32_t mr, uint32_t nr, float alpha)
+{
+    kernelAvx2Body(kc, a, b, c, ldc, mr, nr, alpha, 0);
+}
+
+// AVX-512 micro-kernel (6 accumulator registers of 16 lanes, edge columns are masked)
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"), always_inline)) static inline void kernelAvx512Body(
+    uint32_t kc, const float *a, const float *b, float *c, uint32_t ldc, uint32_t mr, uint32_t nr, float alpha, const int fused)
+{
+    __m512 acc[GEMM_MR];
+    for (uint32_t r = 0; r < GEMM_MR; r++) {
+        acc[r] = _mm512_setzero_ps();
+    }
+
+    for (uint32_t p = 0; p < kc; p++) {
+        __m512 b0 = _mm512_load_ps(b);
+        for (uint32_t r = 0; r < GEMM_MR; r++) {
+            acc[r] = KERNEL_MADD512(fused, _mm512_set1_ps(a[r]), b0, acc[r]);
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    __m512 scale = _mm512_set1_ps(alpha);
+    __mmask16 mask = (__mmask16)((1u << nr) - 1u);
+    for (uint32_t r = 0; r < mr; r++) {
+        float *row = c + (uint64_t)r * ldc;
+        _mm512_mask_storeu_ps(row, mask, KERNEL_MADD512(fused, scale, acc[r], _mm512_maskz_loadu_ps(mask, row)));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static void kernelAvx512(uint32_t kc, const float *a,
+                                                                                        const float *b, float *c,
+                                                                                        uint32_t ldc, uint32_t mr,
+                                                                                        uint32_t nr, float alpha)
+{
+    kernelAvx512Body(kc, a, b, c, ldc, mr, nr, alpha, 1);
+}
+
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static void kernelAvx512Exact(uint32_t kc, const float *a,
+                                                                                             const float *b, float *c,
+                                                                                             uint32_t ldc, uint32_t mr,
+                                                                                             uint32_t nr, float alpha)
+{
+    kernelAvx512Body(kc, a, b, c, ldc, mr, nr, alpha, 0);
+}
+#endif
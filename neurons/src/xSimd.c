@@ -0,0 +1,70 @@
+#include "xSimd.h"
+
+static int simdDetected = -1;  // cached result of CPU detection (-1 if not yet detected)
+static int simdOverride = -1;  // level forced by user (-1 if not overridden)
+static int simdExact = 0;      // deterministic mode of float kernels (no fused multiply-add)
+
+xSimdLevel_e xSimd_detect(void)
+{
+    if (simdDetected >= 0) {
+        return (xSimdLevel_e)simdDetected;
+    }
+
+    simdDetected = XSIMD_SCALAR;
+#if XSIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        simdDetected = XSIMD_AVX2;
+    }
+    if (simdDetected == XSIMD_AVX2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+        simdDetected = XSIMD_AVX512;
+    }
+#endif
+
+    return (xSimdLevel_e)simdDetected;
+}
+
+xSimdLevel_e xSimd_level(void)
+{
+    xSimdLevel_e detected = xSimd_detect();
+    if (simdOverride >= 0 && simdOverride < (int)detected) {
+        return (xSimdLevel_e)simdOverride;
+    }
+    return detected;
+}
+
+int xSimd_supports(xSimdFeature_e feature)
+{
+#if XSIMD_X86
+    xSimdLevel_e level = xSimd_level();
+    switch (feature) {
+    case XSIMD_FEATURE_VNNI:
+        return level >= XSIMD_AVX512 && __builtin_cpu_supports("avx512vnni");
+    case XSIMD_FEATURE_F16C:
+        return level >= XSIMD_AVX2 && __builtin_cpu_supports("f16c");
+    }
+#else
+    (void)feature;
+#endif
+    return 0;
+}
+
+void xSimd_setLevel(xSimdLevel_e level) { simdOverride = (int)level; }
+
+void xSimd_setDeterministic(int enabled) { simdExact = (enabled != 0); }
+
+int xSimd_deterministic(void) { return simdExact; }
+
+const char *xSimd_levelName(xSimdLevel_e level)
+{
+    switch (level) {
+    case XSIMD_SCALAR:
+        return "scalar";
+    case XSIMD_AVX2:
+        return "avx2";
+    case XSIMD_AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
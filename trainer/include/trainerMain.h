@@ -0,0 +1,56 @@
+/**
+ * @file trainerMain.h
+ * @author 0xDontCare (https://github.com/0xDontCare)
+ * @brief Supervised pretraining program related enums, structs, etc.
+ * @version 0.1
+ * @date 17.10.2026.
+ *
+ * @copyright All rights reserved (c) 2024
+ *
+ */
+
+#ifndef TRAINER_MAIN_H
+#define TRAINER_MAIN_H
+
+#include <stdint.h>
+
+// ------------------------------------------------------------------
+// trainer enum definitions
+
+/* Command line flags:
+ * 0x001 - help
+ * 0x002 - dataset file (+1 parameter)
+ * 0x004 - epoch count (+1 parameter)
+ * 0x008 - batch size (+1 parameter)
+ * 0x010 - learning rate (+1 parameter)
+ * 0x020 - optimizer (+1 parameter)
+ * 0x040 - loss function (+1 parameter)
+ * 0x080 - thread count (+1 parameter)
+ * 0x100 - shuffle seed (+1 parameter)
+ * 0x200 - validation fraction (+1 parameter)
+ * 0x400 - deterministic float kernels
+ */
+enum trainerFlag_e {
+    TRAINER_FLAG_NONE = 0x000,
+    TRAINER_FLAG_HELP = 0x001,
+    TRAINER_FLAG_DATA = 0x002,
+    TRAINER_FLAG_EPOCHS = 0x004,
+    TRAINER_FLAG_BATCH = 0x008,
+    TRAINER_FLAG_RATE = 0x010,
+    TRAINER_FLAG_OPTIMIZER = 0x020,
+    TRAINER_FLAG_LOSS = 0x040,
+    TRAINER_FLAG_THREADS = 0x080,
+    TRAINER_FLAG_SEED = 0x100,
+    TRAINER_FLAG_VALIDATION = 0x200,
+    TRAINER_FLAG_DETERMINISTIC = 0x400
+};
+
+// ------------------------------------------------------------------
+// trainer constant definitions
+#define TRAINER_DEFAULT_EPOCHS 50        // default number of passes over training set
+#define TRAINER_DEFAULT_BATCH 64         // default number of observations per update
+#define TRAINER_DEFAULT_VALIDATION 0.1f  // default fraction of dataset held out for validation
+#define TRAINER_REPORT_EPOCHS 10         // epochs between progress reports
+#define TRAINER_MAX_COLUMNS 4096         // maximal number of values per dataset line
+
+#endif  // TRAINER_MAIN_H
@@ -0,0 +1,452 @@
+#include "trainerMain.h"
+#include <stdint.h>         // universal integer types
+#include <stdio.h>          // console output, reading dataset, renaming trained model file
+#include <stdlib.h>         // malloc, free, strtoul, strtof
+#include <string.h>         // memcpy
+#include "commonUtility.h"  // C string utilities (for parsing command line arguments)
+#include "fnnSerializer.h"  // loading and storing trained models
+#include "fnnTrain.h"       // backpropagation training
+#include "xLinear.h"        // dataset and batch matrices
+#include "xSimd.h"          // deterministic mode of float kernels
+#include "xThreadPool.h"    // process-wide thread pool (parallel products)
+
+// ----------------------------------------------------------------------------------------------
+// global variables
+
+static unsigned short flags_cmd = TRAINER_FLAG_NONE;           // command line argument flags
+static uint32_t epochCount = TRAINER_DEFAULT_EPOCHS;           // number of passes over training set
+static uint32_t batchSize = TRAINER_DEFAULT_BATCH;             // number of observations per update
+static float learningRate = 0.0f;                              // step size of updates (0 for default of optimizer)
+static FnnOptimizer_e optimizer = FNN_OPTIMIZER_ADAM;          // weight update rule
+static FnnLoss_e lossFunction = FNN_LOSS_BCE;                  // minimized loss function
+static uint32_t threadCount = 0;                               // number of pool threads (0 for one per CPU)
+static uint32_t shuffleSeed = 1;                               // seed of dataset split and batch order
+static float validationFraction = TRAINER_DEFAULT_VALIDATION;  // fraction of dataset held out for validation
+
+static xMatrix *datasetInputs = NULL;   // observations of dataset (one per row)
+static xMatrix *datasetTargets = NULL;  // target outputs of dataset (one per row)
+static uint32_t trainingRows = 0;       // first rows of dataset are used for training, rest for validation
+
+// ----------------------------------------------------------------------------------------------
+// local function declarations
+
+static int loadDataset(const char *filename, uint32_t inputs, uint32_t outputs);        // read observations and targets
+static void shuffleRows(uint32_t *order, uint32_t count, uint32_t *state);             // random permutation of row indices
+static uint32_t nextRandom(uint32_t *state);                                           // xorshift random number generator
+static int trainModel(const char *filename, uint32_t modelIndex);                      // pretrain model file in place
+static int storeModel(const char *filename, FnnModel *model);                          // replace model file atomically
+static int evaluate(FnnTrainer *trainer, uint32_t start, uint32_t count, float *loss);  // mean loss over dataset rows
+
+// ----------------------------------------------------------------------------------------------
+// program entry point (main)
+
+int main(int argc, char *argv[])
+{
+    // parsing command line arguments (arguments which are not options are model files)
+    const char *dataPath = NULL;
+    const char *optimizerName = NULL;
+    const char *lossName = NULL;
+    char **modelPaths = (char **)malloc((size_t)argc * sizeof(char *));
+    uint32_t modelCount = 0;
+    if (modelPaths == NULL) {
+        printf("ERROR: Failed to allocate memory for model list.\n");
+        return 1;
+    }
+    int i;
+    for (i = 1; i < argc; i++) {
+        if (cu_CStringCompare(argv[i], "-h") == 0 || cu_CStringCompare(argv[i], "--help") == 0) {
+            flags_cmd |= TRAINER_FLAG_HELP;
+        } else if (cu_CStringCompare(argv[i], "-d") == 0 || cu_CStringCompare(argv[i], "--data") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_DATA;
+            dataPath = argv[i + 1];
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-e") == 0 || cu_CStringCompare(argv[i], "--epochs") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_EPOCHS;
+            epochCount = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-b") == 0 || cu_CStringCompare(argv[i], "--batch") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_BATCH;
+            batchSize = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-r") == 0 || cu_CStringCompare(argv[i], "--rate") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_RATE;
+            learningRate = strtof(argv[i + 1], NULL);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-O") == 0 || cu_CStringCompare(argv[i], "--optimizer") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_OPTIMIZER;
+            optimizerName = argv[i + 1];
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-L") == 0 || cu_CStringCompare(argv[i], "--loss") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_LOSS;
+            lossName = argv[i + 1];
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-t") == 0 || cu_CStringCompare(argv[i], "--threads") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_THREADS;
+            threadCount = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-s") == 0 || cu_CStringCompare(argv[i], "--seed") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_SEED;
+            shuffleSeed = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-v") == 0 || cu_CStringCompare(argv[i], "--validation") == 0) {
+            if (i + 1 >= argc)
+                break;
+
+            flags_cmd |= TRAINER_FLAG_VALIDATION;
+            validationFraction = strtof(argv[i + 1], NULL);
+            i += 1;
+        } else if (cu_CStringCompare(argv[i], "-D") == 0 || cu_CStringCompare(argv[i], "--deterministic") == 0) {
+            flags_cmd |= TRAINER_FLAG_DETERMINISTIC;
+        } else if (argv[i][0] == '-') {
+            printf("ERROR: Unknown command line argument: %s\n", argv[i]);
+            printf("Use %s --help for more information.\n", argv[0]);
+            free(modelPaths);
+            return 1;
+        } else {
+            modelPaths[modelCount++] = argv[i];
+        }
+    }
+    if (i != argc || epochCount == 0 || batchSize == 0 || learningRate < 0.0f || validationFraction < 0.0f ||
+        validationFraction >= 1.0f) {
+        printf("ERROR: Invalid command line arguments.\n");
+        printf("Use %s --help for more information.\n", argv[0]);
+        free(modelPaths);
+        return 1;
+    }
+
+    if (flags_cmd & TRAINER_FLAG_HELP) {
+        printf("Usage: %s [OPTIONS] <model files...>\n", argv[0]);
+        printf("Supervised pretraining of FNN models by behaviour cloning (models are overwritten with trained weights).\n");
+        printf("\n");
+        printf("Options:\n");
+        printf("  -h, --help\t\t\tPrint this help message and exit.\n");
+        printf("  -d, --data <file>\t\tDataset of recorded play (required).\n");
+        printf("  -e, --epochs <count>\t\tNumber of passes over training set (default %d).\n", TRAINER_DEFAULT_EPOCHS);
+        printf("  -b, --batch <size>\t\tNumber of observations per update (default %d).\n", TRAINER_DEFAULT_BATCH);
+        printf("  -r, --rate <value>\t\tLearning rate (default %g for sgd, %g for adam).\n", FNN_TRAIN_DEFAULT_RATE_SGD,
+               FNN_TRAIN_DEFAULT_RATE_ADAM);
+        printf("  -O, --optimizer <name>\tWeight update rule (sgd, adam; default adam).\n");
+        printf("  -L, --loss <name>\t\tLoss function (mse, bce; default bce).\n");
+        printf("  -t, --threads <count>\t\tNumber of threads used by matrix products (0 for one per CPU, default).\n");
+        printf("  -s, --seed <value>\t\tSeed of validation split and batch order (default 1).\n");
+        printf("  -v, --validation <fraction>\tFraction of dataset held out for validation (default %g).\n",
+               TRAINER_DEFAULT_VALIDATION);
+        printf("  -D, --deterministic\t\tSame trained weights on every CPU and thread count (no fused multiply-add).\n");
+        printf("\n");
+        printf("Dataset is text file with one observation per line: model inputs followed by target outputs (separated by\n");
+        printf("commas or whitespace). Empty lines and lines starting with '#' are ignored.\n");
+        printf("\n");
+        free(modelPaths);
+        return 0;
+    }
+
+    if (!(flags_cmd & TRAINER_FLAG_DATA) || modelCount == 0) {
+        printf("ERROR: Dataset and at least one model file are required.\n");
+        printf("Use %s --help for more information.\n", argv[0]);
+        free(modelPaths);
+        return 1;
+    }
+    if (((flags_cmd & TRAINER_FLAG_OPTIMIZER) && fnn_optimizerFromName(optimizerName, &optimizer) != 0) ||
+        ((flags_cmd & TRAINER_FLAG_LOSS) && fnn_lossFromName(lossName, &lossFunction) != 0)) {
+        printf("ERROR: Unknown optimizer or loss function.\n");
+        free(modelPaths);
+        return 1;
+    }
+
+    // dataset columns are given by input and output layer of first model
+    FnnModel *firstModel = fnn_deserialize(modelPaths[0]);
+    if (firstModel == NULL || firstModel->layerCount < 2) {
+        printf("ERROR: Failed to load model: %s\n", modelPaths[0]);
+        fnn_free(firstModel);
+        free(modelPaths);
+        return 1;
+    }
+    int status = loadDataset(dataPath, firstModel->neuronCounts[0], firstModel->neuronCounts[firstModel->layerCount - 1]);
+    fnn_free(firstModel);
+    if (status != 0) {
+        free(modelPaths);
+        return 1;
+    }
+
+    xThreadPool_init(threadCount);
+    xSimd_setDeterministic((flags_cmd & TRAINER_FLAG_DETERMINISTIC) != 0);
+    printf("Dataset: %u observations (%u training, %u validation), threads: %u\n", datasetInputs->rows, trainingRows,
+           datasetInputs->rows - trainingRows, xThreadPool_threadCount());
+
+    for (uint32_t m = 0; m < modelCount && status == 0; m++) {
+        status = trainModel(modelPaths[m], m);
+    }
+
+    xThreadPool_shutdown();
+    xMatrix_free(datasetInputs);
+    xMatrix_free(datasetTargets);
+    free(modelPaths);
+    return (status == 0) ? 0 : 1;
+}
+
+// ----------------------------------------------------------------------------------------------
+// local function definitions
+
+static int loadDataset(const char *filename, uint32_t inputs, uint32_t outputs)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        printf("ERROR: Failed to open dataset: %s\n", filename);
+        return 1;
+    }
+
+    // values of all observations are collected first (dataset size is not known in advance)
+    uint32_t columns = inputs + outputs;
+    uint64_t capacity = 1024 * (uint64_t)columns;
+    uint64_t count = 0;
+    float *values = (float *)malloc(capacity * sizeof(float));
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    uint32_t lineNumber = 0;
+    int status = (values == NULL) ? 1 : 0;
+    while (status == 0 && getline(&line, &lineCapacity, file) != -1) {
+        lineNumber++;
+        char *cursor = line;
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        if (*cursor == '#' || *cursor == '\n' || *cursor == '\r' || *cursor == '\0') {
+            continue;
+        }
+
+        if (count + columns > capacity) {
+            float *expanded = (float *)realloc(values, 2 * capacity * sizeof(float));
+            if (expanded == NULL) {
+                status = 1;
+                break;
+            }
+            values = expanded;
+            capacity *= 2;
+        }
+
+        uint32_t parsed = 0;
+        while (parsed <= columns && parsed < TRAINER_MAX_COLUMNS) {
+            while (*cursor == ' ' || *cursor == '\t' || *cursor == ',') {
+                cursor++;
+            }
+            if (*cursor == '\n' || *cursor == '\r' || *cursor == '\0') {
+                break;
+            }
+            char *end = NULL;
+            float value = strtof(cursor, &end);
+            if (end == cursor) {
+                parsed = TRAINER_MAX_COLUMNS;  // not a number
+                break;
+            }
+            if (parsed < columns) {
+                values[count + parsed] = value;
+            }
+            parsed++;
+            cursor = end;
+        }
+        if (parsed != columns) {
+            printf("ERROR: Dataset line %u does not contain %u numbers (%u inputs, %u outputs)\n", lineNumber, columns, inputs,
+                   outputs);
+            status = 1;
+            break;
+        }
+        count += columns;
+    }
+    free(line);
+    fclose(file);
+    if (status == 0 && count == 0) {
+        printf("ERROR: Dataset is empty\n");
+        status = 1;
+    }
+    if (status != 0) {
+        if (values == NULL) {
+            printf("ERROR: Failed to allocate memory for dataset\n");
+        }
+        free(values);
+        return 1;
+    }
+
+    // split values into shuffled input and target matrices (validation rows are taken from end)
+    uint32_t rows = (uint32_t)(count / columns);
+    datasetInputs = xMatrix_new(rows, inputs);
+    datasetTargets = xMatrix_new(rows, outputs);
+    uint32_t *order = (uint32_t *)malloc((size_t)rows * sizeof(uint32_t));
+    if (datasetInputs == NULL || datasetTargets == NULL || order == NULL) {
+        printf("ERROR: Failed to allocate memory for dataset\n");
+        free(values);
+        free(order);
+        return 1;
+    }
+    uint32_t state = shuffleSeed;
+    shuffleRows(order, rows, &state);
+    for (uint32_t r = 0; r < rows; r++) {
+        const float *source = values + (uint64_t)order[r] * columns;
+        memcpy(datasetInputs->data + (uint64_t)r * inputs, source, inputs * sizeof(float));
+        memcpy(datasetTargets->data + (uint64_t)r * outputs, source + inputs, outputs * sizeof(float));
+    }
+    trainingRows = rows - (uint32_t)((float)rows * validationFraction);
+    if (trainingRows == 0) {
+        trainingRows = rows;
+    }
+
+    free(values);
+    free(order);
+    return 0;
+}
+
+static void shuffleRows(uint32_t *order, uint32_t count, uint32_t *state)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    for (uint32_t i = count; i > 1; i--) {
+        uint32_t j = nextRandom(state) % i;
+        uint32_t swap = order[i - 1];
+        order[i - 1] = order[j];
+        order[j] = swap;
+    }
+}
+
+static uint32_t nextRandom(uint32_t *state)
+{
+    uint32_t x = (*state != 0) ? *state : 0x9E3779B9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static int trainModel(const char *filename, uint32_t modelIndex)
+{
+    FnnModel *model = fnn_deserialize(filename);
+    if (model == NULL || model->layerCount < 2 || model->neuronCounts[0] != datasetInputs->cols ||
+        model->neuronCounts[model->layerCount - 1] != datasetTargets->cols) {
+        printf("ERROR: Model does not match dataset: %s\n", filename);
+        fnn_free(model);
+        return 1;
+    }
+    FnnTrainer *trainer = fnn_trainerNew(model, batchSize, optimizer, lossFunction, learningRate);
+    xMatrix *batchInputs = xMatrix_new(batchSize, datasetInputs->cols);
+    xMatrix *batchTargets = xMatrix_new(batchSize, datasetTargets->cols);
+    uint32_t *order = (uint32_t *)malloc((size_t)trainingRows * sizeof(uint32_t));
+    if (trainer == NULL || batchInputs == NULL || batchTargets == NULL || order == NULL) {
+        printf("ERROR: Failed to create trainer for model: %s\n", filename);
+        fnn_trainerFree(trainer);
+        xMatrix_free(batchInputs);
+        xMatrix_free(batchTargets);
+        free(order);
+        fnn_free(model);
+        return 1;
+    }
+
+    // every model gets its own batch order
+    uint32_t state = shuffleSeed ^ (0x9E3779B9u * (modelIndex + 1));
+    uint32_t validationRows = datasetInputs->rows - trainingRows;
+    float validationLoss = 0.0f;
+    if (validationRows > 0 && evaluate(trainer, trainingRows, validationRows, &validationLoss) == 0) {
+        printf("%s: initial validation loss %.5f\n", filename, validationLoss);
+    }
+
+    int status = 0;
+    for (uint32_t epoch = 1; epoch <= epochCount && status == 0; epoch++) {
+        shuffleRows(order, trainingRows, &state);
+        double epochLoss = 0.0;
+        for (uint32_t start = 0; start < trainingRows && status == 0; start += batchSize) {
+            uint32_t rows = (trainingRows - start < batchSize) ? trainingRows - start : batchSize;
+            for (uint32_t r = 0; r < rows; r++) {
+                uint64_t source = order[start + r];
+                memcpy(batchInputs->data + (uint64_t)r * batchInputs->cols,
+                       datasetInputs->data + source * datasetInputs->cols, datasetInputs->cols * sizeof(float));
+                memcpy(batchTargets->data + (uint64_t)r * batchTargets->cols,
+                       datasetTargets->data + source * datasetTargets->cols, datasetTargets->cols * sizeof(float));
+            }
+            xMatrixView inputs = xMatrix_viewSlice(batchInputs, 0, rows, 0, batchInputs->cols);
+            xMatrixView targets = xMatrix_viewSlice(batchTargets, 0, rows, 0, batchTargets->cols);
+            float batchLoss = 0.0f;
+            status = (fnn_trainBatch(trainer, &inputs, &targets, &batchLoss) == 0) ? 0 : 1;
+            epochLoss += (double)batchLoss * rows;
+        }
+
+        if (status == 0 && (epoch % TRAINER_REPORT_EPOCHS == 0 || epoch == epochCount)) {
+            printf("%s: epoch %u/%u, training loss %.5f", filename, epoch, epochCount, epochLoss / trainingRows);
+            if (validationRows > 0 && evaluate(trainer, trainingRows, validationRows, &validationLoss) == 0) {
+                printf(", validation loss %.5f", validationLoss);
+            }
+            printf("\n");
+        }
+    }
+
+    // trained values replace values of loaded model, which is then written back to its file
+    if (status == 0 && (fnn_trainerExport(trainer, model) != 0 || storeModel(filename, model) != 0)) {
+        printf("ERROR: Failed to store trained model: %s\n", filename);
+        status = 1;
+    }
+
+    fnn_trainerFree(trainer);
+    xMatrix_free(batchInputs);
+    xMatrix_free(batchTargets);
+    free(order);
+    fnn_free(model);
+    return status;
+}
+
+static int storeModel(const char *filename, FnnModel *model)
+{
+    // model is written under temporary name in same directory and renamed over original, so that processes mapping the
+    // original file keep its old contents and interrupted write never leaves truncated model
+    char *tempPath = (char *)malloc((cu_CStringLength(filename) + 5) * sizeof(char));
+    if (tempPath == NULL) {
+        return 1;
+    }
+    sprintf(tempPath, "%s.tmp", filename);
+    int status = (fnn_serialize(tempPath, model) == 0 && rename(tempPath, filename) == 0) ? 0 : 1;
+    if (status != 0) {
+        remove(tempPath);
+    }
+    free(tempPath);
+    return status;
+}
+
+static int evaluate(FnnTrainer *trainer, uint32_t start, uint32_t count, float *loss)
+{
+    // backward pass is used only for its loss (gradients are discarded since no update follows)
+    double total = 0.0;
+    for (uint32_t offset = 0; offset < count; offset += trainer->batchCapacity) {
+        uint32_t rows = (count - offset < trainer->batchCapacity) ? count - offset : trainer->batchCapacity;
+        xMatrixView inputs = xMatrix_viewSlice(datasetInputs, start + offset, start + offset + rows, 0, datasetInputs->cols);
+        xMatrixView targets = xMatrix_viewSlice(datasetTargets, start + offset, start + offset + rows, 0, datasetTargets->cols);
+        float batchLoss = 0.0f;
+        if (fnn_trainForward(trainer, &inputs) == NULL || fnn_trainBackward(trainer, &inputs, &targets, &batchLoss) != 0) {
+            return 1;
+        }
+        total += (double)batchLoss * rows;
+    }
+
+    *loss = (float)(total / count);
+    return 0;
+}